@@ -0,0 +1,124 @@
+// Shared helpers for the headless benchmarks
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "KibakoEngine/Renderer/SpriteTypes.h"
+
+namespace Bench {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Result
+    {
+        std::string name;        // "Suite/Benchmark"
+        double      meanMs = 0.0;
+        int         iterations = 0;
+    };
+
+    // Everything measured in this process, in run order
+    inline std::vector<Result> g_results;
+    inline std::string         g_suite;
+
+    // Prefixes the names of the results recorded after it
+    inline void BeginSuite(const char* name)
+    {
+        g_suite = name;
+    }
+
+    // For values measured outside Run, e.g. best-of-N per-operation costs
+    inline void Record(const char* name, double meanMs, int iterations = 1)
+    {
+        g_results.push_back({ g_suite + "/" + name, meanMs, iterations });
+    }
+
+    // Runs fn() `iterations` times and prints the mean time per run
+    template <typename Fn>
+    double Run(const char* name, int iterations, Fn&& fn)
+    {
+        if (iterations <= 0)
+            iterations = 1;
+
+        fn(); // Warm-up
+
+        const auto start = Clock::now();
+        for (int i = 0; i < iterations; ++i)
+            fn();
+        const auto end = Clock::now();
+
+        const double totalMs = std::chrono::duration<double, std::milli>(end - start).count();
+        const double meanMs = totalMs / static_cast<double>(iterations);
+        std::printf("  %-28s %10.3f ms  (x%d)\n", name, meanMs, iterations);
+        Record(name, meanMs, iterations);
+        return meanMs;
+    }
+
+    // Every suite draws its random data from this seed, so runs are comparable
+    inline constexpr std::uint32_t kSeed = 1337;
+
+    struct SpriteSource
+    {
+        KibakoEngine::RectF  dst;
+        KibakoEngine::Color4 color = KibakoEngine::Color4::White();
+        float                rotation = 0.0f;
+        int                  layer = 0;
+        int                  texture = 0;
+    };
+
+    // Positions and sizes are uniform in [min, max); layers in [firstLayer, firstLayer + layerCount)
+    struct SpriteParams
+    {
+        std::size_t count = 0;
+        float       minX = 0.0f;
+        float       maxX = 4096.0f;
+        float       minY = 0.0f;
+        float       maxY = 4096.0f;
+        float       minSize = 32.0f;
+        float       maxSize = 32.0f;
+        float       rotatedShare = 0.0f;   // Share of sprites given a random angle
+        bool        randomColors = false;  // Random tint, alpha 0.25 to 1
+        int         firstLayer = 0;
+        int         layerCount = 1;
+        int         textureCount = 1;
+    };
+
+    // Square sprites from kSeed; the same params always give the same sprites
+    inline std::vector<SpriteSource> MakeSprites(const SpriteParams& params)
+    {
+        std::mt19937 rng(kSeed);
+        std::uniform_real_distribution<float> x(params.minX, params.maxX);
+        std::uniform_real_distribution<float> y(params.minY, params.maxY);
+        std::uniform_real_distribution<float> size(params.minSize, params.maxSize);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+        std::uniform_int_distribution<int> layer(params.firstLayer, params.firstLayer + params.layerCount - 1);
+        std::uniform_int_distribution<int> texture(0, params.textureCount - 1);
+
+        std::vector<SpriteSource> sprites(params.count);
+        for (SpriteSource& sprite : sprites) {
+            const float s = size(rng);
+            sprite.dst = KibakoEngine::RectF::FromXYWH(x(rng), y(rng), s, s);
+            if (params.randomColors)
+                sprite.color = KibakoEngine::Color4{ unit(rng), unit(rng), unit(rng), 0.25f + 0.75f * unit(rng) };
+            if (params.rotatedShare > 0.0f && unit(rng) < params.rotatedShare)
+                sprite.rotation = angle(rng);
+            sprite.layer = layer(rng);
+            sprite.texture = texture(rng);
+        }
+        return sprites;
+    }
+
+    // Keeps the optimizer from discarding a computed value
+    inline volatile std::uint64_t g_sink = 0;
+
+    inline void Consume(std::uint64_t value)
+    {
+        g_sink = g_sink + value;
+    }
+
+} // namespace Bench
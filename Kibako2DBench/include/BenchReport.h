@@ -0,0 +1,27 @@
+// JSON results and baseline comparison for the benchmark runner
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "BenchCommon.h"
+
+namespace Bench {
+
+    // Differences below this are timer noise whatever the ratio
+    inline constexpr double kMinRegressionMs = 0.001;
+
+    // {"version":1,"results":[...]} with one result object per line; fails on repeated names
+    bool WriteJson(const std::string& path, const std::vector<Result>& results);
+
+    // Reads files written by WriteJson
+    bool LoadJson(const std::string& path, std::vector<Result>& outResults);
+
+    // Prints a comparison table and returns how many results got slower than
+    // the baseline by more than thresholdPercent. Repeated names on either side
+    // make the match ambiguous and are returned as failures instead.
+    int CompareToBaseline(const std::vector<Result>& current,
+                          const std::vector<Result>& baseline,
+                          double thresholdPercent);
+
+} // namespace Bench
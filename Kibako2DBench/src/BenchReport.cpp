@@ -0,0 +1,159 @@
+// JSON results and baseline comparison for the benchmark runner
+#include "BenchReport.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace Bench {
+
+    namespace {
+
+        // Finds "key": in line and returns the first character of its value
+        const char* FindValue(const char* line, const char* key)
+        {
+            char pattern[64];
+            std::snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+            const char* found = std::strstr(line, pattern);
+            if (!found)
+                return nullptr;
+
+            found += std::strlen(pattern);
+            while (*found == ' ')
+                ++found;
+            return found;
+        }
+
+        const Result* FindResult(const std::vector<Result>& results, const std::string& name)
+        {
+            for (const Result& result : results) {
+                if (result.name == name)
+                    return &result;
+            }
+            return nullptr;
+        }
+
+        // Names key the baseline comparison, so each must appear once; prints every repeat
+        int CountDuplicateNames(const std::vector<Result>& results, const char* source)
+        {
+            int duplicates = 0;
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                if (FindResult(results, results[i].name) != &results[i]) {
+                    std::printf("  Duplicate result name %s in %s\n", results[i].name.c_str(), source);
+                    ++duplicates;
+                }
+            }
+            return duplicates;
+        }
+
+    } // namespace
+
+    bool WriteJson(const std::string& path, const std::vector<Result>& results)
+    {
+        if (CountDuplicateNames(results, "this run") != 0) {
+            std::printf("Not writing %s: a baseline with repeated names cannot be compared\n", path.c_str());
+            return false;
+        }
+
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            std::printf("Failed to open %s for writing\n", path.c_str());
+            return false;
+        }
+
+        std::fprintf(file, "{\n  \"version\": 1,\n  \"results\": [\n");
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Result& result = results[i];
+            std::fprintf(file, "    {\"name\": \"%s\", \"ms\": %.9g, \"iterations\": %d}%s\n",
+                result.name.c_str(), result.meanMs, result.iterations, i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+
+        const bool ok = std::ferror(file) == 0;
+        std::fclose(file);
+        if (!ok) {
+            std::printf("Failed to write %s\n", path.c_str());
+            return false;
+        }
+
+        std::printf("Wrote %zu results to %s\n", results.size(), path.c_str());
+        return true;
+    }
+
+    bool LoadJson(const std::string& path, std::vector<Result>& outResults)
+    {
+        outResults.clear();
+
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            std::printf("Failed to open baseline %s\n", path.c_str());
+            return false;
+        }
+
+        char line[512];
+        while (std::fgets(line, sizeof(line), file)) {
+            const char* name = FindValue(line, "name");
+            const char* ms = FindValue(line, "ms");
+            if (!name || !ms || *name != '"')
+                continue;
+
+            const char* nameEnd = std::strchr(name + 1, '"');
+            if (!nameEnd)
+                continue;
+
+            Result result;
+            result.name.assign(name + 1, nameEnd);
+            result.meanMs = std::strtod(ms, nullptr);
+            if (const char* iterations = FindValue(line, "iterations"))
+                result.iterations = std::atoi(iterations);
+            outResults.push_back(std::move(result));
+        }
+        std::fclose(file);
+
+        if (outResults.empty()) {
+            std::printf("Baseline %s has no results\n", path.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    int CompareToBaseline(const std::vector<Result>& current,
+                          const std::vector<Result>& baseline,
+                          double thresholdPercent)
+    {
+        std::printf("\n[Baseline] regression threshold %.1f%%\n", thresholdPercent);
+
+        const int duplicates = CountDuplicateNames(current, "this run") + CountDuplicateNames(baseline, "the baseline");
+        if (duplicates != 0) {
+            std::printf("  %d duplicate name(s); results cannot be matched to the baseline\n", duplicates);
+            return duplicates;
+        }
+
+        int regressions = 0;
+        for (const Result& result : current) {
+            const Result* reference = FindResult(baseline, result.name);
+            if (!reference) {
+                std::printf("  %-44s %12.6f ms  (new)\n", result.name.c_str(), result.meanMs);
+                continue;
+            }
+
+            const double deltaMs = result.meanMs - reference->meanMs;
+            const double deltaPercent = reference->meanMs > 0.0 ? 100.0 * deltaMs / reference->meanMs : 0.0;
+            const bool regressed = deltaPercent > thresholdPercent && deltaMs > kMinRegressionMs;
+            if (regressed)
+                ++regressions;
+
+            std::printf("  %-44s %12.6f ms  vs %12.6f  %+7.1f%%%s\n", result.name.c_str(), result.meanMs,
+                reference->meanMs, deltaPercent, regressed ? "  REGRESSION" : "");
+        }
+
+        for (const Result& reference : baseline) {
+            if (!FindResult(current, reference.name))
+                std::printf("  %-44s missing from this run\n", reference.name.c_str());
+        }
+
+        std::printf("  %d regression(s)\n", regressions);
+        return regressions;
+    }
+
+} // namespace Bench
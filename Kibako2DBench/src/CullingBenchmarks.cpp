@@ -0,0 +1,126 @@
+// Sprite culling benchmarks (1M entities)
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "BenchCommon.h"
+
+#include "KibakoEngine/Renderer/Camera2D.h"
+#include "KibakoEngine/Renderer/SpriteCulling.h"
+
+using namespace KibakoEngine;
+
+namespace {
+
+    constexpr std::size_t kEntityCount = 1'000'000;
+    constexpr float kWorldSize = 200'000.0f;
+    constexpr float kGridCellSize = 512.0f;
+    constexpr int kIterations = 20;
+
+    struct ViewCase
+    {
+        const char* name;
+        float width;
+        float height;
+    };
+
+    void BuildRandomBounds(SpriteBounds2D& bounds)
+    {
+        std::mt19937 rng(Bench::kSeed);
+        std::uniform_real_distribution<float> position(0.0f, kWorldSize);
+        std::uniform_real_distribution<float> size(16.0f, 64.0f);
+        std::uniform_real_distribution<float> rotation(-3.14159265f, 3.14159265f);
+
+        bounds.Clear();
+        bounds.Reserve(kEntityCount);
+        for (std::size_t i = 0; i < kEntityCount; ++i) {
+            const float w = size(rng);
+            const float h = size(rng);
+            bounds.Add(RectF::FromXYWH(position(rng), position(rng), w, h), rotation(rng));
+        }
+    }
+
+    void CullScalar(const CullView2D& view, const SpriteBounds2D& bounds, std::vector<std::uint32_t>& out)
+    {
+        const float* cx = bounds.CenterX();
+        const float* cy = bounds.CenterY();
+        const float* hw = bounds.HalfW();
+        const float* hh = bounds.HalfH();
+
+        const std::size_t count = bounds.Size();
+        for (std::size_t i = 0; i < count; ++i) {
+            if (SpriteCulling::IsVisible(view, cx[i], cy[i], hw[i], hh[i]))
+                out.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+} // namespace
+
+int RunCullingBenchmarks()
+{
+    std::printf("\n[Culling] %zu entities, seed %u\n", kEntityCount, Bench::kSeed);
+
+    SpriteBounds2D bounds;
+    Bench::Run("BuildBounds", 1, [&]() { BuildRandomBounds(bounds); });
+
+    SpriteCullGrid2D grid;
+    Bench::Run("GridBuild", 5, [&]() { grid.Build(bounds, kGridCellSize); });
+    std::printf("  grid %d x %d cells\n", grid.CellsX(), grid.CellsY());
+
+    const ViewCase cases[] = {
+        { "1080p", 1920.0f, 1080.0f },
+        { "ZoomedOut", 19200.0f, 10800.0f },
+    };
+
+    int failures = 0;
+
+    std::vector<std::uint32_t> scalarOut;
+    std::vector<std::uint32_t> simdOut;
+    std::vector<std::uint32_t> gridOut;
+    scalarOut.reserve(kEntityCount);
+    simdOut.reserve(kEntityCount);
+    gridOut.reserve(kEntityCount);
+
+    for (const ViewCase& viewCase : cases) {
+        Camera2D camera;
+        camera.SetViewport(viewCase.width, viewCase.height);
+        camera.SetPosition(kWorldSize * 0.5f, kWorldSize * 0.5f);
+        camera.SetRotation(0.3f);
+
+        const CullView2D view = CullView2D::FromCamera(camera);
+
+        std::printf(" view %s (%.0f x %.0f, rotated)\n", viewCase.name, viewCase.width, viewCase.height);
+
+        // Each view case is its own result, e.g. "Culling/Scalar/1080p"
+        char name[64];
+        std::snprintf(name, sizeof(name), "Scalar/%s", viewCase.name);
+        Bench::Run(name, kIterations, [&]() {
+            scalarOut.clear();
+            CullScalar(view, bounds, scalarOut);
+            Bench::Consume(scalarOut.size());
+        });
+
+        std::snprintf(name, sizeof(name), "SIMD/%s", viewCase.name);
+        Bench::Run(name, kIterations, [&]() {
+            simdOut.clear();
+            Bench::Consume(SpriteCulling::CullVisible(view, bounds, simdOut));
+        });
+
+        std::snprintf(name, sizeof(name), "GridQuery/%s", viewCase.name);
+        Bench::Run(name, kIterations, [&]() {
+            gridOut.clear();
+            Bench::Consume(grid.Query(view, bounds, gridOut));
+        });
+
+        std::printf("  visible: scalar=%zu simd=%zu grid=%zu\n",
+                    scalarOut.size(), simdOut.size(), gridOut.size());
+
+        if (simdOut != scalarOut || gridOut != scalarOut) {
+            std::printf("  MISMATCH between culling paths\n");
+            ++failures;
+        }
+    }
+
+    return failures;
+}
@@ -0,0 +1,291 @@
+// Logging throughput: filtered calls and fully formatted lines
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <system_error>
+
+#include "BenchCommon.h"
+
+#include "KibakoEngine/Core/BinaryLog.h"
+#include "KibakoEngine/Core/CrashLog.h"
+#include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/LogFormat.h"
+#include "KibakoEngine/Core/LogFileSink.h"
+
+#if defined(_WIN32)
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+
+using namespace KibakoEngine;
+
+namespace {
+
+    constexpr int kMessagesPerRun = 10'000;
+    constexpr int kIterations = 10;
+    constexpr const char* kChannel = "Bench";
+    constexpr const char* kBinaryLogPath = "kibako_bench.kbkl";
+    constexpr const char* kFileSinkDirectory = "kibako_bench_logs";
+    constexpr const char* kCrashLogPath = "kibako_bench_crash.log";
+
+    // Points stdout at the null device so emitted lines cost what a real sink costs
+    // without flooding the report
+    class StdoutSilencer
+    {
+    public:
+        StdoutSilencer()
+        {
+            std::fflush(stdout);
+#if defined(_WIN32)
+            m_saved = _dup(_fileno(stdout));
+            m_null = std::fopen("NUL", "wb");
+            if (m_saved >= 0 && m_null)
+                _dup2(_fileno(m_null), _fileno(stdout));
+#else
+            m_saved = dup(fileno(stdout));
+            m_null = std::fopen("/dev/null", "wb");
+            if (m_saved >= 0 && m_null)
+                dup2(fileno(m_null), fileno(stdout));
+#endif
+        }
+
+        ~StdoutSilencer()
+        {
+            std::fflush(stdout);
+#if defined(_WIN32)
+            if (m_saved >= 0) {
+                _dup2(m_saved, _fileno(stdout));
+                _close(m_saved);
+            }
+#else
+            if (m_saved >= 0) {
+                dup2(m_saved, fileno(stdout));
+                close(m_saved);
+            }
+#endif
+            if (m_null)
+                std::fclose(m_null);
+        }
+
+        StdoutSilencer(const StdoutSilencer&) = delete;
+        StdoutSilencer& operator=(const StdoutSilencer&) = delete;
+
+    private:
+        int        m_saved = -1;
+        std::FILE* m_null = nullptr;
+    };
+
+    // The prefix as it was built before the timestamp cache: localtime and snprintf per line
+    std::size_t FormatPrefixUncached(char* buffer, std::size_t size, std::int64_t timeMs)
+    {
+        const std::time_t seconds = static_cast<std::time_t>(timeMs / 1000);
+        std::tm local{};
+#if defined(_WIN32)
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+        const int written = std::snprintf(buffer, size, "[%02d:%02d:%02d.%03lld][%s][%s][%s:%d][%s] ", local.tm_hour,
+            local.tm_min, local.tm_sec, static_cast<long long>(timeMs % 1000), "INFO", kChannel, "LogBenchmarks.cpp",
+            __LINE__, "RunLogBenchmarks");
+        return written < 0 ? 0 : static_cast<std::size_t>(written);
+    }
+
+} // namespace
+
+int RunLogBenchmarks()
+{
+    std::printf("\n[Log] %d messages per run\n", kMessagesPerRun);
+
+    const LogConfig previousConfig = GetLogConfig();
+    double limitedMs = 0.0;
+
+    LogConfig filtered = previousConfig;
+    filtered.minimumLevel = LogLevel::Warning;
+    SetLogConfig(filtered);
+    Bench::Run("FilteredTrace", kIterations, []() {
+        for (int i = 0; i < kMessagesPerRun; ++i)
+            KbkTrace(kChannel, "Filtered message %d of %d", i, kMessagesPerRun);
+    });
+
+    // Another channel stays at Trace, so every call takes the channel table lookup
+    SetLogChannelLevel("Scene2D", LogLevel::Trace);
+    Bench::Run("FilteredTraceChannel", kIterations, []() {
+        for (int i = 0; i < kMessagesPerRun; ++i)
+            KbkTrace(kChannel, "Filtered message %d of %d", i, kMessagesPerRun);
+    });
+    ClearLogChannelLevel("Scene2D");
+
+    // Filtered from the console but formatted into the crash ring
+    CrashLogConfig crashConfig;
+    crashConfig.path = kCrashLogPath;
+    crashConfig.dumpOnBreakpoint = false;
+    crashConfig.installHandlers = false;
+    if (CrashLog::Enable(crashConfig)) {
+        const double capturedMs = Bench::Run("CapturedTrace", kIterations, []() {
+            for (int i = 0; i < kMessagesPerRun; ++i)
+                KbkTrace(kChannel, "Filtered message %d of %d", i, kMessagesPerRun);
+        });
+        std::printf("    %.1f ns/call\n", capturedMs * 1e6 / kMessagesPerRun);
+        CrashLog::Disable();
+    }
+
+    // The message text alone, into a stack buffer: what each emitted line pays to format
+    {
+        static char s_text[256];
+        static std::size_t s_total = 0;
+        const double printfMs = Bench::Run("FormatPrintf", kIterations, []() {
+            for (int i = 0; i < kMessagesPerRun; ++i) {
+                const int written = std::snprintf(s_text, sizeof(s_text), "Emitted message %d of %d, value %.3f", i,
+                    kMessagesPerRun, static_cast<double>(i) * 0.5);
+                s_total += static_cast<std::size_t>(written);
+            }
+        });
+        std::printf("    %.1f ns/message\n", printfMs * 1e6 / kMessagesPerRun);
+
+        const double bracesMs = Bench::Run("FormatBraces", kIterations, []() {
+            for (int i = 0; i < kMessagesPerRun; ++i)
+                s_total += FormatLog(s_text, sizeof(s_text), "Emitted message {} of {}, value {:.3}", i, kMessagesPerRun,
+                    static_cast<double>(i) * 0.5);
+        });
+        std::printf("    %.1f ns/message (%zu bytes)\n", bracesMs * 1e6 / kMessagesPerRun, s_total);
+    }
+
+    // Line prefixes one millisecond apart, as in a burst: the cache calls localtime
+    // once per thousand lines
+    {
+        static char s_prefix[256];
+        static std::size_t s_total = 0;
+        const std::int64_t startMs = 1'700'000'000'000;
+        const double uncachedMs = Bench::Run("FormatPrefixUncached", kIterations, [startMs]() {
+            for (int i = 0; i < kMessagesPerRun; ++i)
+                s_total += FormatPrefixUncached(s_prefix, sizeof(s_prefix), startMs + i);
+        });
+        std::printf("    %.1f ns/line\n", uncachedMs * 1e6 / kMessagesPerRun);
+
+        const double cachedMs = Bench::Run("FormatPrefix", kIterations, [startMs]() {
+            for (int i = 0; i < kMessagesPerRun; ++i)
+                s_total += Detail::FormatLogPrefix(s_prefix, sizeof(s_prefix), LogLevel::Info, startMs + i, kChannel,
+                    __FILE__, __LINE__, "RunLogBenchmarks");
+        });
+        std::printf("    %.1f ns/line (%zu bytes)\n", cachedMs * 1e6 / kMessagesPerRun, s_total);
+    }
+
+    // A per-frame warning behind a rate limit: nearly every call is turned away
+    {
+        StdoutSilencer silencer;
+        limitedMs = Bench::Run("RateLimitedWarn", kIterations, []() {
+            for (int i = 0; i < kMessagesPerRun; ++i)
+                KbkWarnLimited(kChannel, 1, "Limited message %d of %d", i, kMessagesPerRun);
+        });
+    }
+
+    LogConfig emitted = previousConfig;
+    emitted.minimumLevel = LogLevel::Trace;
+    SetLogConfig(emitted);
+
+    double emittedMs = 0.0;
+    {
+        StdoutSilencer silencer;
+        emittedMs = Bench::Run("EmittedInfo", kIterations, []() {
+            for (int i = 0; i < kMessagesPerRun; ++i)
+                KbkLog(kChannel, "Emitted message %d of %d, value %.3f", i, kMessagesPerRun, static_cast<double>(i) * 0.5);
+        });
+    }
+
+    // Same line through the {} formatter
+    double emittedFmtMs = 0.0;
+    {
+        StdoutSilencer silencer;
+        emittedFmtMs = Bench::Run("EmittedInfoFmt", kIterations, []() {
+            for (int i = 0; i < kMessagesPerRun; ++i)
+                KbkLogFmt(kChannel, "Emitted message {} of {}, value {:.3}", i, kMessagesPerRun, static_cast<double>(i) * 0.5);
+        });
+    }
+
+    // Same values as typed fields instead of a format string
+    double fieldsMs = 0.0;
+    {
+        StdoutSilencer silencer;
+        fieldsMs = Bench::Run("EmittedFields", kIterations, []() {
+            for (int i = 0; i < kMessagesPerRun; ++i)
+                KbkLogFields(kChannel, "Emitted message", { "index", i }, { "count", kMessagesPerRun },
+                    { "value", static_cast<double>(i) * 0.5 });
+        });
+    }
+
+    // Console plus a buffered file: the extra cost per line of the file sink
+    double fileMs = 0.0;
+    {
+        RotatingFileSink fileSink;
+        LogFileConfig fileConfig;
+        fileConfig.directory = kFileSinkDirectory;
+        fileConfig.baseName = "bench";
+        fileConfig.maxTotalBytes = 64ull << 20;
+        if (fileSink.Open(fileConfig)) {
+            AddLogSink(&fileSink);
+            StdoutSilencer silencer;
+            fileMs = Bench::Run("EmittedInfoFile", kIterations, []() {
+                for (int i = 0; i < kMessagesPerRun; ++i)
+                    KbkLog(kChannel, "Emitted message %d of %d, value %.3f", i, kMessagesPerRun, static_cast<double>(i) * 0.5);
+            });
+        }
+        fileSink.Close();
+
+        std::error_code error;
+        std::filesystem::remove_all(kFileSinkDirectory, error);
+    }
+
+    // Includes the final flush, so this is throughput rather than caller latency
+    double asyncMs = 0.0;
+    if (StartAsyncLogging()) {
+        StdoutSilencer silencer;
+        asyncMs = Bench::Run("EmittedInfoAsync", kIterations, []() {
+            for (int i = 0; i < kMessagesPerRun; ++i)
+                KbkLog(kChannel, "Emitted message %d of %d, value %.3f", i, kMessagesPerRun, static_cast<double>(i) * 0.5);
+            FlushLog();
+        });
+        StopAsyncLogging();
+    }
+
+    // Same message as EmittedInfo, with arguments stored raw
+    double deferredMs = 0.0;
+    long binaryBytes = 0;
+    if (BinaryLog::Open(kBinaryLogPath)) {
+        StdoutSilencer silencer;
+        deferredMs = Bench::Run("DeferredTrace", kIterations, []() {
+            for (int i = 0; i < kMessagesPerRun; ++i)
+                KbkTraceDeferred(kChannel, "Emitted message %d of %d, value %.3f", i, kMessagesPerRun, static_cast<double>(i) * 0.5);
+        });
+        BinaryLog::Close();
+
+        if (std::FILE* file = std::fopen(kBinaryLogPath, "rb")) {
+            std::fseek(file, 0, SEEK_END);
+            binaryBytes = std::ftell(file);
+            std::fclose(file);
+        }
+        std::remove(kBinaryLogPath);
+    }
+
+    SetLogConfig(previousConfig);
+
+    // Run printed into the silenced stream
+    std::printf("  %-28s %10.3f ms  (x%d)\n", "RateLimitedWarn", limitedMs, kIterations);
+    std::printf("    %.1f ns/call\n", limitedMs * 1e6 / kMessagesPerRun);
+    std::printf("  %-28s %10.3f ms  (x%d)\n", "EmittedInfo", emittedMs, kIterations);
+    std::printf("    %.0f lines/s\n", emittedMs > 0.0 ? kMessagesPerRun * 1000.0 / emittedMs : 0.0);
+    std::printf("  %-28s %10.3f ms  (x%d)\n", "EmittedInfoFmt", emittedFmtMs, kIterations);
+    std::printf("    %.0f lines/s\n", emittedFmtMs > 0.0 ? kMessagesPerRun * 1000.0 / emittedFmtMs : 0.0);
+    std::printf("  %-28s %10.3f ms  (x%d)\n", "EmittedFields", fieldsMs, kIterations);
+    std::printf("    %.0f lines/s\n", fieldsMs > 0.0 ? kMessagesPerRun * 1000.0 / fieldsMs : 0.0);
+    std::printf("  %-28s %10.3f ms  (x%d)\n", "EmittedInfoFile", fileMs, kIterations);
+    std::printf("    %.0f lines/s\n", fileMs > 0.0 ? kMessagesPerRun * 1000.0 / fileMs : 0.0);
+    std::printf("  %-28s %10.3f ms  (x%d)\n", "EmittedInfoAsync", asyncMs, kIterations);
+    std::printf("    %.0f lines/s\n", asyncMs > 0.0 ? kMessagesPerRun * 1000.0 / asyncMs : 0.0);
+    std::printf("  %-28s %10.3f ms  (x%d)\n", "DeferredTrace", deferredMs, kIterations);
+    std::printf("    %.1f ns/call, %.1f bytes/message\n", deferredMs * 1e6 / kMessagesPerRun,
+        static_cast<double>(binaryBytes) / (static_cast<double>(kMessagesPerRun) * (kIterations + 1)));
+    return 0;
+}
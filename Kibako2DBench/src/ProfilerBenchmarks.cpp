@@ -0,0 +1,127 @@
+// Cost of the profiler itself: per-scope overhead on the recording thread and drain cost
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "BenchCommon.h"
+
+#include "KibakoEngine/Core/Profiler.h"
+
+using namespace KibakoEngine;
+
+namespace {
+
+    // Half a ring, so a batch never drops events
+    constexpr int kScopesPerBatch = 4096;
+    constexpr int kBatches = 2000;
+    // Per scope, both clock reads included
+    constexpr double kBudgetNs = 20.0;
+
+    double ElapsedNs(Bench::Clock::time_point start, Bench::Clock::time_point end)
+    {
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    // Best batch wins: the minimum filters out preemption on a busy machine
+    template <typename Fn>
+    double BestNsPerOp(int opsPerBatch, Fn&& batch)
+    {
+        double best = 1.0e30;
+        for (int i = 0; i < kBatches; ++i) {
+            const auto start = Bench::Clock::now();
+            batch();
+            const auto end = Bench::Clock::now();
+            best = std::min(best, ElapsedNs(start, end) / static_cast<double>(opsPerBatch));
+
+            // Drain outside the timed region
+            Profiler::BeginFrame();
+        }
+        return best;
+    }
+
+    void Report(const char* name, double ns)
+    {
+        std::printf("  %-28s %10.2f ns\n", name, ns);
+        Bench::Record(name, ns / 1.0e6, kBatches);
+    }
+
+} // namespace
+
+int RunProfilerBenchmarks()
+{
+#if !KBK_ENABLE_PROFILING
+    std::printf("\n[Profiler] skipped: KBK_ENABLE_PROFILING is 0\n");
+    return 0;
+#else
+    std::printf("\n[Profiler] %d scopes per batch, best of %d batches, TSC %s\n",
+        kScopesPerBatch, kBatches, KBK_PROFILER_USE_TSC ? "on" : "off");
+
+    Profiler::SetThreadName("Bench");
+    Profiler::BeginFrame();
+
+    const double loopNs = BestNsPerOp(kScopesPerBatch, []() {
+        for (int i = 0; i < kScopesPerBatch; ++i)
+            Bench::Consume(static_cast<std::uint64_t>(i));
+    });
+
+    const double timestampNs = BestNsPerOp(kScopesPerBatch, []() {
+        for (int i = 0; i < kScopesPerBatch; ++i)
+            Bench::Consume(static_cast<std::uint64_t>(Profiler::Detail::NowTicks()));
+    });
+
+    const double scopeNs = BestNsPerOp(kScopesPerBatch, []() {
+        for (int i = 0; i < kScopesPerBatch; ++i) {
+            KBK_PROFILE_SCOPE("BenchScope");
+            Bench::Consume(static_cast<std::uint64_t>(i));
+        }
+    });
+
+    const double nestedNs = BestNsPerOp(kScopesPerBatch, []() {
+        KBK_PROFILE_SCOPE("BenchOuter");
+        for (int i = 0; i < kScopesPerBatch - 1; ++i) {
+            KBK_PROFILE_SCOPE("BenchInner");
+            Bench::Consume(static_cast<std::uint64_t>(i));
+        }
+    });
+
+    // Consumer side: draining and aggregating one batch of events into the call tree
+    double drainNs = 1.0e30;
+    for (int i = 0; i < kBatches / 10; ++i) {
+        for (int j = 0; j < kScopesPerBatch; ++j) {
+            KBK_PROFILE_SCOPE("BenchDrain");
+            Bench::Consume(static_cast<std::uint64_t>(j));
+        }
+        const auto start = Bench::Clock::now();
+        Profiler::BeginFrame();
+        const auto end = Bench::Clock::now();
+        drainNs = std::min(drainNs, ElapsedNs(start, end) / static_cast<double>(kScopesPerBatch));
+    }
+
+    const double overheadNs = scopeNs - loopNs;
+    // Reported so a failure shows whether the clock or the record path went over
+    const double recordNs = overheadNs - 2.0 * (timestampNs - loopNs);
+    Report("EmptyLoop", loopNs);
+    Report("NowTicks", timestampNs - loopNs);
+    Report("ScopeOverhead", overheadNs);
+    Report("NestedScopeOverhead", nestedNs - loopNs);
+    Report("RecordPathWithoutClock", recordNs);
+    Report("DrainPerEvent", drainNs);
+
+    int failures = 0;
+    if (overheadNs > kBudgetNs) {
+        std::printf("  FAILED: %.2f ns per scope, over the %.0f ns budget (%.2f ns of it in the two clock reads)\n",
+            overheadNs, kBudgetNs, overheadNs - recordNs);
+        ++failures;
+    }
+    else {
+        std::printf("    within the %.0f ns per scope budget\n", kBudgetNs);
+    }
+
+    if (Profiler::DroppedEvents() != 0) {
+        std::printf("  FAILED: %llu events dropped\n", static_cast<unsigned long long>(Profiler::DroppedEvents()));
+        ++failures;
+    }
+    return failures;
+#endif
+}
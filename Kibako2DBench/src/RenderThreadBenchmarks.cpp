@@ -0,0 +1,174 @@
+// Render thread hand-off exercised with a null consumer
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "BenchCommon.h"
+
+#include "KibakoEngine/Renderer/RenderCommandList.h"
+#include "KibakoEngine/Renderer/RenderThread.h"
+#include "KibakoEngine/Renderer/Texture2D.h"
+
+using namespace KibakoEngine;
+
+namespace {
+
+    constexpr std::size_t kSpritesPerFrame = 50'000;
+    constexpr int kFrameCount = 120;
+    constexpr int kTextureCount = 8;
+
+    Texture2D g_textures[kTextureCount];
+
+    // Simulation side: moves sprites around and records them
+    class SpriteSim
+    {
+    public:
+        SpriteSim()
+        {
+            std::mt19937 rng(Bench::kSeed);
+            std::uniform_real_distribution<float> position(0.0f, 4096.0f);
+            std::uniform_real_distribution<float> velocity(-64.0f, 64.0f);
+            std::uniform_int_distribution<int> texture(0, kTextureCount - 1);
+            std::uniform_int_distribution<int> layer(0, 3);
+
+            m_sprites.resize(kSpritesPerFrame);
+            for (Sprite& sprite : m_sprites) {
+                sprite.x = position(rng);
+                sprite.y = position(rng);
+                sprite.vx = velocity(rng);
+                sprite.vy = velocity(rng);
+                sprite.texture = texture(rng);
+                sprite.layer = layer(rng);
+            }
+        }
+
+        void Record(RenderCommandList& list, std::uint64_t frameIndex)
+        {
+            constexpr float dt = 1.0f / 60.0f;
+
+            list.SetFrameIndex(frameIndex);
+            for (Sprite& sprite : m_sprites) {
+                sprite.x += sprite.vx * dt;
+                sprite.y += sprite.vy * dt;
+
+                SpriteCommand cmd{};
+                cmd.texture = &g_textures[sprite.texture];
+                cmd.dst = RectF::FromXYWH(sprite.x, sprite.y, 32.0f, 32.0f);
+                cmd.src = RectF::FromXYWH(0.0f, 0.0f, 1.0f, 1.0f);
+                cmd.rotation = sprite.x * 0.001f;
+                cmd.layer = sprite.layer;
+                list.PushSprite(cmd);
+            }
+        }
+
+    private:
+        struct Sprite
+        {
+            float x = 0.0f;
+            float y = 0.0f;
+            float vx = 0.0f;
+            float vy = 0.0f;
+            int   texture = 0;
+            int   layer = 0;
+        };
+
+        std::vector<Sprite> m_sprites;
+    };
+
+    // Render side without a GPU: sort + vertex work, folded into a checksum
+    class NullConsumer
+    {
+    public:
+        void Execute(const RenderCommandList& list)
+        {
+            if (list.FrameIndex() != m_expectedFrame)
+                ++m_outOfOrder;
+            m_expectedFrame = list.FrameIndex() + 1;
+
+            m_scratch.assign(list.Sprites().begin(), list.Sprites().end());
+            std::stable_sort(m_scratch.begin(), m_scratch.end(),
+                [](const SpriteCommand& a, const SpriteCommand& b) {
+                    if (a.layer != b.layer)
+                        return a.layer < b.layer;
+                    return a.texture < b.texture;
+                });
+
+            std::uint64_t hash = list.FrameIndex();
+            for (const SpriteCommand& cmd : m_scratch) {
+                const float cs = std::cos(cmd.rotation);
+                const float sn = std::sin(cmd.rotation);
+                const float x = cmd.dst.x * cs - cmd.dst.y * sn;
+                const float y = cmd.dst.x * sn + cmd.dst.y * cs;
+                hash = hash * 1099511628211ull + static_cast<std::uint64_t>(static_cast<std::int64_t>(x + y));
+            }
+            m_checksum ^= hash;
+        }
+
+        [[nodiscard]] std::uint64_t Checksum() const { return m_checksum; }
+        [[nodiscard]] int OutOfOrder() const { return m_outOfOrder; }
+
+    private:
+        std::vector<SpriteCommand> m_scratch;
+        std::uint64_t m_checksum = 0;
+        std::uint64_t m_expectedFrame = 0;
+        int           m_outOfOrder = 0;
+    };
+
+} // namespace
+
+int RunRenderThreadBenchmarks()
+{
+    std::printf("\n[RenderThread] %zu sprites x %d frames, seed %u\n", kSpritesPerFrame, kFrameCount, Bench::kSeed);
+
+    std::uint64_t serialChecksum = 0;
+    Bench::Run("Serial", 1, [&]() {
+        SpriteSim sim;
+        NullConsumer consumer;
+        RenderCommandList list;
+        for (int frame = 0; frame < kFrameCount; ++frame) {
+            list.Reset();
+            sim.Record(list, static_cast<std::uint64_t>(frame));
+            consumer.Execute(list);
+        }
+        serialChecksum = consumer.Checksum();
+    });
+
+    std::uint64_t threadedChecksum = 0;
+    int outOfOrder = 0;
+    bool startFailed = false;
+    Bench::Run("Pipelined", 1, [&]() {
+        SpriteSim sim;
+        NullConsumer consumer;
+        RenderThread renderThread;
+        if (!renderThread.Start([&](const RenderCommandList& list) { consumer.Execute(list); })) {
+            startFailed = true;
+            return;
+        }
+
+        RenderFrameQueue& queue = renderThread.Queue();
+        for (int frame = 0; frame < kFrameCount; ++frame) {
+            RenderCommandList* list = queue.BeginRecord();
+            if (!list)
+                break;
+            sim.Record(*list, static_cast<std::uint64_t>(frame));
+            queue.Submit();
+        }
+        renderThread.Stop();
+
+        threadedChecksum = consumer.Checksum();
+        outOfOrder = consumer.OutOfOrder();
+    });
+
+    std::printf("  checksum: serial=%016llx pipelined=%016llx\n",
+                static_cast<unsigned long long>(serialChecksum),
+                static_cast<unsigned long long>(threadedChecksum));
+
+    if (startFailed || serialChecksum != threadedChecksum || outOfOrder != 0) {
+        std::printf("  MISMATCH between serial and pipelined frames\n");
+        return 1;
+    }
+    return 0;
+}
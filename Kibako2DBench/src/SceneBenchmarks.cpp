@@ -0,0 +1,130 @@
+// Scene2D entity bookkeeping and collider intersection batches
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "BenchCommon.h"
+
+#include "KibakoEngine/Collision/Collision2D.h"
+#include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Scene/Scene2D.h"
+
+using namespace KibakoEngine;
+
+namespace {
+
+    constexpr std::size_t kEntityCount = 4096;
+    constexpr std::size_t kLookupCount = 4096;
+    constexpr std::size_t kColliderCount = 1024;
+    constexpr int kIterations = 10;
+
+    struct ColliderSet
+    {
+        std::vector<Transform2D>      transforms;
+        std::vector<CircleCollider2D> circles;
+        std::vector<AABBCollider2D>   boxes;
+    };
+
+    ColliderSet MakeColliders()
+    {
+        std::mt19937 rng(Bench::kSeed);
+        std::uniform_real_distribution<float> position(0.0f, 2048.0f);
+        std::uniform_real_distribution<float> size(4.0f, 64.0f);
+
+        ColliderSet set;
+        set.transforms.resize(kColliderCount);
+        set.circles.resize(kColliderCount);
+        set.boxes.resize(kColliderCount);
+        for (std::size_t i = 0; i < kColliderCount; ++i) {
+            set.transforms[i].position = { position(rng), position(rng) };
+            set.circles[i].radius = size(rng);
+            set.boxes[i].halfW = size(rng);
+            set.boxes[i].halfH = size(rng);
+        }
+        return set;
+    }
+
+    void FillScene(Scene2D& scene)
+    {
+        scene.Clear();
+        for (std::size_t i = 0; i < kEntityCount; ++i) {
+            Entity2D& entity = scene.CreateEntity();
+            entity.transform.position = { static_cast<float>(i), 0.0f };
+        }
+    }
+
+} // namespace
+
+int RunSceneBenchmarks()
+{
+    std::printf("\n[Scene] %zu entities, %zu colliders (all pairs), seed %u\n", kEntityCount, kColliderCount, Bench::kSeed);
+
+    // Entity creation traces every id; keep the timings about the scene, not stdout
+    const LogConfig previousConfig = GetLogConfig();
+    LogConfig quietConfig = previousConfig;
+    quietConfig.minimumLevel = LogLevel::Warning;
+    SetLogConfig(quietConfig);
+
+    Scene2D scene;
+    Bench::Run("CreateEntities", kIterations, [&]() {
+        FillScene(scene);
+        Bench::Consume(scene.Entities().size());
+    });
+
+    std::mt19937 rng(Bench::kSeed);
+    std::uniform_int_distribution<EntityID> anyId(1, static_cast<EntityID>(kEntityCount));
+    std::vector<EntityID> lookups(kLookupCount);
+    for (EntityID& id : lookups)
+        id = anyId(rng);
+
+    FillScene(scene);
+    Bench::Run("FindEntity", kIterations, [&]() {
+        std::uint64_t found = 0;
+        for (const EntityID id : lookups)
+            found += scene.FindEntity(id) != nullptr ? 1u : 0u;
+        Bench::Consume(found);
+    });
+
+    std::vector<EntityID> destroyOrder(kEntityCount);
+    for (std::size_t i = 0; i < kEntityCount; ++i)
+        destroyOrder[i] = static_cast<EntityID>(i + 1);
+    std::shuffle(destroyOrder.begin(), destroyOrder.end(), rng);
+
+    Bench::Run("CreateDestroyEntities", kIterations, [&]() {
+        FillScene(scene);
+        for (const EntityID id : destroyOrder)
+            scene.DestroyEntity(id);
+        Bench::Consume(scene.Entities().size());
+    });
+
+    SetLogConfig(previousConfig);
+
+    const ColliderSet set = MakeColliders();
+    std::uint64_t circleHits = 0;
+    Bench::Run("IntersectsCirclePairs", kIterations, [&]() {
+        circleHits = 0;
+        for (std::size_t i = 0; i < kColliderCount; ++i) {
+            for (std::size_t j = i + 1; j < kColliderCount; ++j)
+                circleHits += Intersects(set.circles[i], set.transforms[i], set.circles[j], set.transforms[j]) ? 1u : 0u;
+        }
+        CountPairsTested(kColliderCount * (kColliderCount - 1) / 2);
+        Bench::Consume(circleHits);
+    });
+
+    std::uint64_t boxHits = 0;
+    Bench::Run("IntersectsAABBPairs", kIterations, [&]() {
+        boxHits = 0;
+        for (std::size_t i = 0; i < kColliderCount; ++i) {
+            for (std::size_t j = i + 1; j < kColliderCount; ++j)
+                boxHits += Intersects(set.boxes[i], set.transforms[i], set.boxes[j], set.transforms[j]) ? 1u : 0u;
+        }
+        CountPairsTested(kColliderCount * (kColliderCount - 1) / 2);
+        Bench::Consume(boxHits);
+    });
+
+    std::printf("    %llu circle hits, %llu box hits\n",
+        static_cast<unsigned long long>(circleHits), static_cast<unsigned long long>(boxHits));
+    return 0;
+}
@@ -0,0 +1,271 @@
+// Software rasterizer fill rate and determinism across worker counts / SIMD
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchCommon.h"
+
+#include "KibakoEngine/Core/Application.h"
+#include "KibakoEngine/Core/Layer.h"
+#include "KibakoEngine/Renderer/ImageRGBA8.h"
+#include "KibakoEngine/Renderer/RendererSoftware.h"
+#include "KibakoEngine/Renderer/Texture2D.h"
+
+using namespace KibakoEngine;
+
+namespace {
+
+    constexpr std::uint32_t kWidth = 1280;
+    constexpr std::uint32_t kHeight = 720;
+    constexpr std::size_t kSpriteCount = 20'000;
+    constexpr int kIterations = 3;
+
+    // Application-path check: an 8x8 texture loaded through the AssetManager, seen by a moved camera
+    constexpr int         kProbeWidth = 256;
+    constexpr int         kProbeHeight = 128;
+    constexpr int         kProbeTexels = 8;
+    constexpr float       kProbeTexelPixels = 8.0f;
+    constexpr float       kProbeCameraX = 32.0f;
+    constexpr float       kProbeCameraY = 16.0f;
+    constexpr float       kProbeSpriteX = 64.0f;
+    constexpr float       kProbeSpriteY = 32.0f;
+    constexpr const char* kProbeTexturePath = "kibako_bench_probe.tga";
+
+    using Bench::SpriteSource;
+
+    // Pixel-space orthographic projection, so the scene does not depend on Camera2D
+    DirectX::XMFLOAT4X4 MakePixelProjection()
+    {
+        DirectX::XMFLOAT4X4 m{};
+        m.m[0][0] = 2.0f / static_cast<float>(kWidth);
+        m.m[0][3] = -1.0f;
+        m.m[1][1] = -2.0f / static_cast<float>(kHeight);
+        m.m[1][3] = 1.0f;
+        m.m[2][2] = 1.0f;
+        m.m[3][3] = 1.0f;
+        return m;
+    }
+
+    // Checkerboard with a transparent border, so blending and clamping both matter
+    bool MakeTexture(Texture2D& texture, int size, std::uint8_t tint)
+    {
+        std::vector<std::uint8_t> pixels(static_cast<std::size_t>(size) * size * 4u);
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                std::uint8_t* p = pixels.data() + (static_cast<std::size_t>(y) * size + x) * 4u;
+                const bool odd = ((x / 4) + (y / 4)) % 2 != 0;
+                const bool border = x == 0 || y == 0 || x == size - 1 || y == size - 1;
+                p[0] = odd ? tint : 255;
+                p[1] = odd ? 64 : tint;
+                p[2] = static_cast<std::uint8_t>(x * 255 / size);
+                p[3] = border ? 0 : static_cast<std::uint8_t>(128 + y * 127 / size);
+            }
+        }
+        return texture.CreateFromRGBA8(nullptr, size, size, pixels.data());
+    }
+
+    // Partly off screen, translucent, a quarter of them rotated
+    std::vector<SpriteSource> MakeSprites()
+    {
+        Bench::SpriteParams params;
+        params.count = kSpriteCount;
+        params.minX = params.minY = -64.0f;
+        params.maxX = static_cast<float>(kWidth);
+        params.maxY = static_cast<float>(kHeight);
+        params.minSize = 8.0f;
+        params.maxSize = 96.0f;
+        params.rotatedShare = 0.25f;
+        params.randomColors = true;
+        params.layerCount = 8;
+        params.textureCount = 3;
+        return Bench::MakeSprites(params);
+    }
+
+    void RenderScene(RendererSoftware& renderer, const std::vector<SpriteSource>& sprites, const Texture2D* const* textures)
+    {
+        const float clearColor[4] = { 0.1f, 0.1f, 0.15f, 1.0f };
+        const RectF src = RectF::FromXYWH(0.0f, 0.0f, 1.0f, 1.0f);
+
+        renderer.BeginFrame(clearColor);
+        SpriteBatch2D& batch = renderer.Batch();
+        batch.Begin(MakePixelProjection());
+        for (const SpriteSource& sprite : sprites)
+            batch.Push(*textures[sprite.texture], sprite.dst, src, sprite.color, sprite.rotation, sprite.layer);
+        batch.End();
+        renderer.EndFrame(false);
+    }
+
+    bool RunConfig(const char* name, int workers, bool simd, const std::vector<SpriteSource>& sprites,
+                   const Texture2D* const* textures, ImageRGBA8& outImage)
+    {
+        RendererSoftware renderer;
+        if (!renderer.Init(kWidth, kHeight, workers))
+            return false;
+        renderer.SetSimdEnabled(simd);
+
+        Bench::Run(name, kIterations, [&]() {
+            RenderScene(renderer, sprites, textures);
+            Bench::Consume(renderer.Stats().pixelsShaded);
+        });
+
+        const SoftwareRenderStats& stats = renderer.Stats();
+        std::printf("    %u sprites, %u tiles, %.1f Mpix shaded\n",
+            stats.sprites, stats.tiles, static_cast<double>(stats.pixelsShaded) / 1.0e6);
+
+        outImage = renderer.Image();
+        renderer.Shutdown();
+        return true;
+    }
+
+    // Opaque texels whose channels are 0 or 255 come out unchanged through the sRGB decode
+    void ProbeTexel(int x, int y, std::uint8_t out[4])
+    {
+        out[0] = (x & 1) != 0 ? 255 : 0;
+        out[1] = (y & 1) != 0 ? 255 : 0;
+        out[2] = ((x + y) & 2) != 0 ? 255 : 0;
+        out[3] = 255;
+    }
+
+    class ProbeLayer final : public Layer
+    {
+    public:
+        explicit ProbeLayer(const Texture2D& texture) : Layer("Probe"), m_texture(texture) {}
+
+        void OnRender(SpriteBatch2D& batch) override
+        {
+            const RectF src = RectF::FromXYWH(0.0f, 0.0f, 1.0f, 1.0f);
+            const float size = kProbeTexels * kProbeTexelPixels;
+            batch.Push(m_texture, RectF::FromXYWH(kProbeSpriteX, kProbeSpriteY, size, size), src, Color4::White());
+            // Translucent, tinted and rotated, only compared between the scalar and SSE2 paths
+            batch.Push(m_texture, RectF::FromXYWH(176.0f, 40.0f, 56.0f, 40.0f), src,
+                Color4{ 1.0f, 0.6f, 0.3f, 0.55f }, 0.4f, 1);
+        }
+
+    private:
+        const Texture2D& m_texture;
+    };
+
+    bool RenderThroughApplication(bool simd, ImageRGBA8& out)
+    {
+        Application app;
+        if (!app.InitHeadless(kProbeWidth, kProbeHeight, HeadlessBackend::Software))
+            return false;
+        static_cast<RendererSoftware&>(app.Renderer()).SetSimdEnabled(simd);
+        app.Renderer().Camera().SetPosition(kProbeCameraX, kProbeCameraY);
+
+        const Texture2D* texture = app.Assets().LoadTexture("probe", kProbeTexturePath);
+        bool rendered = false;
+        if (texture) {
+            ProbeLayer layer(*texture);
+            app.PushLayer(&layer);
+            app.SetFrameLimit(1);
+            const float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+            app.Run(clearColor, false);
+            app.PopLayer(&layer);
+            rendered = app.Renderer().CaptureImage(out);
+        }
+        app.Shutdown();
+        return rendered;
+    }
+
+    int CheckApplicationPath()
+    {
+        ImageRGBA8 texture;
+        texture.Resize(kProbeTexels, kProbeTexels);
+        for (int y = 0; y < kProbeTexels; ++y) {
+            for (int x = 0; x < kProbeTexels; ++x)
+                ProbeTexel(x, y, texture.pixels.data() + (static_cast<std::size_t>(y) * kProbeTexels + x) * 4u);
+        }
+
+        ImageRGBA8 scalar;
+        ImageRGBA8 simd;
+        const bool rendered = ImageIO::SaveTGA(kProbeTexturePath, texture)
+            && RenderThroughApplication(false, scalar) && RenderThroughApplication(true, simd);
+        std::remove(kProbeTexturePath);
+        if (!rendered) {
+            std::printf("  FAILED to render through the headless application\n");
+            return 1;
+        }
+
+        int failures = 0;
+        const ImageDiff diff = ImageIO::Compare(scalar, simd);
+        if (!diff.Matches()) {
+            std::printf("  MISMATCH application path, scalar vs SIMD: %llu pixels (max delta %u)\n",
+                static_cast<unsigned long long>(diff.mismatchedPixels), diff.maxChannelDelta);
+            ++failures;
+        }
+
+        // Each texel's center pixel, shifted by the camera, and the cleared corner
+        int wrongTexels = 0;
+        for (int ty = 0; ty < kProbeTexels; ++ty) {
+            for (int tx = 0; tx < kProbeTexels; ++tx) {
+                const auto px = static_cast<std::uint32_t>(kProbeSpriteX - kProbeCameraX + (tx + 0.5f) * kProbeTexelPixels);
+                const auto py = static_cast<std::uint32_t>(kProbeSpriteY - kProbeCameraY + (ty + 0.5f) * kProbeTexelPixels);
+                std::uint8_t expected[4];
+                ProbeTexel(tx, ty, expected);
+                if (std::memcmp(simd.pixels.data() + (static_cast<std::size_t>(py) * simd.width + px) * 4u, expected, 4) != 0)
+                    ++wrongTexels;
+            }
+        }
+        const std::uint8_t cleared[4] = { 0, 0, 0, 255 };
+        if (wrongTexels > 0 || std::memcmp(simd.pixels.data(), cleared, 4) != 0) {
+            std::printf("  MISMATCH application path: %d of %d texels misplaced or miscolored\n",
+                wrongTexels, kProbeTexels * kProbeTexels);
+            ++failures;
+        }
+
+        std::printf("  %-28s %s\n", "ApplicationPath", failures == 0 ? "pixel-exact" : "FAILED");
+        return failures;
+    }
+
+} // namespace
+
+int RunSoftwareRasterBenchmarks()
+{
+    const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const int workerCount = static_cast<int>(std::min(hardwareThreads, 16u)) - 1;
+
+    std::printf("\n[SoftwareRaster] %ux%u, %zu sprites, %d workers, seed %u\n",
+        kWidth, kHeight, kSpriteCount, workerCount, Bench::kSeed);
+
+    Texture2D textures[3];
+    if (!MakeTexture(textures[0], 16, 200) || !MakeTexture(textures[1], 32, 90) || !MakeTexture(textures[2], 8, 30)) {
+        std::printf("  FAILED to create CPU textures\n");
+        return 1;
+    }
+    const Texture2D* texturePtrs[3] = { &textures[0], &textures[1], &textures[2] };
+
+    const std::vector<SpriteSource> sprites = MakeSprites();
+
+    ImageRGBA8 scalarSingle;
+    ImageRGBA8 simdSingle;
+    ImageRGBA8 simdParallel;
+    if (!RunConfig("ScalarSingleThread", 0, false, sprites, texturePtrs, scalarSingle) ||
+        !RunConfig("SimdSingleThread", 0, true, sprites, texturePtrs, simdSingle) ||
+        !RunConfig("SimdParallel", workerCount, true, sprites, texturePtrs, simdParallel)) {
+        std::printf("  FAILED to initialize software renderer\n");
+        return 1;
+    }
+
+    int failures = 0;
+    const ImageDiff simdDiff = ImageIO::Compare(scalarSingle, simdSingle);
+    if (!simdDiff.Matches()) {
+        std::printf("  MISMATCH scalar vs SIMD: %llu pixels (max delta %u)\n",
+            static_cast<unsigned long long>(simdDiff.mismatchedPixels), simdDiff.maxChannelDelta);
+        ++failures;
+    }
+
+    const ImageDiff parallelDiff = ImageIO::Compare(simdSingle, simdParallel);
+    if (!parallelDiff.Matches()) {
+        std::printf("  MISMATCH single vs parallel: %llu pixels (max delta %u)\n",
+            static_cast<unsigned long long>(parallelDiff.mismatchedPixels), parallelDiff.maxChannelDelta);
+        ++failures;
+    }
+
+    failures += CheckApplicationPath();
+    return failures;
+}
@@ -0,0 +1,217 @@
+// SpriteBatch2D sort and vertex build through the headless backend
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "BenchCommon.h"
+
+#include "KibakoEngine/Core/PerfCounters.h"
+#include "KibakoEngine/Renderer/RendererNull.h"
+#include "KibakoEngine/Renderer/Texture2D.h"
+
+using namespace KibakoEngine;
+
+namespace {
+
+    constexpr std::size_t kSpriteCount = 100'000;
+    constexpr int kTextureCount = 16;
+    constexpr int kLayerCount = 32;
+    constexpr int kIterations = 20;
+
+    using Bench::SpriteSource;
+
+    std::vector<SpriteSource> MakeSprites(bool rotated)
+    {
+        Bench::SpriteParams params;
+        params.count = kSpriteCount;
+        params.rotatedShare = rotated ? 1.0f : 0.0f;
+        params.layerCount = kLayerCount;
+        params.textureCount = kTextureCount;
+        return Bench::MakeSprites(params);
+    }
+
+    void DrawFrame(SpriteBatch2D& batch, const std::vector<SpriteSource>& sprites, const std::vector<Texture2D>& textures)
+    {
+        const RectF src = RectF::FromXYWH(0.0f, 0.0f, 1.0f, 1.0f);
+
+        batch.Begin(DirectX::XMFLOAT4X4{});
+        for (const SpriteSource& sprite : sprites)
+            batch.Push(textures[sprite.texture], sprite.dst, src, Color4::White(), sprite.rotation, sprite.layer);
+        batch.End();
+        Bench::Consume(batch.Stats().drawCalls);
+    }
+
+    // The main thread pushes the first share directly and each worker records the next one, so
+    // the merge (direct pushes first on ties, then buffer order) must reproduce DrawFrame
+    void DrawFrameThreaded(SpriteBatch2D& batch, const std::vector<SpriteSource>& sprites,
+                           const std::vector<Texture2D>& textures, std::size_t workerCount)
+    {
+        const RectF src = RectF::FromXYWH(0.0f, 0.0f, 1.0f, 1.0f);
+        const std::size_t chunk = (sprites.size() + workerCount) / (workerCount + 1);
+        const auto record = [&](std::size_t begin, std::size_t end, auto& target) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const SpriteSource& sprite = sprites[i];
+                target.Push(textures[sprite.texture], sprite.dst, src, Color4::White(), sprite.rotation, sprite.layer);
+            }
+        };
+
+        batch.Begin(DirectX::XMFLOAT4X4{});
+        const std::span<SpriteCommandBuffer> buffers = batch.AcquireThreadBuffers(workerCount);
+
+        std::vector<std::thread> workers;
+        workers.reserve(workerCount);
+        for (std::size_t w = 0; w < workerCount; ++w) {
+            const std::size_t begin = std::min(sprites.size(), (w + 1) * chunk);
+            const std::size_t end = std::min(sprites.size(), begin + chunk);
+            workers.emplace_back([&, w, begin, end]() {
+                SpriteCommandBuffer& buffer = buffers[w];
+                buffer.Reserve(end - begin);
+                record(begin, end, buffer);
+                buffer.Sort();
+            });
+        }
+
+        record(0, std::min(sprites.size(), chunk), batch);
+        for (std::thread& worker : workers)
+            worker.join();
+
+        batch.End();
+        Bench::Consume(batch.Stats().drawCalls);
+    }
+
+    template <typename Draw>
+    CapturedFrame CaptureFrame(RendererNull& renderer, Draw&& draw)
+    {
+        const float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+        renderer.SetCaptureEnabled(true);
+        renderer.BeginFrame(clearColor);
+        draw();
+        renderer.EndFrame(false);
+        renderer.SetCaptureEnabled(false);
+        return renderer.LastFrame();
+    }
+
+    bool SameVertex(const SpriteVertex& a, const SpriteVertex& b)
+    {
+        return a.position.x == b.position.x && a.position.y == b.position.y && a.position.z == b.position.z
+            && a.uv.x == b.uv.x && a.uv.y == b.uv.y
+            && a.color.x == b.color.x && a.color.y == b.color.y && a.color.z == b.color.z && a.color.w == b.color.w;
+    }
+
+    bool SameFrame(const CapturedFrame& a, const CapturedFrame& b)
+    {
+        if (a.vertices.size() != b.vertices.size() || a.draws.size() != b.draws.size())
+            return false;
+        for (std::size_t i = 0; i < a.vertices.size(); ++i) {
+            if (!SameVertex(a.vertices[i], b.vertices[i]))
+                return false;
+        }
+        for (std::size_t i = 0; i < a.draws.size(); ++i) {
+            const SpriteDrawRange& ra = a.draws[i].range;
+            const SpriteDrawRange& rb = b.draws[i].range;
+            if (ra.texture != rb.texture || ra.firstSprite != rb.firstSprite || ra.spriteCount != rb.spriteCount)
+                return false;
+        }
+        return true;
+    }
+
+    // Every pushed sprite must reach the backend exactly once, in ranges that tile the quads
+    int CheckCapturedFrame(RendererNull& renderer, const std::vector<SpriteSource>& sprites, const std::vector<Texture2D>& textures)
+    {
+        const NullRenderStats before = renderer.Stats();
+        const CapturedFrame frame = CaptureFrame(renderer, [&]() { DrawFrame(renderer.Batch(), sprites, textures); });
+        const NullRenderStats& stats = renderer.Stats();
+        std::size_t rangeSprites = 0;
+        std::uint32_t nextSprite = 0;
+        bool contiguous = true;
+        for (const CapturedSpriteDraw& draw : frame.draws) {
+            contiguous = contiguous && draw.range.firstSprite == nextSprite;
+            nextSprite = draw.range.firstSprite + draw.range.spriteCount;
+            rangeSprites += draw.range.spriteCount;
+        }
+
+        const std::size_t capturedSprites = frame.vertices.size() / 4;
+        std::printf("  %-28s %zu sprites in %zu ranges\n", "CapturedFrame", capturedSprites, frame.draws.size());
+        if (capturedSprites != sprites.size() || rangeSprites != sprites.size() || !contiguous
+            || stats.frames != before.frames + 1 || stats.sprites - before.sprites != sprites.size()
+            || stats.drawRanges - before.drawRanges != frame.draws.size()) {
+            std::printf("  FAILED: captured %zu sprites (%zu in ranges), expected %zu\n",
+                capturedSprites, rangeSprites, sprites.size());
+            return 1;
+        }
+        return 0;
+    }
+
+    // Recording through worker buffers must hand the backend the same frame as direct pushes
+    int CheckThreadBuffers(RendererNull& renderer, const std::vector<SpriteSource>& sprites,
+                           const std::vector<Texture2D>& textures, std::size_t workerCount)
+    {
+        const CapturedFrame serial = CaptureFrame(renderer, [&]() { DrawFrame(renderer.Batch(), sprites, textures); });
+        const CapturedFrame threaded = CaptureFrame(renderer, [&]() {
+            DrawFrameThreaded(renderer.Batch(), sprites, textures, workerCount);
+        });
+
+        if (!SameFrame(serial, threaded)) {
+            std::printf("  MISMATCH between direct pushes and %zu worker buffers\n", workerCount);
+            return 1;
+        }
+        return 0;
+    }
+
+} // namespace
+
+int RunSpriteBatchBenchmarks()
+{
+    std::printf("\n[SpriteBatch] %zu sprites, %d textures, %d layers, seed %u\n",
+        kSpriteCount, kTextureCount, kLayerCount, Bench::kSeed);
+
+    RendererNull renderer;
+    if (!renderer.Init(1280, 720)) {
+        std::printf("  FAILED: headless renderer init\n");
+        return 1;
+    }
+
+    std::vector<Texture2D> textures(kTextureCount);
+    for (int i = 0; i < kTextureCount; ++i) {
+        const auto shade = static_cast<std::uint8_t>(i * 16);
+        if (!textures[i].CreateSolidColor(nullptr, shade, shade, shade)) {
+            std::printf("  FAILED: texture creation\n");
+            return 1;
+        }
+    }
+
+    SpriteBatch2D& batch = renderer.Batch();
+    const std::vector<SpriteSource> axisAligned = MakeSprites(false);
+    const std::vector<SpriteSource> rotated = MakeSprites(true);
+
+    static const PerfCounterId sortTimeId = PerfCounters::Register("render.sortTime", PerfCounterUnit::Nanoseconds);
+
+    // Warm-up outside the counter window
+    DrawFrame(batch, axisAligned, textures);
+    PerfCounters::BeginFrame();
+
+    Bench::Run("PushSortBuild", kIterations, [&]() { DrawFrame(batch, axisAligned, textures); });
+
+    // Run adds one warm-up call, hence the extra frame
+    PerfCounters::BeginFrame();
+    const double sortMs = static_cast<double>(PerfCounters::FrameValue(sortTimeId)) / 1.0e6 / (kIterations + 1);
+    std::printf("  %-28s %10.3f ms  (render.sortTime)\n", "SortOnly", sortMs);
+    Bench::Record("SortOnly", sortMs, kIterations + 1);
+
+    Bench::Run("PushSortBuildRotated", kIterations, [&]() { DrawFrame(batch, rotated, textures); });
+
+    // Worker threads start per frame, so their start-up is part of the time
+    const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t workerCount = std::clamp<std::size_t>(hardwareThreads - 1, 1, 7);
+    Bench::Run("ThreadBuffersMerge", kIterations, [&]() { DrawFrameThreaded(batch, axisAligned, textures, workerCount); });
+
+    int failures = CheckCapturedFrame(renderer, rotated, textures);
+    failures += CheckThreadBuffers(renderer, rotated, textures, workerCount);
+
+    renderer.Shutdown();
+    return failures;
+}
@@ -0,0 +1,125 @@
+// Parallel sprite recording into per-thread command buffers
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "BenchCommon.h"
+
+#include "KibakoEngine/Renderer/SpriteCommandBuffer.h"
+#include "KibakoEngine/Renderer/Texture2D.h"
+
+using namespace KibakoEngine;
+
+namespace {
+
+    constexpr std::size_t kSpriteCount = 1'000'000;
+    constexpr int kLayerCount = 64;
+    constexpr int kIterations = 5;
+
+    // Without a device every texture shares sort id 0, so layers provide the key spread
+    Texture2D g_texture;
+
+    using Bench::SpriteSource;
+
+    std::vector<SpriteSource> MakeSprites()
+    {
+        Bench::SpriteParams params;
+        params.count = kSpriteCount;
+        params.maxX = params.maxY = 8192.0f;
+        params.minSize = params.maxSize = 16.0f;
+        params.firstLayer = -kLayerCount / 2;
+        params.layerCount = kLayerCount;
+        return Bench::MakeSprites(params);
+    }
+
+    void RecordRange(const std::vector<SpriteSource>& sprites, std::size_t begin, std::size_t end,
+                     SpriteCommandBuffer& buffer)
+    {
+        buffer.Clear();
+        buffer.Reserve(end - begin);
+        const RectF src = RectF::FromXYWH(0.0f, 0.0f, 1.0f, 1.0f);
+        for (std::size_t i = begin; i < end; ++i)
+            buffer.Push(g_texture, sprites[i].dst, src, Color4::White(), 0.0f, sprites[i].layer);
+        buffer.Sort();
+    }
+
+    bool SameOrder(const std::vector<SpriteCommand>& a, const std::vector<SpriteCommand>& b)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (a[i].sortKey != b[i].sortKey || a[i].dst.x != b[i].dst.x || a[i].dst.y != b[i].dst.y)
+                return false;
+        }
+        return true;
+    }
+
+} // namespace
+
+int RunSpriteRecordBenchmarks()
+{
+    const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t workerCount = std::min<std::size_t>(hardwareThreads, 8);
+
+    std::printf("\n[SpriteRecord] %zu sprites, %zu workers, seed %u\n", kSpriteCount, workerCount, Bench::kSeed);
+
+    const std::vector<SpriteSource> sprites = MakeSprites();
+
+    SpriteCommandBuffer serial;
+    Bench::Run("SerialPushSort", kIterations, [&]() {
+        RecordRange(sprites, 0, sprites.size(), serial);
+        Bench::Consume(serial.Size());
+    });
+
+    std::vector<SpriteCommandBuffer> buffers(workerCount);
+    std::vector<SpriteCommand> merged;
+
+    // Workers start once and are released per iteration, so the timing covers recording,
+    // not thread start-up (which would also register a profiler ring per new thread)
+    std::barrier start(static_cast<std::ptrdiff_t>(workerCount + 1));
+    std::barrier done(static_cast<std::ptrdiff_t>(workerCount + 1));
+    std::atomic<bool> stop{ false };
+    const std::size_t chunk = (sprites.size() + workerCount - 1) / workerCount;
+
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (std::size_t w = 0; w < workerCount; ++w) {
+        const std::size_t begin = std::min(sprites.size(), w * chunk);
+        const std::size_t end = std::min(sprites.size(), begin + chunk);
+        workers.emplace_back([&, w, begin, end]() {
+            for (;;) {
+                start.arrive_and_wait();
+                if (stop.load(std::memory_order_relaxed))
+                    return;
+                RecordRange(sprites, begin, end, buffers[w]);
+                done.arrive_and_wait();
+            }
+        });
+    }
+
+    Bench::Run("ParallelPushSortMerge", kIterations, [&]() {
+        start.arrive_and_wait();
+        done.arrive_and_wait();
+
+        std::vector<const std::vector<SpriteCommand>*> runs;
+        for (const SpriteCommandBuffer& buffer : buffers)
+            runs.push_back(&buffer.Commands());
+        SpriteCommandMerge::MergeSorted(runs, merged);
+        Bench::Consume(merged.size());
+    });
+
+    stop.store(true, std::memory_order_relaxed);
+    start.arrive_and_wait();
+    for (std::thread& worker : workers)
+        worker.join();
+
+    if (!SameOrder(serial.Commands(), merged)) {
+        std::printf("  MISMATCH between serial and merged order\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Text measurement and UI layout passes
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "BenchCommon.h"
+
+#include "KibakoEngine/Fonts/Font.h"
+#include "KibakoEngine/UI/UIElement.h"
+
+using namespace KibakoEngine;
+
+namespace {
+
+    constexpr int kFontPixelHeight = 32;
+    constexpr std::size_t kTextLength = 4096;
+    constexpr int kMeasuresPerRun = 64;
+    constexpr int kPanelCount = 32;
+    constexpr int kChildrenPerPanel = 32;
+    constexpr int kIterations = 50;
+
+    // The bench runs from the solution or the build output directory
+    const char* const kFontPaths[] = {
+        "Kibako2DSandbox/assets/fonts/dogica.ttf",
+        "../Kibako2DSandbox/assets/fonts/dogica.ttf",
+        "../../Kibako2DSandbox/assets/fonts/dogica.ttf",
+    };
+
+    const char* FindFont()
+    {
+        for (const char* path : kFontPaths) {
+            if (std::FILE* file = std::fopen(path, "rb")) {
+                std::fclose(file);
+                return path;
+            }
+        }
+        return nullptr;
+    }
+
+    std::string MakeText()
+    {
+        std::mt19937 rng(Bench::kSeed);
+        std::uniform_int_distribution<int> letter('a', 'z');
+        std::uniform_int_distribution<int> wordLength(1, 10);
+
+        std::string text;
+        text.reserve(kTextLength);
+        while (text.size() < kTextLength) {
+            const int length = wordLength(rng);
+            for (int i = 0; i < length; ++i)
+                text.push_back(static_cast<char>(letter(rng)));
+            text.push_back(text.size() % 80 < 8 ? '\n' : ' ');
+        }
+        return text;
+    }
+
+    void BuildTree(UIElement& root)
+    {
+        std::mt19937 rng(Bench::kSeed);
+        std::uniform_real_distribution<float> offset(0.0f, 200.0f);
+        std::uniform_int_distribution<int> anchor(0, 4);
+
+        for (int p = 0; p < kPanelCount; ++p) {
+            UIElement& panel = root.EmplaceChild<UIElement>("Panel");
+            panel.SetAnchor(static_cast<UIAnchor>(anchor(rng)));
+            panel.SetPosition({ offset(rng), offset(rng) });
+            panel.SetSize({ 300.0f, 200.0f });
+
+            for (int c = 0; c < kChildrenPerPanel; ++c) {
+                UIElement& child = panel.EmplaceChild<UIElement>("Item");
+                child.SetAnchor(static_cast<UIAnchor>(anchor(rng)));
+                child.SetPosition({ offset(rng), offset(rng) });
+                child.SetSize({ 40.0f, 20.0f });
+            }
+        }
+    }
+
+    void RunTextBenchmarks()
+    {
+        const char* fontPath = FindFont();
+        if (!fontPath) {
+            std::printf("  MeasureText skipped: dogica.ttf not found from the working directory\n");
+            return;
+        }
+
+        FontLibrary library;
+        std::unique_ptr<Font> font = library.Init() ? library.LoadFontFromFile(nullptr, fontPath, kFontPixelHeight) : nullptr;
+        if (!font) {
+            std::printf("  MeasureText skipped: failed to load %s\n", fontPath);
+            return;
+        }
+
+        const std::string text = MakeText();
+        Bench::Run("MeasureText", kIterations, [&]() {
+            float width = 0.0f;
+            for (int i = 0; i < kMeasuresPerRun; ++i)
+                width += TextRenderer::MeasureText(*font, text).size.x;
+            Bench::Consume(static_cast<std::uint64_t>(width));
+        });
+
+        font.reset();
+        library.Shutdown();
+    }
+
+} // namespace
+
+int RunTextUIBenchmarks()
+{
+    std::printf("\n[TextUI] %zu chars x %d, %d UI elements, seed %u\n",
+        kTextLength, kMeasuresPerRun, kPanelCount * (kChildrenPerPanel + 1), Bench::kSeed);
+
+    RunTextBenchmarks();
+
+    UIElement root("Root");
+    BuildTree(root);
+
+    UIContext ctx{};
+    ctx.screenSize = { 1280.0f, 720.0f };
+
+    // Alternating the screen size dirties every cached layout
+    bool wide = false;
+    Bench::Run("UILayoutFull", kIterations, [&]() {
+        wide = !wide;
+        ctx.screenSize = wide ? DirectX::XMFLOAT2{ 1920.0f, 1080.0f } : DirectX::XMFLOAT2{ 1280.0f, 720.0f };
+        root.Update(ctx);
+        Bench::Consume(static_cast<std::uint64_t>(root.WorldRect(ctx).w));
+    });
+
+    Bench::Run("UILayoutCached", kIterations, [&]() {
+        root.Update(ctx);
+        Bench::Consume(static_cast<std::uint64_t>(root.WorldRect(ctx).w));
+    });
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Benchmark entry point
+#ifndef NOMINMAX
+#    define NOMINMAX
+#endif
+
+#ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "BenchCommon.h"
+#include "BenchReport.h"
+
+#include "KibakoEngine/Core/SamplingProfiler.h"
+
+int RunCullingBenchmarks();
+int RunRenderThreadBenchmarks();
+int RunSpriteRecordBenchmarks();
+int RunSoftwareRasterBenchmarks();
+int RunProfilerBenchmarks();
+int RunSpriteBatchBenchmarks();
+int RunSceneBenchmarks();
+int RunTextUIBenchmarks();
+int RunLogBenchmarks();
+
+namespace {
+
+    struct Suite
+    {
+        const char* name;
+        int (*run)();
+    };
+
+    const Suite kSuites[] = {
+        { "Culling",        RunCullingBenchmarks },
+        { "RenderThread",   RunRenderThreadBenchmarks },
+        { "SpriteRecord",   RunSpriteRecordBenchmarks },
+        { "SoftwareRaster", RunSoftwareRasterBenchmarks },
+        { "Profiler",       RunProfilerBenchmarks },
+        { "SpriteBatch",    RunSpriteBatchBenchmarks },
+        { "Scene",          RunSceneBenchmarks },
+        { "TextUI",         RunTextUIBenchmarks },
+        { "Log",            RunLogBenchmarks },
+    };
+
+    constexpr double kDefaultThresholdPercent = 10.0;
+
+    void PrintUsage()
+    {
+        std::printf("Usage: Kibako2DBench [--suite name] [--json out.json] [--baseline base.json] [--threshold percent] [--sample-profile out.folded]\n");
+    }
+
+    bool IsSuiteName(const std::string& name)
+    {
+        for (const Suite& suite : kSuites) {
+            if (name == suite.name)
+                return true;
+        }
+        return false;
+    }
+
+    void PrintSuiteNames()
+    {
+        std::printf("Suites:");
+        for (const Suite& suite : kSuites)
+            std::printf(" %s", suite.name);
+        std::printf("\n");
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string suiteFilter;
+    std::string jsonPath;
+    std::string baselinePath;
+    std::string samplePath;
+    double thresholdPercent = kDefaultThresholdPercent;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--suite") == 0 && i + 1 < argc)
+            suiteFilter = argv[++i];
+        else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            jsonPath = argv[++i];
+        else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+            baselinePath = argv[++i];
+        else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+            thresholdPercent = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--sample-profile") == 0 && i + 1 < argc)
+            samplePath = argv[++i];
+        else {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    if (!suiteFilter.empty() && !IsSuiteName(suiteFilter)) {
+        std::printf("Unknown suite '%s'\n", suiteFilter.c_str());
+        PrintSuiteNames();
+        return 2;
+    }
+
+    std::printf("KibakoEngine benchmarks\n");
+
+    if (!samplePath.empty() && !KibakoEngine::SamplingProfiler::Start())
+        return 1;
+
+    int failures = 0;
+    for (const Suite& suite : kSuites) {
+        if (!suiteFilter.empty() && suiteFilter != suite.name)
+            continue;
+
+        Bench::BeginSuite(suite.name);
+        failures += suite.run();
+    }
+
+    if (!samplePath.empty() && !KibakoEngine::SamplingProfiler::WriteFoldedStacks(samplePath.c_str()))
+        ++failures;
+
+    if (!jsonPath.empty() && !Bench::WriteJson(jsonPath, Bench::g_results))
+        ++failures;
+
+    if (!baselinePath.empty()) {
+        std::vector<Bench::Result> baseline;
+        if (!Bench::LoadJson(baselinePath, baseline))
+            ++failures;
+        else
+            failures += Bench::CompareToBaseline(Bench::g_results, baseline, thresholdPercent);
+    }
+
+    return failures == 0 ? 0 : 1;
+}
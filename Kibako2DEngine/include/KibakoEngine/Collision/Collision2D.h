@@ -1,6 +1,8 @@
 // Collider types and helpers
 #pragma once
 
+#include <cstdint>
+
 namespace KibakoEngine {
 
     // Transform2D forward declare
@@ -31,4 +33,8 @@ namespace KibakoEngine {
     bool Intersects(const AABBCollider2D& b1, const Transform2D& t1,
                     const AABBCollider2D& b2, const Transform2D& t2);
 
+    // Adds to collision.pairsTested. Intersects counts nothing itself, so a collision
+    // pass totals its pair tests locally and reports them once.
+    void CountPairsTested(std::uint64_t pairs);
+
 } // namespace KibakoEngine
@@ -2,11 +2,17 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
 #include <vector>
 
+#include "KibakoEngine/Core/FrameStats.h"
 #include "KibakoEngine/Core/Input.h"
+#include "KibakoEngine/Core/Replay.h"
 #include "KibakoEngine/Core/Time.h"
-#include "KibakoEngine/Renderer/RendererD3D11.h"
+#include "KibakoEngine/Renderer/RenderBackend.h"
+#include "KibakoEngine/Renderer/RenderThread.h"
 #include "KibakoEngine/Resources/AssetManager.h"
 
 struct SDL_Window;
@@ -17,6 +23,12 @@ namespace KibakoEngine {
 
     class Layer;
 
+    enum class HeadlessBackend
+    {
+        Null,
+        Software,
+    };
+
     class Application
     {
     public:
@@ -24,6 +36,8 @@ namespace KibakoEngine {
         ~Application() = default;
 
         [[nodiscard]] bool Init(int width, int height, const char* title);
+        // No window or GPU: CPU-only textures, frames discarded (Null) or rasterized (Software)
+        [[nodiscard]] bool InitHeadless(int width, int height, HeadlessBackend backend = HeadlessBackend::Null);
         void Shutdown();
 
         [[nodiscard]] bool PumpEvents();
@@ -31,12 +45,38 @@ namespace KibakoEngine {
         void EndFrame(bool waitForVSync = true);
         void Run(const float clearColor[4], bool waitForVSync = true);
 
-        [[nodiscard]] RendererD3D11& Renderer() { return m_renderer; }
-        [[nodiscard]] const RendererD3D11& Renderer() const { return m_renderer; }
+        // Simulation records command lists, a render thread submits them (set before Run)
+        void SetThreadedRendering(bool enabled) { m_threadedRendering = enabled; }
+        [[nodiscard]] bool IsThreadedRendering() const { return m_threadedRendering; }
+
+        [[nodiscard]] RenderBackend& Renderer() { return *m_renderer; }
+        [[nodiscard]] const RenderBackend& Renderer() const { return *m_renderer; }
+        [[nodiscard]] bool IsHeadless() const { return m_headless; }
+
+        // Run() stops after this many frames (0 = unlimited)
+        void SetFrameLimit(std::uint64_t frames) { m_frameLimit = frames; }
+        [[nodiscard]] std::uint64_t FrameCount() const { return m_frameCount; }
+        void RequestQuit() { m_quitRequested = true; }
+        // Every frame advances by this many seconds instead of the wall clock (0 = wall clock);
+        // replays keep their own steps
+        void SetFixedTimeStep(double seconds) { m_fixedTimeStep = seconds; }
+        [[nodiscard]] double FixedTimeStep() const { return m_fixedTimeStep; }
+
+        // Writes each frame's input, time step and sprite hash (optionally every sprite)
+        bool StartRecording(const std::string& path, bool withSprites = false);
+        // Feeds a recording back in place of live input and wall-clock time; Run stops at its end.
+        // fixedStepSeconds > 0 overrides the recorded time steps.
+        bool StartReplay(const std::string& path, double fixedStepSeconds = 0.0);
+        [[nodiscard]] bool IsRecording() const { return m_recorder.IsOpen(); }
+        [[nodiscard]] bool IsReplaying() const { return m_player.IsOpen(); }
 
         [[nodiscard]] Time& TimeSys() { return m_time; }
         [[nodiscard]] const Time& TimeSys() const { return m_time; }
 
+        // Frame times and the events/update/render/present split, filled by PumpEvents and Run
+        [[nodiscard]] FrameStats& FrameStatsSys() { return m_frameStats; }
+        [[nodiscard]] const FrameStats& FrameStatsSys() const { return m_frameStats; }
+
         [[nodiscard]] Input& InputSys() { return m_input; }
         [[nodiscard]] const Input& InputSys() const { return m_input; }
 
@@ -55,6 +95,14 @@ namespace KibakoEngine {
         void HandleResize();
         void ApplyPendingResize();
         void ToggleFullscreen();
+        void UpdateLayers();
+        void RenderLayers(SpriteBatch2D& batch);
+        void RunThreaded(const float clearColor[4], bool waitForVSync);
+        void ExecuteCommandList(const RenderCommandList& list);
+        bool AdvanceReplay();
+        void FinishInputFrame();
+        void TrackFrameSprites(std::span<const SpriteCommand> sprites);
+        void StopReplay();
 
         SDL_Window* m_window = nullptr;
         HWND        m_hwnd = nullptr;
@@ -68,11 +116,28 @@ namespace KibakoEngine {
         bool m_hasPendingResize = false;
         bool m_fullscreen = false;
         bool m_running = false;
+        bool m_threadedRendering = false;
+        bool m_headless = false;
+        bool m_quitRequested = false;
+
+        std::uint64_t m_frameLimit = 0;
+        std::uint64_t m_frameCount = 0;
+        double        m_fixedTimeStep = 0.0;
 
-        RendererD3D11 m_renderer;
+        std::unique_ptr<RenderBackend> m_renderer;
         Time          m_time;
+        FrameStats    m_frameStats;
         Input         m_input;
         AssetManager  m_assets;
+        RenderThread  m_renderThread;
+
+        ReplayRecorder m_recorder;
+        ReplayPlayer   m_player;
+        ReplayFrame    m_replayFrame;
+        double         m_replayFixedStep = 0.0;
+        std::uint64_t  m_replayMismatches = 0;
+        // Threaded mode's frame in draw order, while recording or replaying
+        std::vector<SpriteCommand> m_trackedSprites;
 
         std::vector<Layer*> m_layers;
     };
@@ -0,0 +1,242 @@
+// Deferred binary logging: raw arguments now, printf formatting offline
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "KibakoEngine/Core/Debug.h"
+#include "KibakoEngine/Core/Log.h"
+
+namespace KibakoEngine {
+
+    // How one argument is stored; the decoder picks the printf length modifier from it
+    enum class BinaryLogArg : std::uint8_t
+    {
+        Int,      // Any signed integer or enum, widened to 64 bits
+        UInt,     // Any unsigned integer or bool, widened to 64 bits
+        Double,
+        String,   // Copied, up to kMaxBinaryLogString bytes
+        Pointer
+    };
+
+    inline constexpr std::size_t kMaxBinaryLogString = 1024;
+
+    struct BinaryLogEntry
+    {
+        std::int64_t timeMs = 0;  // Wall clock, milliseconds since the epoch
+        std::int64_t timeNs = 0;  // Since the log was opened
+        LogLevel     level = LogLevel::Trace;
+        std::string  channel;
+        std::string  file;
+        int          line = 0;
+        std::string  function;
+        std::string  message;     // Formatted by the reader
+    };
+
+    // Reads entries in file order; threads write whole buffers, so entries from
+    // different threads interleave in blocks rather than by time
+    class BinaryLogReader
+    {
+    public:
+        BinaryLogReader() = default;
+        ~BinaryLogReader() { Close(); }
+
+        BinaryLogReader(const BinaryLogReader&) = delete;
+        BinaryLogReader& operator=(const BinaryLogReader&) = delete;
+
+        bool Open(const char* path);
+        void Close();
+
+        // False at the end of the log or on a damaged record
+        bool Next(BinaryLogEntry& out);
+
+    private:
+        struct SiteInfo
+        {
+            bool                      defined = false;
+            LogLevel                  level = LogLevel::Trace;
+            int                       line = 0;
+            std::string               channel;
+            std::string               file;
+            std::string               function;
+            std::string               format;
+            std::vector<BinaryLogArg> args;
+        };
+
+        bool ReadSite();
+        bool ReadEntry(BinaryLogEntry& out);
+
+        std::FILE*            m_file = nullptr;
+        std::int64_t          m_openedMs = 0;
+        double                m_nsPerTick = 1.0;
+        std::vector<SiteInfo> m_sites;  // Indexed by site id
+    };
+
+    namespace BinaryLog {
+
+        // Deferred calls below minimumLevel are dropped; while no binary log is open
+        // they go through the regular text logger instead
+        bool Open(const char* path, LogLevel minimumLevel = LogLevel::Trace);
+        void Close();
+        [[nodiscard]] bool IsOpen();
+
+        // Records wait in per-thread buffers. Flush writes out every thread's buffer;
+        // BeginFrame does so once kFlushIntervalMs has passed since the last flush. While
+        // the crash log's handlers are installed, a crash writes out what it can too.
+        inline constexpr std::uint32_t kFlushIntervalMs = 1000;
+        void Flush();
+        void BeginFrame();
+
+        // Decodes a binary log into text lines in console format, sorted by time
+        bool Decode(const char* binaryPath, const char* textPath);
+
+        namespace Detail
+        {
+            // Lowest level the open log records; kNotOpen while no log is open
+            inline constexpr std::uint8_t kNotOpen = 0xFF;
+            inline std::atomic<std::uint8_t> g_minimumLevel{ kNotOpen };
+
+            // Checked by KBK_LOG_DEFERRED before any argument is evaluated
+            inline bool ShouldRecord(LogLevel level, const char* channel)
+            {
+                const std::uint8_t minimum = g_minimumLevel.load(std::memory_order_relaxed);
+                if (minimum == kNotOpen)
+                    return KibakoEngine::Detail::ShouldLog(level, channel);
+                return static_cast<std::uint8_t>(level) >= minimum;
+            }
+
+            // One per call site. The format string and channel must outlive the log
+            // (string literals do); they are written once per opened file.
+            struct Site
+            {
+                LogLevel                   level;
+                const char*                channel;
+                const char*                file;
+                int                        line;
+                const char*                function;
+                std::atomic<std::uint32_t> epoch{ 0 };  // Log file this site was last written to
+                std::uint32_t              id = 0;
+            };
+
+            // Null when the level is filtered or no log is open; otherwise room for
+            // payloadBytes, owned by the calling thread until EndRecord
+            std::uint8_t* BeginRecord(Site& site,
+                                      const char* fmt,
+                                      const BinaryLogArg* types,
+                                      std::size_t count,
+                                      std::size_t payloadBytes);
+            void EndRecord();
+
+            template <typename T>
+            constexpr BinaryLogArg ArgOf()
+            {
+                using U = std::remove_cv_t<std::remove_reference_t<T>>;
+                if constexpr (std::is_same_v<U, bool>)
+                    return BinaryLogArg::UInt;
+                else if constexpr (std::is_enum_v<U>)
+                    return std::is_signed_v<std::underlying_type_t<U>> ? BinaryLogArg::Int : BinaryLogArg::UInt;
+                else if constexpr (std::is_integral_v<U>)
+                    return std::is_signed_v<U> ? BinaryLogArg::Int : BinaryLogArg::UInt;
+                else if constexpr (std::is_floating_point_v<U>)
+                    return BinaryLogArg::Double;
+                else if constexpr (std::is_same_v<std::decay_t<U>, const char*> || std::is_same_v<std::decay_t<U>, char*>)
+                    return BinaryLogArg::String;
+                else if constexpr (std::is_pointer_v<std::decay_t<U>> || std::is_null_pointer_v<U>)
+                    return BinaryLogArg::Pointer;
+                else
+                    static_assert(sizeof(U) == 0, "Deferred log arguments must be numbers, enums, strings or pointers");
+            }
+
+            inline std::size_t StringBytes(const char* text)
+            {
+                const std::size_t length = text ? std::strlen(text) : 0;
+                return length < kMaxBinaryLogString ? length : kMaxBinaryLogString;
+            }
+
+            template <typename T>
+            std::size_t PayloadBytes(const T& value)
+            {
+                if constexpr (ArgOf<T>() == BinaryLogArg::String)
+                    return sizeof(std::uint16_t) + StringBytes(value);
+                else
+                    return sizeof(std::uint64_t);
+            }
+
+            template <typename T>
+            std::uint8_t* Encode(std::uint8_t* out, const T& value)
+            {
+                constexpr BinaryLogArg type = ArgOf<T>();
+                if constexpr (type == BinaryLogArg::String) {
+                    const auto length = static_cast<std::uint16_t>(StringBytes(value));
+                    std::memcpy(out, &length, sizeof(length));
+                    if (length > 0)
+                        std::memcpy(out + sizeof(length), value, length);
+                    return out + sizeof(length) + length;
+                }
+                else {
+                    std::uint64_t bits = 0;
+                    if constexpr (type == BinaryLogArg::Double) {
+                        const double widened = static_cast<double>(value);
+                        std::memcpy(&bits, &widened, sizeof(bits));
+                    }
+                    else if constexpr (type == BinaryLogArg::Pointer) {
+                        bits = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(static_cast<const void*>(value)));
+                    }
+                    else if constexpr (type == BinaryLogArg::Int) {
+                        bits = static_cast<std::uint64_t>(static_cast<std::int64_t>(value));
+                    }
+                    else {
+                        bits = static_cast<std::uint64_t>(value);
+                    }
+                    std::memcpy(out, &bits, sizeof(bits));
+                    return out + sizeof(bits);
+                }
+            }
+
+            // False while no log is open; KBK_LOG_DEFERRED then logs the message as text
+            template <typename... Args>
+            bool Write(Site& site, const char* fmt, const Args&... args)
+            {
+                if (!IsOpen())
+                    return false;
+
+                static constexpr std::array<BinaryLogArg, sizeof...(Args)> kTypes{ ArgOf<Args>()... };
+                const std::size_t payload = (std::size_t{ 0 } + ... + PayloadBytes(args));
+
+                std::uint8_t* out = BeginRecord(site, fmt, kTypes.data(), kTypes.size(), payload);
+                if (!out)
+                    return true;
+                ((out = Encode(out, args)), ...);
+                KBK_UNUSED(out);
+                EndRecord();
+                return true;
+            }
+        } // namespace Detail
+
+    } // namespace BinaryLog
+
+} // namespace KibakoEngine
+
+// The level and format string must be constants; the format is stored once per call site, not per call.
+// Filtered calls never evaluate their arguments.
+#define KBK_LOG_DEFERRED(level, channel, ...)                                                                   \
+    do {                                                                                                        \
+        if constexpr (::KibakoEngine::Detail::CompiledIn(level)) {                                              \
+            if (::KibakoEngine::BinaryLog::Detail::ShouldRecord((level), (channel))) {                          \
+                static ::KibakoEngine::BinaryLog::Detail::Site _kbkLogSite{ (level), (channel), __FILE__,       \
+                                                                            __LINE__, __func__ };               \
+                if (!::KibakoEngine::BinaryLog::Detail::Write(_kbkLogSite, __VA_ARGS__))                        \
+                    ::KibakoEngine::LogMessage((level), (channel), __FILE__, __LINE__, __func__, __VA_ARGS__);   \
+            }                                                                                                   \
+        }                                                                                                       \
+    } while (0)
+
+#define KbkTraceDeferred(channel, ...) KBK_LOG_DEFERRED(::KibakoEngine::LogLevel::Trace, (channel), __VA_ARGS__)
+#define KbkLogDeferred(channel, ...)   KBK_LOG_DEFERRED(::KibakoEngine::LogLevel::Info, (channel), __VA_ARGS__)
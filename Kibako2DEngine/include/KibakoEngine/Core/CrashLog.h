@@ -0,0 +1,67 @@
+// In-memory ring of recent log messages, written out when the process crashes
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "KibakoEngine/Core/Log.h"
+
+namespace KibakoEngine {
+
+    struct CrashLogConfig
+    {
+        std::uint32_t capacity = 4096;                // Messages kept, rounded up to a power of two; ~256 bytes each
+        LogLevel      minimumLevel = LogLevel::Trace; // Captured even when the console and sinks filter it
+        std::string   path = "kibako_crash.log";      // Rewritten by every dump
+        bool          dumpOnBreakpoint = true;        // Messages at LogConfig::debuggerBreakLevel and RequestBreakpoint
+        bool          installHandlers = true;         // Fatal signals, std::terminate and, on Windows, unhandled exceptions
+    };
+
+    namespace CrashLog {
+
+        // Every message at or above minimumLevel is copied into the ring, including ones
+        // the output filters reject; those are formatted into the ring and go no further.
+        // Handlers stay installed after Disable and chain to the ones they replaced.
+        bool Enable(const CrashLogConfig& config = {});
+        void Disable();
+        [[nodiscard]] bool IsEnabled();
+
+        // Writes the ring, oldest message first, to the configured path. Takes no lock
+        // and allocates nothing, so it is safe from a signal handler; messages being
+        // written while it runs are skipped.
+        bool Dump(const char* reason);
+
+        // Run once by the fatal handlers before the dump, so other buffered output can be
+        // written out; they must be as careful as Dump. Callbacks cannot be removed, and
+        // AddCrashCallback fails once kMaxCrashCallbacks are registered.
+        using CrashCallback = void (*)();
+        inline constexpr std::size_t kMaxCrashCallbacks = 4;
+        bool AddCrashCallback(CrashCallback callback);
+
+        namespace Detail
+        {
+            // Text room of one ring slot, the terminator included
+            inline constexpr std::size_t kCrashTextSize = 192;
+
+            // Null when nothing is captured at this level; otherwise a slot whose text the
+            // calling thread fills (up to kCrashTextSize bytes, terminated) before EndCapture
+            char* BeginCapture(LogLevel level, const char* channel, const char* file, int line, const char* function);
+            void EndCapture();
+
+            // Copy of an already formatted message
+            void Capture(LogLevel level,
+                         const char* channel,
+                         const char* file,
+                         int line,
+                         const char* function,
+                         const char* text,
+                         std::size_t length);
+
+            // Called by the logger when a message or RequestBreakpoint reaches the break level
+            void OnBreakpoint(const char* reason);
+        } // namespace Detail
+
+    } // namespace CrashLog
+
+} // namespace KibakoEngine
@@ -33,6 +33,9 @@ namespace KibakoEngine::Debug {
 
 #define KBK_UNUSED(x) ((void)(x))
 
+#define KBK_CONCAT_INNER(a, b) a##b
+#define KBK_CONCAT(a, b) KBK_CONCAT_INNER(a, b)
+
 #if KBK_DEBUG_BUILD
 #    define KBK_ASSERT(condition, message)                                                                   \
         do {                                                                                                 \
@@ -2,26 +2,28 @@
 #pragma once
 
 #include <SDL2/SDL.h>
-#include <cstdint>
 
 #include "KibakoEngine/Core/Debug.h"
 
 struct ID3D11Device;
 struct ID3D11DeviceContext;
 
+// The ImGui overlay needs the D3D11 backend
+#if !defined(KBK_ENABLE_DEBUG_UI)
+#    if KBK_DEBUG_BUILD && defined(_WIN32)
+#        define KBK_ENABLE_DEBUG_UI 1
+#    else
+#        define KBK_ENABLE_DEBUG_UI 0
+#    endif
+#endif
+
 namespace KibakoEngine {
 
     namespace DebugUI
     {
-        struct RenderStats
-        {
-            std::uint32_t drawCalls = 0;
-            std::uint32_t spritesSubmitted = 0;
-        };
-
         using PanelCallback = void (*)(void* userData);
 
-#if KBK_DEBUG_BUILD
+#if KBK_ENABLE_DEBUG_UI
         void Init(SDL_Window* window, ID3D11Device* device, ID3D11DeviceContext* context);
         void Shutdown();
 
@@ -36,9 +38,6 @@ namespace KibakoEngine {
         void SetVSyncEnabled(bool enabled);
         [[nodiscard]] bool IsVSyncEnabled();
 
-        void SetRenderStats(const RenderStats& stats);
-        [[nodiscard]] RenderStats GetRenderStats();
-
         // Register an external scene inspector panel
         void SetSceneInspector(void* userData, PanelCallback callback);
 #else
@@ -82,16 +81,6 @@ namespace KibakoEngine {
             return false;
         }
 
-        inline void SetRenderStats(const RenderStats& stats)
-        {
-            KBK_UNUSED(stats);
-        }
-
-        [[nodiscard]] inline RenderStats GetRenderStats()
-        {
-            return {};
-        }
-
         inline void SetSceneInspector(void* userData, PanelCallback callback)
         {
             KBK_UNUSED(userData);
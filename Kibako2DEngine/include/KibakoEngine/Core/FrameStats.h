@@ -0,0 +1,109 @@
+// Rolling frame-time statistics with per-phase breakdown
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace KibakoEngine {
+
+    enum class FramePhase : std::uint8_t {
+        Events,
+        Update,
+        Render,
+        Present,
+        Count
+    };
+
+    inline constexpr std::size_t kFramePhaseCount = static_cast<std::size_t>(FramePhase::Count);
+
+    [[nodiscard]] const char* FramePhaseName(FramePhase phase);
+
+    struct FrameSample {
+        std::uint64_t frame = 0;
+        double        frameMs = 0.0;                     // BeginFrame to the next BeginFrame
+        double        phaseMs[kFramePhaseCount] = {};
+        bool          hitch = false;
+    };
+
+    struct FrameTimeStats {
+        double avgMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    struct FrameStatsSummary {
+        std::uint32_t  frames = 0;                      // Samples in the window
+        FrameTimeStats frame;
+        FrameTimeStats phases[kFramePhaseCount];
+        std::uint64_t  hitchesInWindow = 0;
+        std::uint64_t  totalHitches = 0;
+        std::uint64_t  totalFrames = 0;
+    };
+
+    class FrameStats {
+    public:
+        static constexpr std::size_t kDefaultWindow = 600;
+        static constexpr double      kDefaultHitchMs = 33.3;
+
+        // Accumulates into a phase until destroyed; phases may repeat within a frame
+        class PhaseScope {
+        public:
+            PhaseScope(FrameStats& stats, FramePhase phase);
+            ~PhaseScope();
+
+            PhaseScope(const PhaseScope&) = delete;
+            PhaseScope& operator=(const PhaseScope&) = delete;
+
+        private:
+            FrameStats&                           m_stats;
+            FramePhase                            m_phase;
+            std::chrono::steady_clock::time_point m_start;
+        };
+
+        // Closes the previous frame, if any, and starts timing a new one
+        void BeginFrame();
+        // Closes the open frame when no next one will
+        void EndFrame();
+        void AddPhaseTime(FramePhase phase, double ms);
+
+        // Drops the samples; the totals survive
+        void SetWindowSize(std::size_t frames);
+        [[nodiscard]] std::size_t WindowSize() const { return m_window; }
+
+        // Frames longer than this are counted and logged as hitches
+        void SetHitchThresholdMs(double ms) { m_hitchMs = ms; }
+        [[nodiscard]] double HitchThresholdMs() const { return m_hitchMs; }
+
+        [[nodiscard]] FrameStatsSummary Summary() const;
+        // Oldest first
+        [[nodiscard]] std::vector<FrameSample> Samples() const;
+        [[nodiscard]] const FrameSample* LastFrame() const;
+
+        // One row per sample in the window, oldest first
+        bool ExportCSV(const std::string& path) const;
+        void LogSummary() const;
+
+        void Reset();
+
+    private:
+        void CloseFrame(std::chrono::steady_clock::time_point now);
+
+        std::vector<FrameSample> m_samples;              // Ring of up to m_window samples
+        std::size_t              m_window = kDefaultWindow;
+        std::size_t              m_next = 0;
+        double                   m_hitchMs = kDefaultHitchMs;
+
+        FrameSample                           m_current{};
+        std::chrono::steady_clock::time_point m_frameStart{};
+        bool                                  m_frameOpen = false;
+
+        std::uint64_t m_totalFrames = 0;
+        std::uint64_t m_totalHitches = 0;
+    };
+
+} // namespace KibakoEngine
@@ -7,6 +7,20 @@
 
 namespace KibakoEngine {
 
+    // Everything the queries below read, as of the end of event handling
+    struct InputSnapshot {
+        std::array<uint8_t, SDL_NUM_SCANCODES> keys{};
+        // Press events seen this frame, kept even when the release came in the same frame
+        std::array<uint8_t, SDL_NUM_SCANCODES> keysPressed{};
+        int      mouseX = 0;
+        int      mouseY = 0;
+        int      wheelX = 0;
+        int      wheelY = 0;
+        uint32_t mouseButtons = 0;
+        uint32_t mousePressed = 0;
+        uint32_t textChar = 0;
+    };
+
     class Input {
     public:
         Input();
@@ -28,9 +42,18 @@ namespace KibakoEngine {
 
         [[nodiscard]] uint32_t TextChar() const { return m_textChar; }
 
+        void Capture(InputSnapshot& out) const;
+        // Replaces this frame's state; the keyboard stops following SDL until StopOverride
+        void Override(const InputSnapshot& snapshot);
+        void StopOverride();
+        [[nodiscard]] bool IsOverridden() const { return m_overridden; }
+
     private:
         const uint8_t* m_keyboard = nullptr;
+        std::array<uint8_t, SDL_NUM_SCANCODES> m_overrideKeyboard{};
+        bool m_overridden = false;
         std::array<uint8_t, SDL_NUM_SCANCODES> m_prevKeyboard{};
+        std::array<uint8_t, SDL_NUM_SCANCODES> m_keysPressed{};
 
         int      m_mouseX = 0;
         int      m_mouseY = 0;
@@ -38,6 +61,7 @@ namespace KibakoEngine {
         int      m_wheelY = 0;
         uint32_t m_mouseButtons = 0;
         uint32_t m_prevMouseButtons = 0;
+        uint32_t m_mousePressed = 0;
 
         uint32_t m_textChar = 0;
     };
@@ -1,10 +1,40 @@
 // Logging and breakpoint helpers
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstdarg>
+#include <cstddef>
 #include <cstdint>
+#include <initializer_list>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 
+#include "KibakoEngine/Core/LogFormat.h"
+
+#if defined(_MSC_VER)
+#    include <sal.h>
+#endif
+
+// Calls below this level compile to nothing: 0 Trace, 1 Info, 2 Warning, 3 Error, 4 Critical
+#if !defined(KBK_LOG_MIN_LEVEL)
+#    define KBK_LOG_MIN_LEVEL 0
+#endif
+
+// printf formats checked against their arguments: by GCC and Clang at compile time,
+// by MSVC under /analyze
+#if defined(__GNUC__) || defined(__clang__)
+#    define KBK_PRINTF_FORMAT(formatIndex, firstArgIndex) __attribute__((format(printf, formatIndex, firstArgIndex)))
+#else
+#    define KBK_PRINTF_FORMAT(formatIndex, firstArgIndex)
+#endif
+#if defined(_MSC_VER)
+#    define KBK_PRINTF_FORMAT_STRING _Printf_format_string_
+#else
+#    define KBK_PRINTF_FORMAT_STRING
+#endif
+
 namespace KibakoEngine {
 
     enum class LogLevel : std::uint8_t
@@ -22,11 +52,105 @@ namespace KibakoEngine {
         LogLevel debuggerBreakLevel = LogLevel::Error;
         bool breakIntoDebugger = true;
         bool haltRenderingOnBreak = true;
+        // Consecutive identical messages from one call site print once, then a
+        // "last message repeated N times" line; off by default so every line is kept
+        bool collapseRepeats = false;
     };
 
     void SetLogConfig(const LogConfig& config);
     LogConfig GetLogConfig();
 
+    // "TRACE", "INFO", "WARN", "ERROR" or "CRITICAL", as printed in the line prefix
+    [[nodiscard]] const char* LogLevelName(LogLevel level);
+
+    // Per-channel minimum levels, e.g. "Scene2D" at Warning while everything else logs
+    // Trace. Channels without one use LogConfig::minimumLevel. Levels are matched by
+    // the full channel name, however long.
+    void SetLogChannelLevel(const char* channel, LogLevel level);
+    void ClearLogChannelLevel(const char* channel);
+    void ClearLogChannelLevels();
+    [[nodiscard]] LogLevel GetLogChannelLevel(const char* channel);
+
+    // Accepts level names as printed ("trace", "info", "warn", "error", "critical"), any case
+    bool ParseLogLevel(const char* text, LogLevel& out);
+
+    enum class LogOverflowPolicy : std::uint8_t
+    {
+        Block,  // Callers wait for the writer thread
+        Drop,   // New messages are discarded and counted
+        Sample  // Past 3/4 full, one Trace/Info message in sampleEvery is kept; Warning waits
+    };
+
+    struct AsyncLogConfig
+    {
+        std::uint32_t     capacity = 4096;       // Queued messages, rounded up to a power of two
+        LogOverflowPolicy overflow = LogOverflowPolicy::Block;
+        std::uint32_t     sampleEvery = 16;
+        std::uint32_t     flushIntervalMs = 50;  // Longest a queued message waits to be written
+    };
+
+    // Callers format the message into a queue slot and a writer thread adds the prefix,
+    // writes and flushes in batches. Errors, and any level that can break into the
+    // debugger, drain the queue and are then written synchronously, so order is kept.
+    bool StartAsyncLogging(const AsyncLogConfig& config = {});
+    // Drains the queue and joins the writer; also runs at exit and from std::terminate
+    void StopAsyncLogging();
+    [[nodiscard]] bool IsAsyncLogging();
+    // Blocks until every message queued so far has been written and sinks are flushed
+    void FlushLog();
+    [[nodiscard]] std::uint64_t DroppedLogMessages();
+
+    // One message as sinks see it; every pointer is valid only during the call
+    struct LogRecord
+    {
+        LogLevel     level = LogLevel::Info;
+        std::int64_t timeMs = 0;  // Wall clock, milliseconds since the epoch
+        const char*  channel = "";
+        const char*  file = nullptr;
+        int          line = 0;
+        const char*  function = nullptr;
+        const char*  message = "";
+        std::size_t  messageLength = 0;
+        // Structured fields as JSON members without the braces: "frame":12,"texture":"hero"
+        const char*  fields = "";
+        std::size_t  fieldsLength = 0;
+    };
+
+    // Receives every line after the console, prefix included and newline-terminated.
+    // Calls are serialized by the logger; a sink must not log from inside them.
+    class LogSink
+    {
+    public:
+        virtual ~LogSink() = default;
+
+        virtual void Write(LogLevel level, const char* line, std::size_t length) = 0;
+        // The same message before it was turned into a line, for sinks that want the parts
+        virtual void WriteRecord(const LogRecord&) {}
+        // After each async batch and at least every flush interval; sinks flush on their own schedule
+        virtual void Update() {}
+        // Everything written so far reaches its destination
+        virtual void Flush() = 0;
+    };
+
+    // Sinks are not owned and must be removed before they are destroyed
+    void AddLogSink(LogSink* sink);
+    void RemoveLogSink(LogSink* sink);
+
+    // Per call site state for the *Limited macros, declared static at the call site.
+    // Constant-initialized, so the check takes no lock, not even a static guard.
+    class LogRateLimit
+    {
+    public:
+        // True for the first maxPerSecond calls of each one-second window; suppressed
+        // receives how many calls were turned away since the last accepted one
+        bool Allow(std::uint32_t maxPerSecond, std::uint32_t& suppressed);
+
+    private:
+        std::atomic<std::int64_t>  m_windowStartMs{ 0 };
+        std::atomic<std::uint32_t> m_count{ 0 };
+        std::atomic<std::uint32_t> m_suppressed{ 0 };
+    };
+
     void RequestBreakpoint(const char* reason, LogLevel level = LogLevel::Error);
 
     bool HasBreakpointRequest();
@@ -38,18 +162,149 @@ namespace KibakoEngine {
                     const char* file,
                     int line,
                     const char* function,
-                    const char* fmt,
-                    ...);
+                    KBK_PRINTF_FORMAT_STRING const char* fmt,
+                    ...) KBK_PRINTF_FORMAT(6, 7);
     void LogMessageV(LogLevel level,
                      const char* channel,
                      const char* file,
                      int line,
                      const char* function,
                      const char* fmt,
-                     std::va_list args);
+                     std::va_list args) KBK_PRINTF_FORMAT(6, 0);
+
+    // {} messages; the format was checked against the arguments when the caller compiled
+    void LogFormatted(LogLevel level,
+                      const char* channel,
+                      const char* file,
+                      int line,
+                      const char* function,
+                      const char* fmt,
+                      const LogFormatArg* args,
+                      std::size_t count);
+
+    enum class LogFieldType : std::uint8_t
+    {
+        Int,     // Any signed integer or enum
+        UInt,    // Any unsigned integer
+        Double,
+        Bool,
+        String
+    };
+
+    // One typed key/value pair of a structured message. Built on the caller's stack;
+    // strings are referenced, not copied, so nothing is allocated.
+    struct LogField
+    {
+        template <typename T>
+        LogField(const char* fieldKey, const T& value)
+            : key(fieldKey)
+        {
+            using U = std::decay_t<T>;
+            if constexpr (std::is_same_v<U, bool>) {
+                type = LogFieldType::Bool;
+                u = value ? 1u : 0u;
+            }
+            else if constexpr (std::is_enum_v<U>) {
+                type = LogFieldType::Int;
+                i = static_cast<std::int64_t>(value);
+            }
+            else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+                type = LogFieldType::Int;
+                i = static_cast<std::int64_t>(value);
+            }
+            else if constexpr (std::is_integral_v<U>) {
+                type = LogFieldType::UInt;
+                u = static_cast<std::uint64_t>(value);
+            }
+            else if constexpr (std::is_floating_point_v<U>) {
+                type = LogFieldType::Double;
+                d = static_cast<double>(value);
+            }
+            else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+                const char* pointer = value;
+                type = LogFieldType::String;
+                text = pointer ? pointer : "";
+                length = pointer ? std::char_traits<char>::length(pointer) : 0;
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                const std::string_view view(value);
+                type = LogFieldType::String;
+                text = view.data();
+                length = view.size();
+            }
+            else {
+                static_assert(sizeof(U) == 0, "Log fields must be numbers, enums, bools or strings");
+            }
+        }
+
+        const char*  key;
+        LogFieldType type = LogFieldType::Int;
+        union
+        {
+            std::int64_t  i;
+            std::uint64_t u = 0;
+            double        d;
+            const char*   text;
+        };
+        std::size_t  length = 0;  // String fields
+    };
+
+    // Console lines read "message {"key":value,...}"; sinks get the fields apart in LogRecord
+    void LogFields(LogLevel level,
+                   const char* channel,
+                   const char* file,
+                   int line,
+                   const char* function,
+                   const char* message,
+                   std::initializer_list<LogField> fields);
 
     namespace Detail
     {
+        // Lowest level any channel lets through; one relaxed load rejects most filtered calls
+        inline std::atomic<std::uint8_t> g_logFloor{ 0 };
+        // Set while any channel has its own level
+        inline std::atomic<bool> g_logChannelOverrides{ false };
+        // Lowest level the crash log captures, kNoLogCapture while it is off
+        inline constexpr std::uint8_t kNoLogCapture = 0xFF;
+        inline std::atomic<std::uint8_t> g_logCaptureLevel{ kNoLogCapture };
+
+        // Lowers the floor so captured levels reach the logger even when no output takes them
+        void SetLogCaptureLevel(std::uint8_t level);
+
+        // Channel lookup for when overrides exist
+        bool ChannelAllows(LogLevel level, const char* channel);
+
+        inline constexpr int kCompiledLogLevel = KBK_LOG_MIN_LEVEL;
+
+        constexpr bool CompiledIn(LogLevel level)
+        {
+            return static_cast<int>(level) >= kCompiledLogLevel;
+        }
+
+        // Checked by the logging macros before any argument is evaluated
+        inline bool ShouldLog(LogLevel level, const char* channel)
+        {
+            const auto value = static_cast<std::uint8_t>(level);
+            if (value < g_logFloor.load(std::memory_order_relaxed))
+                return false;
+            if (value >= g_logCaptureLevel.load(std::memory_order_relaxed))
+                return true;
+            if (!g_logChannelOverrides.load(std::memory_order_relaxed))
+                return true;
+            return ChannelAllows(level, channel);
+        }
+
+        // "[HH:MM:SS.mmm][LEVEL][channel][file:line][function] "; returns the length written,
+        // 0 if formatting failed. Shared with tools that rebuild log lines offline.
+        std::size_t FormatLogPrefix(char* buffer,
+                                    std::size_t size,
+                                    LogLevel level,
+                                    std::int64_t timeMs,
+                                    const char* channel,
+                                    const char* file,
+                                    int line,
+                                    const char* function);
+
         struct LogMessageContext
         {
             LogLevel level;
@@ -59,18 +314,30 @@ namespace KibakoEngine {
             const char* function;
 
             template <typename... Args>
-            void operator()(const char* fmt, Args&&... args) const
+            void Format(LogFormat<Args...> fmt, const Args&... args) const
+            {
+                const std::array<LogFormatArg, sizeof...(Args)> packed{ LogFormatArg(args)... };
+                LogFormatted(level, channel, file, line, function, fmt.Text(), packed.data(), packed.size());
+            }
+
+            void Fields(const char* message, std::initializer_list<LogField> fields) const
             {
-                LogMessage(level,
-                           channel,
-                           file,
-                           line,
-                           function,
-                           fmt,
-                           std::forward<Args>(args)...);
+                LogFields(level, channel, file, line, function, message, fields);
             }
         };
 
+        // Appends text as a quoted JSON string, stopping early rather than overrun size
+        // or split an escape; returns the new offset
+        std::size_t AppendJsonString(char* buffer, std::size_t size, std::size_t offset, const char* text, std::size_t length);
+
+        // "N messages from this call site were suppressed", logged ahead of the next accepted one
+        void LogSuppressed(LogLevel level,
+                           const char* channel,
+                           const char* file,
+                           int line,
+                           const char* function,
+                           std::uint32_t count);
+
         inline LogMessageContext MakeLogMessageContext(LogLevel level,
                                                         const char* channel,
                                                         const char* file,
@@ -85,12 +352,62 @@ namespace KibakoEngine {
 
 #define KBK_LOG_CHANNEL_DEFAULT "Kibako"
 
+// Arguments are only evaluated for messages that pass both filters. LogMessage is called
+// directly so the compiler sees the literal format it checks the arguments against.
 #define KBK_LOG(level, channel, ...)                                                                           \
-    ::KibakoEngine::Detail::MakeLogMessageContext((level),                                                    \
-                                                  (channel),                                                  \
-                                                  __FILE__,                                                   \
-                                                  __LINE__,                                                   \
-                                                  __func__)(__VA_ARGS__)
+    ((::KibakoEngine::Detail::CompiledIn(level) && ::KibakoEngine::Detail::ShouldLog((level), (channel)))    \
+         ? ::KibakoEngine::LogMessage((level), (channel), __FILE__, __LINE__, __func__, __VA_ARGS__)          \
+         : static_cast<void>(0))
+
+// At most maxPerSecond lines per second from this call site, for messages that can
+// fire every frame; filtered calls never touch the limiter
+#define KBK_LOG_LIMITED(level, channel, maxPerSecond, ...)                                                     \
+    do {                                                                                                       \
+        static ::KibakoEngine::LogRateLimit _kbkRateLimit;                                                     \
+        std::uint32_t _kbkSuppressed = 0;                                                                      \
+        if (::KibakoEngine::Detail::CompiledIn(level) && ::KibakoEngine::Detail::ShouldLog((level), (channel)) \
+            && _kbkRateLimit.Allow((maxPerSecond), _kbkSuppressed)) {                                          \
+            if (_kbkSuppressed > 0)                                                                            \
+                ::KibakoEngine::Detail::LogSuppressed((level), (channel), __FILE__, __LINE__, __func__,        \
+                                                      _kbkSuppressed);                                         \
+            ::KibakoEngine::LogMessage((level), (channel), __FILE__, __LINE__, __func__, __VA_ARGS__);        \
+        }                                                                                                      \
+    } while (0)
+
+// Structured: KbkLogFields("Assets", "Texture loaded", { "texture", path }, { "duration_ms", ms });
+// filtered calls evaluate none of the fields
+#define KBK_LOG_FIELDS(level, channel, message, ...)                                                         \
+    ((::KibakoEngine::Detail::CompiledIn(level) && ::KibakoEngine::Detail::ShouldLog((level), (channel)))    \
+         ? ::KibakoEngine::Detail::MakeLogMessageContext((level),                                             \
+                                                         (channel),                                           \
+                                                         __FILE__,                                            \
+                                                         __LINE__,                                            \
+                                                         __func__)                                            \
+               .Fields((message), { __VA_ARGS__ })                                                            \
+         : static_cast<void>(0))
+
+#define KbkTraceFields(channel, message, ...) KBK_LOG_FIELDS(::KibakoEngine::LogLevel::Trace, (channel), (message), __VA_ARGS__)
+#define KbkLogFields(channel, message, ...)   KBK_LOG_FIELDS(::KibakoEngine::LogLevel::Info, (channel), (message), __VA_ARGS__)
+#define KbkWarnFields(channel, message, ...)  KBK_LOG_FIELDS(::KibakoEngine::LogLevel::Warning, (channel), (message), __VA_ARGS__)
+#define KbkErrorFields(channel, message, ...) KBK_LOG_FIELDS(::KibakoEngine::LogLevel::Error, (channel), (message), __VA_ARGS__)
+
+// {} placeholders checked against the arguments at compile time:
+// KbkLogFmt("Assets", "Loaded {} in {:.2} ms", path, ms); see LogFormat.h for the specs
+#define KBK_LOG_FORMAT(level, channel, ...)                                                                    \
+    ((::KibakoEngine::Detail::CompiledIn(level) && ::KibakoEngine::Detail::ShouldLog((level), (channel)))    \
+         ? ::KibakoEngine::Detail::MakeLogMessageContext((level),                                             \
+                                                         (channel),                                           \
+                                                         __FILE__,                                            \
+                                                         __LINE__,                                            \
+                                                         __func__)                                            \
+               .Format(__VA_ARGS__)                                                                           \
+         : static_cast<void>(0))
+
+#define KbkTraceFmt(channel, ...)    KBK_LOG_FORMAT(::KibakoEngine::LogLevel::Trace, (channel), __VA_ARGS__)
+#define KbkLogFmt(channel, ...)      KBK_LOG_FORMAT(::KibakoEngine::LogLevel::Info, (channel), __VA_ARGS__)
+#define KbkWarnFmt(channel, ...)     KBK_LOG_FORMAT(::KibakoEngine::LogLevel::Warning, (channel), __VA_ARGS__)
+#define KbkErrorFmt(channel, ...)    KBK_LOG_FORMAT(::KibakoEngine::LogLevel::Error, (channel), __VA_ARGS__)
+#define KbkCriticalFmt(channel, ...) KBK_LOG_FORMAT(::KibakoEngine::LogLevel::Critical, (channel), __VA_ARGS__)
 
 #define KbkTrace(channel, ...)   KBK_LOG(::KibakoEngine::LogLevel::Trace, (channel), __VA_ARGS__)
 #define KbkLog(channel, ...)     KBK_LOG(::KibakoEngine::LogLevel::Info, (channel), __VA_ARGS__)
@@ -99,6 +416,11 @@ namespace KibakoEngine {
 #define KbkCritical(channel, ...)                                                                              \
     KBK_LOG(::KibakoEngine::LogLevel::Critical, (channel), __VA_ARGS__)
 
+#define KbkWarnLimited(channel, maxPerSecond, ...)                                                             \
+    KBK_LOG_LIMITED(::KibakoEngine::LogLevel::Warning, (channel), (maxPerSecond), __VA_ARGS__)
+#define KbkErrorLimited(channel, maxPerSecond, ...)                                                            \
+    KBK_LOG_LIMITED(::KibakoEngine::LogLevel::Error, (channel), (maxPerSecond), __VA_ARGS__)
+
 #define KbkLogDefault(...)      KbkLog(KBK_LOG_CHANNEL_DEFAULT, __VA_ARGS__)
 #define KbkWarnDefault(...)     KbkWarn(KBK_LOG_CHANNEL_DEFAULT, __VA_ARGS__)
 #define KbkErrorDefault(...)    KbkError(KBK_LOG_CHANNEL_DEFAULT, __VA_ARGS__)
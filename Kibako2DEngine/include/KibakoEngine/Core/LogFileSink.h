@@ -0,0 +1,84 @@
+// Buffered log file with size and time rotation and a disk cap
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "KibakoEngine/Core/Log.h"
+
+namespace KibakoEngine {
+
+    enum class LogFileFormat : std::uint8_t
+    {
+        Text,       // Console lines, <baseName>.log
+        JsonLines   // One JSON object per message with fields inline, <baseName>.jsonl
+    };
+
+    struct LogFileConfig
+    {
+        std::string   directory = "logs";
+        std::string   baseName = "kibako";
+        LogFileFormat format = LogFileFormat::Text;
+        std::size_t   bufferBytes = 256 * 1024;
+        std::uint64_t maxFileBytes = 16ull << 20;      // 0 disables size rotation
+        std::uint32_t rotateIntervalMinutes = 0;       // 0 disables time rotation
+        std::uint64_t maxTotalBytes = 256ull << 20;    // Oldest rotated files are deleted past this; 0 keeps all
+        std::uint32_t flushIntervalMs = 1000;          // Error and Critical lines flush at once
+    };
+
+    // Lines collect in one buffer and reach the file in large writes. A full or
+    // expired file is renamed to <baseName>-YYYYMMDD-HHMMSS with its extension and a
+    // new one started. Open first, then AddLogSink; with the async logger running,
+    // formatting and writing happen on its thread. Otherwise a quiet log flushes at
+    // its next line or at FlushLog().
+    class RotatingFileSink final : public LogSink
+    {
+    public:
+        RotatingFileSink() = default;
+        ~RotatingFileSink() override;
+
+        RotatingFileSink(const RotatingFileSink&) = delete;
+        RotatingFileSink& operator=(const RotatingFileSink&) = delete;
+
+        // A log left by an earlier run is rotated away first
+        bool Open(const LogFileConfig& config = {});
+        // Removes the sink from the logger, then flushes and closes the file
+        void Close();
+
+        [[nodiscard]] bool IsOpen() const { return m_file != nullptr; }
+        [[nodiscard]] std::uint32_t RotationCount() const { return m_rotations; }
+
+        void Write(LogLevel level, const char* line, std::size_t length) override;
+        void WriteRecord(const LogRecord& record) override;
+        void Update() override;
+        void Flush() override;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void Append(LogLevel level, const char* data, std::size_t length);
+        [[nodiscard]] const char* Extension() const;
+        bool OpenActiveFile();
+        void Rotate();
+        bool RenameActiveFile();
+        void EnforceDiskCap();
+        void WriteBuffer();
+
+        LogFileConfig     m_config{};
+        std::string       m_activePath;
+        std::FILE*        m_file = nullptr;
+        std::vector<char> m_buffer;
+        std::size_t       m_used = 0;
+        std::uint64_t     m_fileBytes = 0;  // Written plus buffered
+        Clock::time_point m_openedAt{};
+        Clock::time_point m_lastFlush{};
+        std::uint32_t     m_rotations = 0;
+        std::string       m_lastStem;       // Rotated name of the last rotation, before its suffix
+        int               m_lastSuffix = 0;
+    };
+
+} // namespace KibakoEngine
@@ -0,0 +1,231 @@
+// Type-checked {} formatting for log messages
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace KibakoEngine {
+
+    enum class LogArgType : std::uint8_t
+    {
+        Int,      // Signed integers and enums
+        UInt,     // Unsigned integers
+        Double,
+        Bool,
+        Char,
+        String,
+        Pointer
+    };
+
+    namespace Detail
+    {
+        template <typename T>
+        constexpr LogArgType LogArgTypeOf()
+        {
+            using U = std::remove_cv_t<std::remove_reference_t<T>>;
+            using D = std::decay_t<U>;
+            if constexpr (std::is_same_v<U, bool>)
+                return LogArgType::Bool;
+            else if constexpr (std::is_same_v<U, char>)
+                return LogArgType::Char;
+            else if constexpr (std::is_enum_v<U>)
+                return LogArgType::Int;
+            else if constexpr (std::is_integral_v<U>)
+                return std::is_signed_v<U> ? LogArgType::Int : LogArgType::UInt;
+            else if constexpr (std::is_floating_point_v<U>)
+                return LogArgType::Double;
+            else if constexpr (std::is_same_v<D, const char*> || std::is_same_v<D, char*>)
+                return LogArgType::String;
+            else if constexpr (std::is_pointer_v<D> || std::is_null_pointer_v<U>)
+                return LogArgType::Pointer;
+            else if constexpr (std::is_convertible_v<const U&, std::string_view>)
+                return LogArgType::String;
+            else
+                static_assert(sizeof(U) == 0, "Log arguments must be numbers, enums, bools, chars, strings or pointers");
+        }
+    } // namespace Detail
+
+    // One argument of a {} message, built on the caller's stack; strings are referenced, not copied
+    struct LogFormatArg
+    {
+        template <typename T>
+        LogFormatArg(const T& value)
+        {
+            type = Detail::LogArgTypeOf<T>();
+            if constexpr (std::is_same_v<T, bool>) {
+                u = value ? 1u : 0u;
+            }
+            else if constexpr (std::is_same_v<T, char>) {
+                u = static_cast<unsigned char>(value);
+            }
+            else if constexpr (std::is_enum_v<T>) {
+                i = static_cast<std::int64_t>(value);
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                i = static_cast<std::int64_t>(value);
+            }
+            else if constexpr (std::is_integral_v<T>) {
+                u = static_cast<std::uint64_t>(value);
+            }
+            else if constexpr (std::is_floating_point_v<T>) {
+                d = static_cast<double>(value);
+            }
+            else if constexpr (std::is_same_v<std::decay_t<T>, const char*> || std::is_same_v<std::decay_t<T>, char*>) {
+                const char* chars = value;
+                text = chars ? chars : "(null)";
+                length = std::char_traits<char>::length(text);
+            }
+            else if constexpr (std::is_null_pointer_v<T>) {
+                pointer = nullptr;
+            }
+            else if constexpr (std::is_pointer_v<std::decay_t<T>>) {
+                pointer = static_cast<const void*>(value);
+            }
+            else {
+                const std::string_view view(value);
+                text = view.data();
+                length = view.size();
+            }
+        }
+
+        LogArgType type = LogArgType::Int;
+        union
+        {
+            std::int64_t  i;
+            std::uint64_t u = 0;
+            double        d;
+            const char*   text;
+            const void*   pointer;
+        };
+        std::size_t length = 0;  // Strings
+    };
+
+    namespace Detail
+    {
+        // Not constexpr: reaching it ends constant evaluation, so a bad format fails the
+        // build with the problem quoted in the diagnostic
+        void LogFormatError(const char* problem);
+
+        constexpr bool IsDigit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        // Placeholders are {} or {:spec}, spec being [0][width][.precision][type]:
+        //   width      minimum characters; numbers align right, the rest left; 0 pads numbers with zeros
+        //   precision  digits after the point for doubles (like %.3f), maximum characters for strings
+        //   type       x or X for integers; f, e or g for doubles
+        // {{ and }} print a brace. Positional arguments are not supported.
+        constexpr void CheckLogFormat(std::string_view text, const LogArgType* types, std::size_t count)
+        {
+            std::size_t next = 0;
+            for (std::size_t i = 0; i < text.size(); ++i) {
+                const char c = text[i];
+                if (c == '}') {
+                    if (i + 1 < text.size() && text[i + 1] == '}') {
+                        ++i;
+                        continue;
+                    }
+                    LogFormatError("unmatched '}' in log format; write }} for a brace");
+                }
+                if (c != '{')
+                    continue;
+                if (i + 1 < text.size() && text[i + 1] == '{') {
+                    ++i;
+                    continue;
+                }
+
+                ++i;
+                if (next >= count)
+                    LogFormatError("more {} placeholders than log arguments");
+                const LogArgType type = types[next++];
+
+                if (i < text.size() && text[i] == ':') {
+                    ++i;
+                    if (i < text.size() && text[i] == '0') {
+                        if (type == LogArgType::String || type == LogArgType::Char || type == LogArgType::Bool)
+                            LogFormatError("zero padding needs a number");
+                        ++i;
+                    }
+                    int width = 0;
+                    while (i < text.size() && IsDigit(text[i]))
+                        width = width * 10 + (text[i++] - '0');
+                    if (width > 64)
+                        LogFormatError("log format width above 64");
+
+                    if (i < text.size() && text[i] == '.') {
+                        ++i;
+                        if (i >= text.size() || !IsDigit(text[i]))
+                            LogFormatError("'.' in a log format needs a precision");
+                        int precision = 0;
+                        while (i < text.size() && IsDigit(text[i]))
+                            precision = precision * 10 + (text[i++] - '0');
+                        if (type != LogArgType::Double && type != LogArgType::String)
+                            LogFormatError("precision needs a double or a string");
+                        if (type == LogArgType::Double && precision > 17)
+                            LogFormatError("double precision above 17");
+                    }
+
+                    if (i < text.size() && text[i] != '}') {
+                        const char spec = text[i++];
+                        if (spec == 'x' || spec == 'X') {
+                            if (type != LogArgType::Int && type != LogArgType::UInt)
+                                LogFormatError("'x' needs an integer");
+                        }
+                        else if (spec == 'f' || spec == 'e' || spec == 'g') {
+                            if (type != LogArgType::Double)
+                                LogFormatError("'f', 'e' and 'g' need a double");
+                        }
+                        else {
+                            LogFormatError("unknown log format type; use x, X, f, e or g");
+                        }
+                    }
+                }
+
+                if (i >= text.size() || text[i] != '}')
+                    LogFormatError("log placeholder not closed by '}' (positional arguments are not supported)");
+            }
+
+            if (next != count)
+                LogFormatError("more log arguments than {} placeholders");
+        }
+    } // namespace Detail
+
+    // Only constructible from a string literal, which is checked at compile time against
+    // the argument types: a miscount or a spec that does not fit its argument fails the build
+    template <typename... Args>
+    class BasicLogFormat
+    {
+    public:
+        template <std::size_t N>
+        consteval BasicLogFormat(const char (&text)[N])
+            : m_text(text)
+        {
+            constexpr std::array<LogArgType, sizeof...(Args)> kTypes{ Detail::LogArgTypeOf<Args>()... };
+            Detail::CheckLogFormat(std::string_view(text, N - 1), kTypes.data(), kTypes.size());
+        }
+
+        [[nodiscard]] constexpr const char* Text() const { return m_text; }
+
+    private:
+        const char* m_text;
+    };
+
+    // Keeps the format out of argument deduction, so Args come from the arguments alone
+    template <typename... Args>
+    using LogFormat = BasicLogFormat<std::type_identity_t<Args>...>;
+
+    // Writes at most size - 1 characters and a terminator; returns the length written
+    std::size_t FormatLogArgs(char* out, std::size_t size, const char* fmt, const LogFormatArg* args, std::size_t count);
+
+    template <typename... Args>
+    std::size_t FormatLog(char* out, std::size_t size, LogFormat<Args...> fmt, const Args&... args)
+    {
+        const std::array<LogFormatArg, sizeof...(Args)> packed{ LogFormatArg(args)... };
+        return FormatLogArgs(out, size, fmt.Text(), packed.data(), packed.size());
+    }
+
+} // namespace KibakoEngine
@@ -0,0 +1,86 @@
+// Heap allocation tracking per subsystem tag
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "KibakoEngine/Core/Debug.h"
+
+// Replaces the global operator new/delete; every block carries a 16 byte header
+#if !defined(KBK_ENABLE_MEMORY_TRACKING)
+#    define KBK_ENABLE_MEMORY_TRACKING KBK_DEBUG_BUILD
+#endif
+
+namespace KibakoEngine {
+
+    enum class MemoryTag : std::uint8_t
+    {
+        General,
+        Renderer,
+        SpriteBatch,
+        Texture,
+        Font,
+        UI,
+        Scene,
+        Assets,
+        Profiler,
+        Count
+    };
+
+    inline constexpr std::size_t kMemoryTagCount = static_cast<std::size_t>(MemoryTag::Count);
+
+    [[nodiscard]] const char* MemoryTagName(MemoryTag tag);
+
+    struct MemoryTagStats
+    {
+        std::int64_t  liveBytes = 0;
+        std::int64_t  peakBytes = 0;
+        std::int64_t  liveAllocations = 0;
+        std::uint64_t totalAllocations = 0;
+        // Last completed frame
+        std::uint64_t frameAllocations = 0;
+        std::uint64_t frameBytes = 0;
+    };
+
+    namespace MemoryTracker {
+
+        [[nodiscard]] constexpr bool IsEnabled() { return KBK_ENABLE_MEMORY_TRACKING != 0; }
+
+        // Moves the running per-frame counters into the "last frame" slots
+        void BeginFrame();
+
+        [[nodiscard]] MemoryTagStats Stats(MemoryTag tag);
+        void LogSummary();
+
+        // Allocations on this thread are charged to the innermost tag; frees go back to the allocating tag
+        [[nodiscard]] MemoryTag CurrentTag();
+
+        class TagScope
+        {
+        public:
+#if KBK_ENABLE_MEMORY_TRACKING
+            explicit TagScope(MemoryTag tag);
+            ~TagScope();
+#else
+            explicit TagScope(MemoryTag) {}
+#endif
+
+            TagScope(const TagScope&) = delete;
+            TagScope& operator=(const TagScope&) = delete;
+
+#if KBK_ENABLE_MEMORY_TRACKING
+        private:
+            MemoryTag m_previous;
+#endif
+        };
+
+    } // namespace MemoryTracker
+
+} // namespace KibakoEngine
+
+#if KBK_ENABLE_MEMORY_TRACKING
+#    define KBK_MEMORY_TAG(tag) \
+        ::KibakoEngine::MemoryTracker::TagScope KBK_CONCAT(_kbkMemoryTag, __LINE__)(::KibakoEngine::MemoryTag::tag)
+#else
+#    define KBK_MEMORY_TAG(tag) ((void)0)
+#endif
@@ -0,0 +1,101 @@
+// Named per-frame performance counters shared by every subsystem
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "KibakoEngine/Core/Debug.h"
+
+namespace KibakoEngine {
+
+    enum class PerfCounterUnit : std::uint8_t
+    {
+        Count,
+        Bytes,
+        Nanoseconds
+    };
+
+    [[nodiscard]] const char* PerfCounterUnitName(PerfCounterUnit unit);
+
+    using PerfCounterId = std::uint16_t;
+
+    struct PerfCounterValue
+    {
+        std::string     name;
+        PerfCounterUnit unit = PerfCounterUnit::Count;
+        std::uint64_t   frameValue = 0;  // Last completed frame
+        std::uint64_t   total = 0;       // Since startup
+    };
+
+    namespace PerfCounters {
+
+        inline constexpr std::size_t kMaxCounters = 128;
+
+        // Same name returns the same id; registering past kMaxCounters returns the overflow counter
+        [[nodiscard]] PerfCounterId Register(std::string_view name, PerfCounterUnit unit = PerfCounterUnit::Count);
+
+        // Lock-free: each thread accumulates into its own block, read at BeginFrame
+        void Add(PerfCounterId id, std::uint64_t value);
+
+        // Snapshots the frame that just ended and appends it to the JSON lines file, if open.
+        // Work published concurrently by other threads lands in whichever frame sees it first.
+        void BeginFrame();
+
+        [[nodiscard]] std::uint64_t FrameIndex();
+        [[nodiscard]] std::uint64_t FrameValue(PerfCounterId id);
+        // Registration order, which is stable for the run
+        void GetSnapshot(std::vector<PerfCounterValue>& out);
+
+        // One {"frame":N,"counters":{...}} object per line for each snapshot
+        bool OpenJsonLines(const std::string& path);
+        void CloseJsonLines();
+
+        void LogSummary();
+
+        // Adds the elapsed time to a Nanoseconds counter
+        class ScopedTimer
+        {
+        public:
+            explicit ScopedTimer(PerfCounterId id)
+                : m_id(id)
+                , m_start(std::chrono::steady_clock::now())
+            {
+            }
+
+            ~ScopedTimer()
+            {
+                const auto elapsed = std::chrono::steady_clock::now() - m_start;
+                Add(m_id, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            }
+
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        private:
+            PerfCounterId                         m_id;
+            std::chrono::steady_clock::time_point m_start;
+        };
+
+    } // namespace PerfCounters
+
+} // namespace KibakoEngine
+
+// Call sites register once through a function-local static, then only pay for the add
+#define KBK_PERF_COUNTER_ADD_UNIT(name, unit, value)                                                             \
+    do {                                                                                                         \
+        static const ::KibakoEngine::PerfCounterId _kbkCounterId =                                               \
+            ::KibakoEngine::PerfCounters::Register(name, ::KibakoEngine::PerfCounterUnit::unit);                 \
+        ::KibakoEngine::PerfCounters::Add(_kbkCounterId, static_cast<std::uint64_t>(value));                     \
+    } while (0)
+
+#define KBK_PERF_COUNT(name, value) KBK_PERF_COUNTER_ADD_UNIT(name, Count, value)
+#define KBK_PERF_BYTES(name, value) KBK_PERF_COUNTER_ADD_UNIT(name, Bytes, value)
+
+#define KBK_PERF_TIME_SCOPE(name)                                                                                \
+    static const ::KibakoEngine::PerfCounterId KBK_CONCAT(_kbkTimerId, __LINE__) =                               \
+        ::KibakoEngine::PerfCounters::Register(name, ::KibakoEngine::PerfCounterUnit::Nanoseconds);              \
+    ::KibakoEngine::PerfCounters::ScopedTimer KBK_CONCAT(_kbkTimer, __LINE__)(KBK_CONCAT(_kbkTimerId, __LINE__))
@@ -1,64 +1,203 @@
 // Scoped profiling helpers
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <chrono>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "KibakoEngine/Core/Debug.h"
 
+// On in every configuration: a scope costs two timestamps and a ring push.
+// Define KBK_ENABLE_PROFILING=0 to compile scopes out entirely.
 #if !defined(KBK_ENABLE_PROFILING)
-#    if KBK_DEBUG_BUILD
-#        define KBK_ENABLE_PROFILING 1
+#    define KBK_ENABLE_PROFILING 1
+#endif
+
+// Invariant TSC timestamps on x86, calibrated against steady_clock
+#if !defined(KBK_PROFILER_USE_TSC)
+#    if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#        define KBK_PROFILER_USE_TSC 1
+#    else
+#        define KBK_PROFILER_USE_TSC 0
+#    endif
+#endif
+
+#if KBK_ENABLE_PROFILING && KBK_PROFILER_USE_TSC
+#    if defined(_MSC_VER)
+#        include <intrin.h>
 #    else
-#        define KBK_ENABLE_PROFILING 0
+#        include <x86intrin.h>
 #    endif
 #endif
 
 namespace KibakoEngine::Profiler {
 
+    struct CallTreeNode
+    {
+        std::string   name;             // Scope name, or the thread name at depth 0
+        std::uint32_t parent = 0;       // Index into CallTree::nodes; kNoParent for thread roots
+        std::uint32_t depth = 0;
+
+        // Last completed frame
+        double        inclusiveMs = 0.0;
+        double        exclusiveMs = 0.0;
+        std::uint32_t hits = 0;
+
+        // Inclusive time per frame over the recent window
+        double avgMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    // Scopes aggregated by call path, so the same scope under two callers stays separate
+    struct CallTree
+    {
+        static constexpr std::uint32_t kNoParent = std::numeric_limits<std::uint32_t>::max();
+
+        std::vector<CallTreeNode> nodes;  // Pre-order: a parent always precedes its children
+        std::uint32_t             windowFrames = 0;
+
+        // Slash-separated path from the thread name, e.g. "Main/Frame/RenderFrame"
+        [[nodiscard]] const CallTreeNode* Find(std::string_view path) const;
+    };
+
 #if KBK_ENABLE_PROFILING
 
+    // Drains every thread's event ring; logs a summary every few frames
     void BeginFrame();
     void Flush();
 
+    // Events lost because a thread's ring was full between two drains
+    [[nodiscard]] std::uint64_t DroppedEvents();
+
+    // Label for the calling thread in captures
+    void SetThreadName(const char* name);
+
+    // Records every scope until frameCount more frames have begun, then writes
+    // Chrome Trace Event JSON (chrome://tracing, ui.perfetto.dev) to path
+    bool BeginCapture(std::uint32_t frameCount, const char* path);
+    [[nodiscard]] bool IsCapturing();
+
+    // Snapshot of the call tree; events count toward the frame in which their root scope ended
+    void GetCallTree(CallTree& out);
+
+    namespace Detail
+    {
+        using ScopeId = std::uint32_t;
+
+        // Registers a scope name once per call site; equal names share an id.
+        // The name must outlive the profiler (string literals do).
+        ScopeId InternScope(const char* name);
+
+        // Nesting depth of the calling thread's open scopes
+        inline thread_local std::uint32_t t_scopeDepth = 0;
+
+        // Ids of the calling thread's open scopes, outermost first, for the sampling
+        // profiler's signal handler; scopes nested deeper than this are not tracked
+        constexpr std::uint32_t kMaxScopeStack = 32;
+        inline thread_local ScopeId t_scopeStack[kMaxScopeStack] = {};
+        // Where each open ScopedEvent lives; it sits in the frame that opened the scope,
+        // which tells the sampler that frame's callees from its callers
+        inline thread_local const void* t_scopeAddresses[kMaxScopeStack] = {};
+
+        // Profiler thread index of the calling thread; kNoThread until it first records a scope or is named
+        constexpr std::uint32_t kNoThread = std::numeric_limits<std::uint32_t>::max();
+        inline thread_local std::uint32_t t_threadIndex = kNoThread;
+
+        // Name lookups for tools that only hold ids
+        [[nodiscard]] const char* ScopeName(ScopeId scope);
+        [[nodiscard]] std::string ThreadName(std::uint32_t threadIndex);
+
+        inline std::uint32_t PushScope(ScopeId scope, const void* address)
+        {
+            const std::uint32_t depth = t_scopeDepth;
+            if (depth < kMaxScopeStack) {
+                t_scopeStack[depth] = scope;
+                t_scopeAddresses[depth] = address;
+            }
+            // A signal landing between these stores must see the entry before the depth
+            std::atomic_signal_fence(std::memory_order_release);
+            t_scopeDepth = depth + 1;
+            return depth;
+        }
+
+        // Lock-free push into the calling thread's ring
+        void RecordEvent(ScopeId scope, std::uint32_t depth, std::int64_t startTicks, std::int64_t endTicks);
+
+        // Calibrated length of one NowTicks tick; the profiler refines it every frame
+        [[nodiscard]] double NsPerTick();
+
+        inline std::int64_t NowTicks()
+        {
+#if KBK_PROFILER_USE_TSC
+            return static_cast<std::int64_t>(__rdtsc());
+#else
+            return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+        }
+    }
+
     class ScopedEvent
     {
     public:
-        explicit ScopedEvent(const char* name);
-        ~ScopedEvent();
+        explicit ScopedEvent(Detail::ScopeId scope)
+            : m_scope(scope)
+            , m_depth(Detail::PushScope(scope, this))
+            , m_start(Detail::NowTicks())
+        {
+        }
+
+        ~ScopedEvent()
+        {
+            const std::int64_t end = Detail::NowTicks();
+            --Detail::t_scopeDepth;
+            Detail::RecordEvent(m_scope, m_depth, m_start, end);
+        }
 
         ScopedEvent(const ScopedEvent&) = delete;
         ScopedEvent& operator=(const ScopedEvent&) = delete;
 
     private:
-        const char* m_name = nullptr;
-        std::chrono::steady_clock::time_point m_start;
+        Detail::ScopeId m_scope = 0;
+        std::uint32_t   m_depth = 0;
+        std::int64_t    m_start = 0;
     };
 
 #else
 
     inline void BeginFrame() {}
     inline void Flush() {}
+    [[nodiscard]] inline std::uint64_t DroppedEvents() { return 0; }
+    inline void SetThreadName(const char*) {}
+    inline bool BeginCapture(std::uint32_t, const char*) { return false; }
+    [[nodiscard]] inline bool IsCapturing() { return false; }
+    inline void GetCallTree(CallTree& out) { out = CallTree{}; }
 
     class ScopedEvent
     {
     public:
-        explicit ScopedEvent(const char*) {}
+        explicit ScopedEvent(std::uint32_t) {}
     };
 
 #endif
 
 } // namespace KibakoEngine::Profiler
 
-#define KBK_CONCAT_INNER(a, b) a##b
-#define KBK_CONCAT(a, b) KBK_CONCAT_INNER(a, b)
-
+// name is interned on the first pass through the call site, so it must not vary at runtime
 #if KBK_ENABLE_PROFILING
-#    define KBK_PROFILE_SCOPE(name) ::KibakoEngine::Profiler::ScopedEvent KBK_CONCAT(_kbkProfileScope, __LINE__)(name)
+#    define KBK_PROFILE_SCOPE(name)                                                                             \
+        static const ::KibakoEngine::Profiler::Detail::ScopeId KBK_CONCAT(_kbkProfileId, __LINE__) =           \
+            ::KibakoEngine::Profiler::Detail::InternScope(name);                                               \
+        ::KibakoEngine::Profiler::ScopedEvent KBK_CONCAT(_kbkProfileScope, __LINE__)(KBK_CONCAT(_kbkProfileId, __LINE__))
 #else
 #    define KBK_PROFILE_SCOPE(name) ((void)0)
 #endif
 
 #define KBK_PROFILE_FUNCTION() KBK_PROFILE_SCOPE(__FUNCTION__)
 #define KBK_PROFILE_FRAME(name) KBK_PROFILE_SCOPE(name)
-
@@ -0,0 +1,103 @@
+// Frame recording and deterministic replay of input, time steps and sprite output
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "KibakoEngine/Core/Input.h"
+#include "KibakoEngine/Renderer/RenderCommandList.h"
+
+namespace KibakoEngine {
+
+    // Textures are stored by sort id, which is stable as long as assets load in the same order
+    struct ReplaySprite {
+        std::uint32_t textureId = 0;
+        RectF         dst;
+        RectF         src;
+        Color4        color;
+        float         rotation = 0.0f;
+        int           layer = 0;
+    };
+
+    struct ReplayFrame {
+        double        deltaSeconds = 0.0;
+        InputSnapshot input;
+        std::uint64_t spriteHash = 0;
+        std::uint32_t spriteCount = 0;
+        std::vector<ReplaySprite> sprites;               // Only in captures recorded with the sprite stream
+    };
+
+    struct ReplayHeader {
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        bool          hasSprites = false;
+    };
+
+    // FNV-1a over what each command draws; pointers and sort keys are left out
+    [[nodiscard]] std::uint64_t HashSpriteCommands(std::span<const SpriteCommand> commands);
+
+    // Binary capture: a header, then one size-prefixed record per frame. Keys are stored
+    // as changes from the previous frame plus the frame's press events, so an idle
+    // keyboard costs four bytes per frame.
+    class ReplayRecorder {
+    public:
+        ReplayRecorder() = default;
+        ~ReplayRecorder() { Close(); }
+
+        ReplayRecorder(const ReplayRecorder&) = delete;
+        ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+        bool Open(const std::string& path, const ReplayHeader& header);
+        void Close();
+        [[nodiscard]] bool IsOpen() const { return m_file != nullptr; }
+
+        // Input and time step are known once events are handled; the frame is
+        // written when its sprites are
+        void BeginFrame(double deltaSeconds, const InputSnapshot& input);
+        void EndFrame(std::span<const SpriteCommand> sprites);
+
+        [[nodiscard]] std::uint64_t FramesWritten() const { return m_frames; }
+
+    private:
+        std::FILE*                m_file = nullptr;
+        ReplayHeader              m_header{};
+        std::string               m_path;
+        double                    m_delta = 0.0;
+        InputSnapshot             m_input{};
+        InputSnapshot             m_previousInput{};
+        bool                      m_framePending = false;
+        std::uint64_t             m_frames = 0;
+        std::vector<std::uint8_t> m_buffer;
+    };
+
+    class ReplayPlayer {
+    public:
+        ReplayPlayer() = default;
+        ~ReplayPlayer() { Close(); }
+
+        ReplayPlayer(const ReplayPlayer&) = delete;
+        ReplayPlayer& operator=(const ReplayPlayer&) = delete;
+
+        bool Open(const std::string& path);
+        void Close();
+        [[nodiscard]] bool IsOpen() const { return m_file != nullptr; }
+        [[nodiscard]] const ReplayHeader& Header() const { return m_header; }
+
+        // False at the end of the capture or on a damaged record
+        bool ReadFrame(ReplayFrame& out);
+
+        [[nodiscard]] std::uint64_t FramesRead() const { return m_frames; }
+
+    private:
+        std::FILE*                m_file = nullptr;
+        ReplayHeader              m_header{};
+        std::array<std::uint8_t, SDL_NUM_SCANCODES> m_keys{};
+        std::uint64_t             m_frames = 0;
+        std::vector<std::uint8_t> m_buffer;
+    };
+
+} // namespace KibakoEngine
@@ -0,0 +1,39 @@
+// Statistical CPU sampling for code without profile scopes
+#pragma once
+
+#include <cstdint>
+
+// SIGPROF sampling is Linux-only; elsewhere Start() reports that it is unavailable
+#if !defined(KBK_ENABLE_SAMPLING_PROFILER)
+#    if defined(__linux__)
+#        define KBK_ENABLE_SAMPLING_PROFILER 1
+#    else
+#        define KBK_ENABLE_SAMPLING_PROFILER 0
+#    endif
+#endif
+
+namespace KibakoEngine::SamplingProfiler {
+
+    // Prime, so the sampling period does not line up with a 60 Hz frame
+    inline constexpr std::uint32_t kDefaultHz = 997;
+
+    // Samples the process every 1/hz seconds of CPU time. Each sample keeps the
+    // interrupted thread's open KBK_PROFILE_SCOPE stack plus the native frames below
+    // the innermost scope, so time inside a scope is split by the functions it calls.
+    // Native frames come from the frame-pointer chain (x86-64, -fno-omit-frame-pointer):
+    // code built without frame pointers loses its callers, and outside any scope only
+    // the interrupted function is kept.
+    bool Start(std::uint32_t hz = kDefaultHz);
+    void Stop();
+    [[nodiscard]] bool IsRunning();
+
+    [[nodiscard]] std::uint64_t SampleCount();
+    // Samples lost because the buffer was full
+    [[nodiscard]] std::uint64_t DroppedSamples();
+
+    // Stops sampling and writes folded stacks ("Main;Frame;SpriteBatchFlush;cosf 12"),
+    // the input of flamegraph.pl and speedscope. Native frames are named through the
+    // dynamic symbol table, so link with -rdynamic for names beyond exported symbols.
+    bool WriteFoldedStacks(const char* path);
+
+} // namespace KibakoEngine::SamplingProfiler
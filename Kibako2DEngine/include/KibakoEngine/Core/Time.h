@@ -8,6 +8,8 @@ namespace KibakoEngine {
     class Time {
     public:
         void Tick();
+        // Advances by a given step instead of the wall clock (replays, soak runs)
+        void TickFixed(double deltaSeconds);
 
         [[nodiscard]] double DeltaSeconds() const { return m_delta; }
         [[nodiscard]] double TotalSeconds() const { return m_total; }
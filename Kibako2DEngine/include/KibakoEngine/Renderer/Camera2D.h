@@ -3,6 +3,8 @@
 
 #include <DirectXMath.h>
 
+#include "KibakoEngine/Renderer/SpriteTypes.h"
+
 namespace KibakoEngine {
 
     class Camera2D {
@@ -13,9 +15,15 @@ namespace KibakoEngine {
 
         [[nodiscard]] DirectX::XMFLOAT2 GetPosition() const { return { m_positionX, m_positionY }; }
         [[nodiscard]] float             GetRotation() const { return m_rotation; }
+        [[nodiscard]] DirectX::XMFLOAT2 GetViewportSize() const { return { m_viewWidth, m_viewHeight }; }
         [[nodiscard]] DirectX::XMFLOAT4X4 GetViewProjection() const { return m_viewProj; }
         [[nodiscard]] const DirectX::XMFLOAT4X4& GetViewProjectionT() const { return m_viewProjT; }
 
+        // Viewport pixel -> world position
+        [[nodiscard]] DirectX::XMFLOAT2 ScreenToWorld(float x, float y) const;
+        // World-space AABB of the (possibly rotated) view
+        [[nodiscard]] RectF GetViewBounds() const;
+
     private:
         void UpdateMatrix();
 
@@ -0,0 +1,45 @@
+// CPU RGBA8 image with golden-image helpers (compare, save, load)
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace KibakoEngine {
+
+    // Rows top to bottom, 4 bytes per pixel (R, G, B, A)
+    struct ImageRGBA8 {
+        std::uint32_t             width = 0;
+        std::uint32_t             height = 0;
+        std::vector<std::uint8_t> pixels;
+
+        void Resize(std::uint32_t newWidth, std::uint32_t newHeight)
+        {
+            width = newWidth;
+            height = newHeight;
+            pixels.assign(static_cast<std::size_t>(newWidth) * newHeight * 4u, 0u);
+        }
+
+        [[nodiscard]] bool Empty() const { return width == 0 || height == 0; }
+    };
+
+    struct ImageDiff {
+        bool          sizeMismatch = false;
+        std::uint64_t mismatchedPixels = 0;
+        std::uint32_t maxChannelDelta = 0;
+
+        [[nodiscard]] bool Matches() const { return !sizeMismatch && mismatchedPixels == 0; }
+    };
+
+    namespace ImageIO
+    {
+        // A pixel mismatches when any channel differs by more than tolerance
+        [[nodiscard]] ImageDiff Compare(const ImageRGBA8& a, const ImageRGBA8& b, std::uint32_t tolerance = 0);
+
+        // Uncompressed 32-bit TGA, readable back through Load
+        [[nodiscard]] bool SaveTGA(const std::string& path, const ImageRGBA8& image);
+        // Any format stb_image understands, converted to RGBA8
+        [[nodiscard]] bool Load(const std::string& path, ImageRGBA8& out);
+    }
+
+} // namespace KibakoEngine
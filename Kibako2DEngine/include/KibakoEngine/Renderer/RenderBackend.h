@@ -0,0 +1,59 @@
+// Renderer interface implemented by the Direct3D 11 and headless backends
+#pragma once
+
+#include <cstdint>
+
+#include "KibakoEngine/Renderer/Camera2D.h"
+#include "KibakoEngine/Renderer/ImageRGBA8.h"
+#include "KibakoEngine/Renderer/SpriteBatch2D.h"
+#include "KibakoEngine/Renderer/SpriteTypes.h"
+
+struct ID3D11Device;
+
+namespace KibakoEngine {
+
+    class RenderBackend {
+    public:
+        RenderBackend() = default;
+        virtual ~RenderBackend() = default;
+
+        RenderBackend(const RenderBackend&) = delete;
+        RenderBackend& operator=(const RenderBackend&) = delete;
+
+        virtual void Shutdown() = 0;
+
+        virtual void BeginFrame(const float clearColor[4]) = 0;
+        virtual void EndFrame(bool waitForVSync) = 0;
+        // Render targets only; leaves the camera to the simulation thread
+        virtual bool ResizeTargets(std::uint32_t width, std::uint32_t height) = 0;
+
+        // Called by SpriteBatch2D with sorted quads, one range per texture/layer run
+        virtual void DrawSprites(const SpriteDrawData& data) = 0;
+
+        // Null for headless backends, which then create CPU-only textures
+        [[nodiscard]] virtual ID3D11Device* GetDevice() const { return nullptr; }
+        [[nodiscard]] virtual const char* Name() const = 0;
+
+        // Copies the last completed frame; false when the backend keeps no pixels
+        [[nodiscard]] virtual bool CaptureImage(ImageRGBA8& out) const;
+
+        void OnResize(std::uint32_t width, std::uint32_t height);
+
+        [[nodiscard]] Camera2D& Camera() { return m_camera; }
+        [[nodiscard]] const Camera2D& Camera() const { return m_camera; }
+        [[nodiscard]] SpriteBatch2D& Batch() { return m_batch; }
+        [[nodiscard]] std::uint32_t Width() const { return m_width; }
+        [[nodiscard]] std::uint32_t Height() const { return m_height; }
+
+    protected:
+        // Shared setup once the backend can accept draws
+        [[nodiscard]] bool InitCommon(std::uint32_t width, std::uint32_t height);
+        void ShutdownCommon();
+
+        Camera2D      m_camera;
+        SpriteBatch2D m_batch;
+        std::uint32_t m_width = 0;
+        std::uint32_t m_height = 0;
+    };
+
+} // namespace KibakoEngine
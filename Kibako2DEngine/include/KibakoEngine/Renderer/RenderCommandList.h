@@ -0,0 +1,67 @@
+// Recorded frame of render commands handed to the render thread
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "KibakoEngine/Renderer/SpriteTypes.h"
+
+namespace KibakoEngine {
+
+    class Texture2D;
+
+    // Layer in the high bits (sign flipped so negative layers sort first), texture below
+    [[nodiscard]] constexpr std::uint64_t MakeSpriteSortKey(int layer, std::uint32_t textureSortId)
+    {
+        const auto biasedLayer = static_cast<std::uint32_t>(layer) ^ 0x80000000u;
+        return (static_cast<std::uint64_t>(biasedLayer) << 32) | textureSortId;
+    }
+
+    // Textures are referenced, not owned: they must outlive every frame in flight
+    struct SpriteCommand {
+        const Texture2D* texture = nullptr;
+        RectF  dst;
+        RectF  src;
+        Color4 color;
+        float  rotation = 0.0f;
+        int    layer = 0;
+        std::uint64_t sortKey = 0;
+    };
+
+    // Everything the render side needs to draw one frame
+    class RenderCommandList {
+    public:
+        // Clears commands but keeps their capacity
+        void Reset();
+
+        void SetFrameIndex(std::uint64_t frameIndex) { m_frameIndex = frameIndex; }
+        void SetViewProjection(const DirectX::XMFLOAT4X4& viewProjT) { m_viewProjT = viewProjT; }
+        void SetViewport(std::uint32_t width, std::uint32_t height);
+        void SetClearColor(const float clearColor[4]);
+        void SetVSync(bool waitForVSync) { m_waitForVSync = waitForVSync; }
+
+        void PushSprite(const SpriteCommand& command) { m_sprites.push_back(command); }
+        [[nodiscard]] std::vector<SpriteCommand>& Sprites() { return m_sprites; }
+
+        [[nodiscard]] std::uint64_t FrameIndex() const { return m_frameIndex; }
+        [[nodiscard]] const DirectX::XMFLOAT4X4& ViewProjection() const { return m_viewProjT; }
+        [[nodiscard]] std::uint32_t ViewportWidth() const { return m_viewportWidth; }
+        [[nodiscard]] std::uint32_t ViewportHeight() const { return m_viewportHeight; }
+        [[nodiscard]] const float* ClearColor() const { return m_clearColor; }
+        [[nodiscard]] bool WaitForVSync() const { return m_waitForVSync; }
+        [[nodiscard]] const std::vector<SpriteCommand>& Sprites() const { return m_sprites; }
+
+    private:
+        std::uint64_t       m_frameIndex = 0;
+        DirectX::XMFLOAT4X4 m_viewProjT{};
+        std::uint32_t       m_viewportWidth = 0;
+        std::uint32_t       m_viewportHeight = 0;
+        float               m_clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        bool                m_waitForVSync = true;
+
+        std::vector<SpriteCommand> m_sprites;
+    };
+
+} // namespace KibakoEngine
@@ -0,0 +1,56 @@
+// Triple-buffered hand-off of command lists between simulation and render threads
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "KibakoEngine/Renderer/RenderCommandList.h"
+
+namespace KibakoEngine {
+
+    // One list is recorded, one waits, one is rendered; frames are never dropped
+    class RenderFrameQueue {
+    public:
+        static constexpr std::size_t kBufferCount = 3;
+
+        // Simulation side: blocks while every list is in flight
+        [[nodiscard]] RenderCommandList* BeginRecord();
+        void Submit();
+
+        // Render side: blocks until a list is ready, nullptr once closed and drained
+        [[nodiscard]] const RenderCommandList* AcquireForRender();
+        void ReleaseRendered();
+
+        // Wakes both sides; pending lists are still handed to the renderer
+        void Close();
+        void Reopen();
+
+        [[nodiscard]] bool IsClosed() const;
+        [[nodiscard]] std::uint64_t SubmittedCount() const;
+
+    private:
+        enum class SlotState : std::uint8_t {
+            Free,
+            Recording,
+            Ready,
+            Rendering,
+        };
+
+        mutable std::mutex      m_mutex;
+        std::condition_variable m_freeCv;
+        std::condition_variable m_readyCv;
+
+        std::array<RenderCommandList, kBufferCount> m_lists;
+        std::array<SlotState, kBufferCount>         m_states{};
+        std::array<std::uint64_t, kBufferCount>     m_order{};
+
+        int           m_recording = -1;
+        int           m_rendering = -1;
+        std::uint64_t m_submitted = 0;
+        bool          m_closed = false;
+    };
+
+} // namespace KibakoEngine
@@ -0,0 +1,41 @@
+// Dedicated thread consuming recorded command lists
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+#include "KibakoEngine/Renderer/RenderFrameQueue.h"
+
+namespace KibakoEngine {
+
+    class RenderThread {
+    public:
+        // Runs on the render thread once per submitted list
+        using ExecuteFn = std::function<void(const RenderCommandList&)>;
+
+        RenderThread() = default;
+        ~RenderThread();
+
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        [[nodiscard]] bool Start(ExecuteFn execute);
+        // Renders every pending list, then joins
+        void Stop();
+
+        [[nodiscard]] bool IsRunning() const { return m_thread.joinable(); }
+        [[nodiscard]] RenderFrameQueue& Queue() { return m_queue; }
+        [[nodiscard]] std::uint64_t FramesRendered() const { return m_framesRendered.load(std::memory_order_relaxed); }
+
+    private:
+        void ThreadMain();
+
+        RenderFrameQueue           m_queue;
+        ExecuteFn                  m_execute;
+        std::thread                m_thread;
+        std::atomic<std::uint64_t> m_framesRendered{ 0 };
+    };
+
+} // namespace KibakoEngine
@@ -1,51 +1,72 @@
-// Direct3D 11 renderer and sprite batch owner
+// Direct3D 11 renderer and sprite pipeline
 #pragma once
 
+#if defined(_WIN32)
+
 #include <d3d11.h>
 #include <dxgi.h>
 #include <wrl/client.h>
 
 #include <cstdint>
 
-#include "KibakoEngine/Renderer/Camera2D.h"
-#include "KibakoEngine/Renderer/SpriteBatch2D.h"
+#include "KibakoEngine/Renderer/RenderBackend.h"
 
 struct HWND__;
 using HWND = HWND__*;
 
 namespace KibakoEngine {
 
-    class RendererD3D11 {
+    class RendererD3D11 final : public RenderBackend {
     public:
+        ~RendererD3D11() override { Shutdown(); }
+
         bool Init(HWND hwnd, uint32_t width, uint32_t height);
-        void Shutdown();
+        void Shutdown() override;
 
-        void BeginFrame(const float clearColor[4]);
-        void EndFrame(bool waitForVSync);
-        void OnResize(uint32_t width, uint32_t height);
+        void BeginFrame(const float clearColor[4]) override;
+        void EndFrame(bool waitForVSync) override;
+        bool ResizeTargets(uint32_t width, uint32_t height) override;
+        void DrawSprites(const SpriteDrawData& data) override;
 
-        [[nodiscard]] ID3D11Device* GetDevice() const { return m_device.Get(); }
+        [[nodiscard]] ID3D11Device* GetDevice() const override { return m_device.Get(); }
         [[nodiscard]] ID3D11DeviceContext* GetImmediateContext() const { return m_context.Get(); }
-        [[nodiscard]] Camera2D& Camera() { return m_camera; }
-        [[nodiscard]] SpriteBatch2D& Batch() { return m_batch; }
-        [[nodiscard]] uint32_t Width() const { return m_width; }
-        [[nodiscard]] uint32_t Height() const { return m_height; }
+        [[nodiscard]] const char* Name() const override { return "D3D11"; }
 
     private:
+        struct CBVS {
+            DirectX::XMFLOAT4X4 viewProjT;
+        };
+
         bool CreateSwapChain(HWND hwnd, uint32_t width, uint32_t height);
         bool CreateRenderTargets(uint32_t width, uint32_t height);
 
+        [[nodiscard]] bool CreateSpriteShaders(ID3D11Device* device);
+        [[nodiscard]] bool CreateSpriteStates(ID3D11Device* device);
+        [[nodiscard]] bool EnsureVertexCapacity(size_t spriteCount);
+        [[nodiscard]] bool EnsureIndexCapacity(size_t spriteCount);
+        void UpdateVSConstants(const DirectX::XMFLOAT4X4& viewProjT);
+
         Microsoft::WRL::ComPtr<ID3D11Device> m_device;
         Microsoft::WRL::ComPtr<ID3D11DeviceContext> m_context;
         Microsoft::WRL::ComPtr<IDXGISwapChain> m_swapChain;
         Microsoft::WRL::ComPtr<ID3D11RenderTargetView> m_rtv;
         D3D_FEATURE_LEVEL m_featureLevel = D3D_FEATURE_LEVEL_11_0;
 
-        Camera2D     m_camera;
-        SpriteBatch2D m_batch;
-        uint32_t     m_width = 0;
-        uint32_t     m_height = 0;
+        // Sprite pipeline fed by SpriteBatch2D
+        Microsoft::WRL::ComPtr<ID3D11VertexShader>      m_vs;
+        Microsoft::WRL::ComPtr<ID3D11PixelShader>       m_ps;
+        Microsoft::WRL::ComPtr<ID3D11InputLayout>       m_inputLayout;
+        Microsoft::WRL::ComPtr<ID3D11Buffer>            m_spriteVB;
+        Microsoft::WRL::ComPtr<ID3D11Buffer>            m_spriteIB;
+        Microsoft::WRL::ComPtr<ID3D11Buffer>            m_cbVS;
+        Microsoft::WRL::ComPtr<ID3D11SamplerState>      m_samplerPoint;
+        Microsoft::WRL::ComPtr<ID3D11BlendState>        m_blendAlpha;
+        Microsoft::WRL::ComPtr<ID3D11DepthStencilState> m_depthDisabled;
+        Microsoft::WRL::ComPtr<ID3D11RasterizerState>   m_rasterCullNone;
+        size_t m_spriteVBCapacity = 0;
+        size_t m_spriteIBCapacity = 0;
     };
 
 } // namespace KibakoEngine
 
+#endif // defined(_WIN32)
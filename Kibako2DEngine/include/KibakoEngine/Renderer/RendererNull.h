@@ -0,0 +1,59 @@
+// Headless renderer: full CPU batching, output discarded or captured
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "KibakoEngine/Renderer/RenderBackend.h"
+
+namespace KibakoEngine {
+
+    // One DrawSprites call as seen by the backend
+    struct CapturedSpriteDraw {
+        DirectX::XMFLOAT4X4 viewProjT{};
+        SpriteDrawRange     range;       // firstSprite indexes CapturedFrame::vertices / 4
+    };
+
+    struct CapturedFrame {
+        std::uint64_t                   frameIndex = 0;
+        float                           clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        std::vector<SpriteVertex>       vertices;
+        std::vector<CapturedSpriteDraw> draws;
+    };
+
+    struct NullRenderStats {
+        std::uint64_t frames = 0;
+        std::uint64_t sprites = 0;
+        std::uint64_t drawRanges = 0;
+    };
+
+    class RendererNull final : public RenderBackend {
+    public:
+        ~RendererNull() override { Shutdown(); }
+
+        bool Init(std::uint32_t width, std::uint32_t height);
+        void Shutdown() override;
+
+        void BeginFrame(const float clearColor[4]) override;
+        void EndFrame(bool waitForVSync) override;
+        bool ResizeTargets(std::uint32_t width, std::uint32_t height) override;
+        void DrawSprites(const SpriteDrawData& data) override;
+
+        [[nodiscard]] const char* Name() const override { return "Null"; }
+
+        // When enabled, the last completed frame's quads are kept for inspection
+        void SetCaptureEnabled(bool enabled) { m_captureEnabled = enabled; }
+        [[nodiscard]] bool IsCaptureEnabled() const { return m_captureEnabled; }
+        [[nodiscard]] const CapturedFrame& LastFrame() const { return m_lastFrame; }
+
+        [[nodiscard]] const NullRenderStats& Stats() const { return m_stats; }
+
+    private:
+        CapturedFrame   m_currentFrame;
+        CapturedFrame   m_lastFrame;
+        NullRenderStats m_stats{};
+        bool            m_captureEnabled = false;
+        bool            m_initialized = false;
+    };
+
+} // namespace KibakoEngine
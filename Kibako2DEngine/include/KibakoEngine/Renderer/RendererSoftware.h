@@ -0,0 +1,117 @@
+// CPU sprite rasterizer: tile-binned, multithreaded, point sampled
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "KibakoEngine/Renderer/ImageRGBA8.h"
+#include "KibakoEngine/Renderer/RenderBackend.h"
+
+#if !defined(KBK_SOFTWARE_RASTER_SSE2)
+#    if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#        define KBK_SOFTWARE_RASTER_SSE2 1
+#    else
+#        define KBK_SOFTWARE_RASTER_SSE2 0
+#    endif
+#endif
+
+namespace KibakoEngine {
+
+    struct SoftwareRenderStats {
+        std::uint64_t frames = 0;
+        std::uint32_t sprites = 0;        // Last frame, after screen rejection
+        std::uint32_t tiles = 0;          // Last frame, tiles with at least one sprite
+        std::uint64_t pixelsShaded = 0;   // Last frame, overdraw included
+    };
+
+    // Output is identical for any worker count and with or without SIMD:
+    // each tile owns its pixels and draws its sprites in submission order.
+    class RendererSoftware final : public RenderBackend {
+    public:
+        static constexpr std::uint32_t kTileSize = 64;
+
+        ~RendererSoftware() override { Shutdown(); }
+
+        // Negative workerCount picks hardware threads - 1; the calling thread also rasterizes
+        bool Init(std::uint32_t width, std::uint32_t height, int workerCount = -1);
+        void Shutdown() override;
+
+        void BeginFrame(const float clearColor[4]) override;
+        // Rasterizes every sprite drawn since BeginFrame
+        void EndFrame(bool waitForVSync) override;
+        bool ResizeTargets(std::uint32_t width, std::uint32_t height) override;
+        void DrawSprites(const SpriteDrawData& data) override;
+
+        [[nodiscard]] bool CaptureImage(ImageRGBA8& out) const override;
+        [[nodiscard]] const char* Name() const override { return "Software"; }
+
+        // Last completed frame
+        [[nodiscard]] const ImageRGBA8& Image() const { return m_image; }
+
+        // SSE2 span blending; the scalar path produces the same bytes
+        void SetSimdEnabled(bool enabled);
+        [[nodiscard]] bool IsSimdEnabled() const { return m_simdEnabled; }
+
+        [[nodiscard]] std::uint32_t WorkerCount() const { return static_cast<std::uint32_t>(m_workers.size()); }
+        [[nodiscard]] const SoftwareRenderStats& Stats() const { return m_stats; }
+
+    private:
+        // One quad in 24.8 fixed-point screen space, with its texture mapping
+        struct RasterSprite {
+            std::int64_t        x[4];
+            std::int64_t        y[4];
+            float               uPlane[3];  // u = a*x + b*y + c over pixel centers
+            float               vPlane[3];
+            float               color[4];
+            const std::uint8_t* texels = nullptr;
+            std::int32_t        texWidth = 0;
+            std::int32_t        texHeight = 0;
+            bool                srgb = false;
+            std::int32_t        minX = 0, minY = 0, maxX = 0, maxY = 0;  // Inclusive pixel bounds
+        };
+
+        struct TileRect {
+            std::int32_t x0, y0, x1, y1;  // Half-open
+        };
+
+        void ResizeImage(std::uint32_t width, std::uint32_t height);
+        void BinSprites();
+        void RasterizeFrame();
+        void WorkerMain(int index);
+        void RunTiles();
+        std::uint64_t RasterizeTile(std::uint32_t tileIndex);
+        std::uint64_t RasterizeTriangle(const RasterSprite& sprite, int i0, int i1, int i2, const TileRect& rect);
+        void ShadeSpan(const RasterSprite& sprite, std::int32_t y, std::int32_t x0, std::int32_t x1);
+#if KBK_SOFTWARE_RASTER_SSE2
+        void ShadeSpanSSE2(const RasterSprite& sprite, std::int32_t y, std::int32_t x0, std::int32_t x1);
+#endif
+
+        ImageRGBA8   m_image;
+        std::uint8_t m_clearBytes[4] = { 0, 0, 0, 255 };
+
+        std::vector<RasterSprite>               m_sprites;
+        std::vector<std::vector<std::uint32_t>> m_tileBins;
+        std::uint32_t                           m_tilesX = 0;
+        std::uint32_t                           m_tilesY = 0;
+
+        // Worker pool, woken once per frame
+        std::vector<std::thread>     m_workers;
+        std::mutex                   m_poolMutex;
+        std::condition_variable      m_poolWake;
+        std::condition_variable      m_poolDone;
+        std::uint64_t                m_jobGeneration = 0;
+        std::uint32_t                m_busyWorkers = 0;
+        bool                         m_stopWorkers = false;
+        std::atomic<std::uint32_t>   m_nextTile{ 0 };
+        std::atomic<std::uint64_t>   m_pixelsShaded{ 0 };
+
+        SoftwareRenderStats m_stats{};
+        bool                m_simdEnabled = false;
+        bool                m_initialized = false;
+    };
+
+} // namespace KibakoEngine
@@ -1,19 +1,21 @@
-// Batched sprite renderer for Direct3D 11
+// Batched sprite renderer (sort + vertex build, drawn by the render backend)
 #pragma once
 
-#include <d3d11.h>
-#include <wrl/client.h>
-
 #include <DirectXMath.h>
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
+#include "KibakoEngine/Renderer/RenderCommandList.h"
+#include "KibakoEngine/Renderer/SpriteCommandBuffer.h"
 #include "KibakoEngine/Renderer/SpriteTypes.h"
 #include "KibakoEngine/Renderer/Texture2D.h"
 
 namespace KibakoEngine {
 
+    class RenderBackend;
+
     struct SpriteBatchStats
     {
         std::uint32_t drawCalls = 0;
@@ -22,12 +24,17 @@ namespace KibakoEngine {
 
     class SpriteBatch2D {
     public:
-        [[nodiscard]] bool Init(ID3D11Device* device, ID3D11DeviceContext* context);
+        [[nodiscard]] bool Init(RenderBackend& backend);
         void Shutdown();
 
         void Begin(const DirectX::XMFLOAT4X4& viewProjT);
+        // Pushes go into the list instead of being drawn at End
+        void BeginRecord(RenderCommandList& list);
         void End();
 
+        // Draws a recorded list; called from the render thread in threaded mode
+        void Submit(const RenderCommandList& list);
+
         void Push(const Texture2D& texture,
             const RectF& dst,
             const RectF& src,
@@ -35,62 +42,49 @@ namespace KibakoEngine {
             float rotation = 0.0f,
             int layer = 0);
 
+        // Cleared buffers for worker threads (one each), merged by sort key at End.
+        // Call between Begin and End; workers must be done before End.
+        [[nodiscard]] std::span<SpriteCommandBuffer> AcquireThreadBuffers(std::size_t count);
+
         void ResetStats() { m_stats = {}; }
         const SpriteBatchStats& Stats() const { return m_stats; }
+        // Draw calls issued by the last Submit (render thread side)
+        const SpriteBatchStats& SubmitStats() const { return m_submitStats; }
+        // What the last immediate-mode End drew, in draw order
+        [[nodiscard]] std::span<const SpriteCommand> FrameCommands() const { return m_commands; }
+
+        // Drops sprites without a valid texture and sorts the rest into draw order,
+        // as End and Submit do; returns how many were dropped
+        static std::size_t PrepareForDraw(std::vector<SpriteCommand>& commands);
 
         [[nodiscard]] const Texture2D* DefaultWhiteTexture() const;
 
     private:
-        struct Vertex {
-            DirectX::XMFLOAT3 position;
-            DirectX::XMFLOAT2 uv;
-            DirectX::XMFLOAT4 color;
-        };
-
-        struct DrawCommand {
-            const Texture2D* texture = nullptr;
-            RectF  dst;
-            RectF  src;
-            Color4 color;
-            float  rotation = 0.0f;
-            int    layer = 0;
-        };
-
-        struct CBVS {
-            DirectX::XMFLOAT4X4 viewProjT;
-        };
-
-        [[nodiscard]] bool CreateShaders(ID3D11Device* device);
-        [[nodiscard]] bool CreateStates(ID3D11Device* device);
-        [[nodiscard]] bool EnsureVertexCapacity(size_t spriteCount);
-        [[nodiscard]] bool EnsureIndexCapacity(size_t spriteCount);
-        void UpdateVSConstants();
-        void BuildVertices(std::vector<Vertex>& outVertices) const;
-
-        ID3D11Device* m_device = nullptr;
-        ID3D11DeviceContext* m_context = nullptr;
-
-        Microsoft::WRL::ComPtr<ID3D11VertexShader>      m_vs;
-        Microsoft::WRL::ComPtr<ID3D11PixelShader>       m_ps;
-        Microsoft::WRL::ComPtr<ID3D11InputLayout>       m_inputLayout;
-        Microsoft::WRL::ComPtr<ID3D11Buffer>            m_vertexBuffer;
-        Microsoft::WRL::ComPtr<ID3D11Buffer>            m_indexBuffer;
-        Microsoft::WRL::ComPtr<ID3D11Buffer>            m_cbVS;
-        Microsoft::WRL::ComPtr<ID3D11SamplerState>      m_samplerPoint;
-        Microsoft::WRL::ComPtr<ID3D11BlendState>        m_blendAlpha;
-        Microsoft::WRL::ComPtr<ID3D11DepthStencilState> m_depthDisabled;
-        Microsoft::WRL::ComPtr<ID3D11RasterizerState>   m_rasterCullNone;
-
-        std::vector<DrawCommand> m_commands;
-        std::vector<Vertex>      m_vertexScratch;
-        std::vector<std::uint32_t> m_indexScratch;
+        void MergeThreadBuffers(std::vector<SpriteCommand>& commands);
+        void Flush(std::vector<SpriteCommand>& commands,
+                   const DirectX::XMFLOAT4X4& viewProjT,
+                   SpriteBatchStats& stats);
+        static void BuildVertices(const std::vector<SpriteCommand>& commands, std::vector<SpriteVertex>& outVertices);
+        static void BuildRanges(const std::vector<SpriteCommand>& commands, std::vector<SpriteDrawRange>& outRanges);
+
+        RenderBackend* m_backend = nullptr;
+
+        std::vector<SpriteCommand> m_commands;
+        std::vector<SpriteCommand> m_submitCommands;
+        std::vector<SpriteCommand> m_mergeScratch;
+        RenderCommandList*         m_recordTarget = nullptr;
+
+        std::vector<SpriteCommandBuffer> m_threadBuffers;
+        std::size_t                      m_activeThreadBuffers = 0;
+
+        std::vector<SpriteVertex>    m_vertexScratch;
+        std::vector<SpriteDrawRange> m_rangeScratch;
 
         DirectX::XMFLOAT4X4 m_viewProjT{};
-        size_t              m_vertexCapacitySprites = 0;
-        size_t              m_indexCapacitySprites = 0;
         bool                m_isDrawing = false;
 
         SpriteBatchStats    m_stats{};
+        SpriteBatchStats    m_submitStats{};
 
         Texture2D m_defaultWhite;
     };
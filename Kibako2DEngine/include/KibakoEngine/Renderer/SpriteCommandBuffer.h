@@ -0,0 +1,49 @@
+// Per-producer sprite command storage for parallel recording
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "KibakoEngine/Renderer/RenderCommandList.h"
+
+namespace KibakoEngine {
+
+    class Texture2D;
+
+    // Owned by one producer at a time; no synchronization inside
+    class SpriteCommandBuffer {
+    public:
+        void Clear();
+        void Reserve(std::size_t count);
+
+        void Push(const Texture2D& texture,
+            const RectF& dst,
+            const RectF& src,
+            const Color4& color,
+            float rotation = 0.0f,
+            int layer = 0);
+
+        // Stable sort by key; call from the producing thread to spread the cost
+        void Sort();
+
+        [[nodiscard]] bool IsSorted() const { return m_sorted; }
+        [[nodiscard]] std::size_t Size() const { return m_commands.size(); }
+        [[nodiscard]] bool Empty() const { return m_commands.empty(); }
+        [[nodiscard]] const std::vector<SpriteCommand>& Commands() const { return m_commands; }
+
+    private:
+        std::vector<SpriteCommand> m_commands;
+        bool m_sorted = true;
+    };
+
+    namespace SpriteCommandMerge
+    {
+        // Stable sort of one command run by key
+        void SortByKey(std::vector<SpriteCommand>& commands);
+
+        // K-way merge of sorted runs; ties keep run order, then push order
+        void MergeSorted(const std::vector<const std::vector<SpriteCommand>*>& runs,
+                         std::vector<SpriteCommand>& out);
+    }
+
+} // namespace KibakoEngine
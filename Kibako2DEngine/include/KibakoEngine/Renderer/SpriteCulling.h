@@ -0,0 +1,103 @@
+// View culling for sprites before batching
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "KibakoEngine/Renderer/SpriteTypes.h"
+
+namespace KibakoEngine {
+
+    class Camera2D;
+
+    // Oriented view rectangle in world space
+    struct CullView2D
+    {
+        float centerX = 0.0f;
+        float centerY = 0.0f;
+        float axisX = 1.0f;      // View X axis in world (cos, sin)
+        float axisY = 0.0f;
+        float halfWidth = 0.0f;  // Half extents along the view axes
+        float halfHeight = 0.0f;
+        float boundsHalfW = 0.0f; // Half extents of the world-aligned AABB
+        float boundsHalfH = 0.0f;
+
+        [[nodiscard]] static CullView2D FromCamera(const Camera2D& camera, float margin = 0.0f);
+        [[nodiscard]] static CullView2D FromRect(const RectF& rect);
+
+        [[nodiscard]] RectF Bounds() const;
+    };
+
+    // Sprite bounds stored as SoA (center + half extents)
+    class SpriteBounds2D
+    {
+    public:
+        void Clear();
+        void Reserve(std::size_t count);
+
+        // Bounds of a dst rect rotated around its center
+        std::uint32_t Add(const RectF& dst, float rotation);
+        std::uint32_t Add(float centerX, float centerY, float halfW, float halfH);
+
+        [[nodiscard]] std::size_t Size() const { return m_count; }
+        [[nodiscard]] bool Empty() const { return m_count == 0; }
+
+        [[nodiscard]] const float* CenterX() const { return m_centerX.data(); }
+        [[nodiscard]] const float* CenterY() const { return m_centerY.data(); }
+        [[nodiscard]] const float* HalfW() const { return m_halfW.data(); }
+        [[nodiscard]] const float* HalfH() const { return m_halfH.data(); }
+
+    private:
+        std::vector<float> m_centerX;
+        std::vector<float> m_centerY;
+        std::vector<float> m_halfW;
+        std::vector<float> m_halfH;
+        std::size_t        m_count = 0;
+    };
+
+    namespace SpriteCulling
+    {
+        // SIMD sweep; appends visible indices in ascending order and returns their count
+        std::size_t CullVisible(const CullView2D& view,
+                                const SpriteBounds2D& bounds,
+                                std::vector<std::uint32_t>& outVisible);
+
+        // Scalar reference used for validation
+        [[nodiscard]] bool IsVisible(const CullView2D& view, float centerX, float centerY, float halfW, float halfH);
+    }
+
+    // Uniform grid binned by sprite center; suited to mostly static sprite sets
+    class SpriteCullGrid2D
+    {
+    public:
+        void Build(const SpriteBounds2D& bounds, float cellSize);
+        void Clear();
+
+        // Appends visible indices in ascending order and returns their count
+        std::size_t Query(const CullView2D& view,
+                          const SpriteBounds2D& bounds,
+                          std::vector<std::uint32_t>& outVisible) const;
+
+        [[nodiscard]] bool Empty() const { return m_cellStart.empty(); }
+        [[nodiscard]] int CellsX() const { return m_cellsX; }
+        [[nodiscard]] int CellsY() const { return m_cellsY; }
+
+    private:
+        [[nodiscard]] int CellX(float x) const;
+        [[nodiscard]] int CellY(float y) const;
+
+        float m_originX = 0.0f;
+        float m_originY = 0.0f;
+        float m_invCellSize = 1.0f;
+        float m_maxHalfW = 0.0f;
+        float m_maxHalfH = 0.0f;
+        int   m_cellsX = 0;
+        int   m_cellsY = 0;
+
+        std::vector<std::uint32_t> m_cellStart; // CSR offsets, cellsX * cellsY + 1
+        std::vector<std::uint32_t> m_items;     // Sprite indices grouped by cell
+        mutable std::vector<std::uint32_t> m_candidates;
+    };
+
+} // namespace KibakoEngine
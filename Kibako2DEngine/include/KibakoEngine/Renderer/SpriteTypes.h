@@ -3,8 +3,13 @@
 
 #include <DirectXMath.h>
 
+#include <cstdint>
+#include <span>
+
 namespace KibakoEngine {
 
+    class Texture2D;
+
     struct RectF {
         float x = 0.0f;
         float y = 0.0f;
@@ -36,5 +41,26 @@ namespace KibakoEngine {
         int    layer = 0;
     };
 
+    // Quad corner as uploaded to the GPU (4 per sprite, TL TR BR BL)
+    struct SpriteVertex {
+        DirectX::XMFLOAT3 position;
+        DirectX::XMFLOAT2 uv;
+        DirectX::XMFLOAT4 color;
+    };
+
+    // Consecutive sprites sharing a texture and layer
+    struct SpriteDrawRange {
+        const Texture2D* texture = nullptr;
+        std::uint32_t    firstSprite = 0;
+        std::uint32_t    spriteCount = 0;
+    };
+
+    // Output of SpriteBatch2D handed to the render backend
+    struct SpriteDrawData {
+        DirectX::XMFLOAT4X4               viewProjT{};
+        std::span<const SpriteVertex>    vertices;
+        std::span<const SpriteDrawRange> ranges;
+    };
+
 } // namespace KibakoEngine
 
@@ -1,16 +1,27 @@
-// Direct3D 11 texture wrapper
+// Texture wrapper (Direct3D 11, or CPU pixels when created without a device)
 #pragma once
 
-#include <d3d11.h>
-#include <wrl/client.h>
-
-#include <string>
 #include <cstdint>
+#include <string>
+#include <vector>
+
+struct ID3D11Device;
+struct ID3D11Texture2D;
+struct ID3D11ShaderResourceView;
 
 namespace KibakoEngine {
 
     class Texture2D {
     public:
+        Texture2D() = default;
+        ~Texture2D();
+
+        Texture2D(const Texture2D&) = delete;
+        Texture2D& operator=(const Texture2D&) = delete;
+        Texture2D(Texture2D&& other) noexcept;
+        Texture2D& operator=(Texture2D&& other) noexcept;
+
+        // A null device creates a CPU-only texture for headless backends
         bool LoadFromFile(ID3D11Device* device, const std::string& path, bool srgb = false);
         bool CreateFromRGBA8(ID3D11Device* device,
                              int width,
@@ -25,15 +36,27 @@ namespace KibakoEngine {
 
         [[nodiscard]] int Width() const { return m_width; }
         [[nodiscard]] int Height() const { return m_height; }
-        [[nodiscard]] ID3D11ShaderResourceView* GetSRV() const { return m_srv.Get(); }
-        [[nodiscard]] bool IsValid() const { return m_srv != nullptr; }
+        [[nodiscard]] ID3D11ShaderResourceView* GetSRV() const { return m_srv; }
+        [[nodiscard]] bool IsValid() const { return m_sortId != 0; }
+        // Unique per created resource, 0 when empty; used for batch sort keys
+        [[nodiscard]] std::uint32_t SortId() const { return m_sortId; }
+
+        // RGBA8 rows, only kept for CPU-only textures
+        [[nodiscard]] const std::vector<std::uint8_t>& Pixels() const { return m_pixels; }
+        [[nodiscard]] bool IsCpuOnly() const { return IsValid() && m_srv == nullptr; }
+        // Sampling decodes sRGB to linear, as the GPU does for *_SRGB formats
+        [[nodiscard]] bool IsSRGB() const { return m_srgb; }
 
     private:
-        Microsoft::WRL::ComPtr<ID3D11Texture2D>        m_texture;
-        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_srv;
+        bool Upload(ID3D11Device* device, int width, int height, const std::uint8_t* pixels, bool srgb);
+
+        ID3D11Texture2D*          m_texture = nullptr;
+        ID3D11ShaderResourceView* m_srv = nullptr;
+        std::vector<std::uint8_t> m_pixels;
+        std::uint32_t m_sortId = 0;
         int m_width = 0;
         int m_height = 0;
+        bool m_srgb = false;
     };
 
 } // namespace KibakoEngine
-
@@ -6,12 +6,14 @@
 
 #include <DirectXMath.h>
 
+#include "KibakoEngine/Renderer/SpriteCulling.h"
 #include "KibakoEngine/Renderer/SpriteTypes.h"
 #include "KibakoEngine/Renderer/Texture2D.h"
 #include "KibakoEngine/Collision/Collision2D.h"
 
 namespace KibakoEngine {
 
+    class Camera2D;
     class SpriteBatch2D;
 
     using EntityID = std::uint32_t;
@@ -43,6 +45,12 @@ namespace KibakoEngine {
         CollisionComponent2D collision;
     };
 
+    struct SceneRenderStats
+    {
+        std::uint32_t visible = 0;
+        std::uint32_t culled = 0;
+    };
+
     class Scene2D
     {
     public:
@@ -62,10 +70,20 @@ namespace KibakoEngine {
         void Update(float dt);
 
         void Render(SpriteBatch2D& batch) const;
+        // Only entities overlapping the camera view reach the batch
+        void Render(SpriteBatch2D& batch, const Camera2D& camera) const;
+
+        [[nodiscard]] const SceneRenderStats& LastRenderStats() const { return m_renderStats; }
 
     private:
         EntityID m_nextID = 1;
         std::vector<Entity2D> m_entities;
+
+        // Culling scratch reused across frames
+        mutable SpriteBounds2D             m_cullBounds;
+        mutable std::vector<std::uint32_t> m_cullEntities;
+        mutable std::vector<std::uint32_t> m_visible;
+        mutable SceneRenderStats           m_renderStats{};
     };
 
 } // namespace KibakoEngine
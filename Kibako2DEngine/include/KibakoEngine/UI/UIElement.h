@@ -9,6 +9,7 @@
 #include <DirectXMath.h>
 
 #include "KibakoEngine/Core/Input.h"
+#include "KibakoEngine/Core/MemoryTracker.h"
 #include "KibakoEngine/Renderer/SpriteTypes.h"
 #include "KibakoEngine/UI/UIStyle.h"
 
@@ -64,6 +65,7 @@ namespace KibakoEngine {
         template<typename T, typename... Args>
         T& EmplaceChild(Args&&... args)
         {
+            KBK_MEMORY_TAG(UI);
             auto element = std::make_unique<T>(std::forward<Args>(args)...);
             T& ref = *element;
             AddChild(std::move(element));
@@ -2,6 +2,8 @@
 #include "KibakoEngine/Collision/Collision2D.h"
 #include "KibakoEngine/Scene/Scene2D.h"
 
+#include "KibakoEngine/Core/PerfCounters.h"
+
 namespace KibakoEngine {
 
     bool Intersects(const CircleCollider2D& c1, const Transform2D& t1,
@@ -39,4 +41,9 @@ namespace KibakoEngine {
         return (ax1 <= bx2 && ax2 >= bx1 && ay1 <= by2 && ay2 >= by1);
     }
 
+    void CountPairsTested(std::uint64_t pairs)
+    {
+        KBK_PERF_COUNT("collision.pairsTested", pairs);
+    }
+
 } // namespace KibakoEngine
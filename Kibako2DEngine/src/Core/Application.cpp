@@ -1,17 +1,27 @@
 // Engine application loop
 #include "KibakoEngine/Core/Application.h"
 
+#include "KibakoEngine/Core/BinaryLog.h"
 #include "KibakoEngine/Core/Debug.h"
 #include "KibakoEngine/Core/DebugUI.h"
 #include "KibakoEngine/Core/GameServices.h"
 #include "KibakoEngine/Core/Layer.h"
 #include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/MemoryTracker.h"
+#include "KibakoEngine/Core/PerfCounters.h"
 #include "KibakoEngine/Core/Profiler.h"
+#include "KibakoEngine/Renderer/RendererNull.h"
+#include "KibakoEngine/Renderer/RendererSoftware.h"
+
+#if defined(_WIN32)
+#    include "KibakoEngine/Renderer/RendererD3D11.h"
+#endif
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_syswm.h>
 
 #include <algorithm>
+#include <memory>
 
 namespace KibakoEngine {
 
@@ -19,6 +29,10 @@ namespace KibakoEngine {
     {
         constexpr const char* kLogChannel = "App";
 
+        // F3 trace capture
+        constexpr std::uint32_t kTraceCaptureFrames = 300;
+        constexpr const char* kTraceCapturePath = "kibako_trace.json";
+
         void AnnounceBreakpointStop()
         {
             const char* reason = LastBreakpointMessage();
@@ -64,7 +78,9 @@ namespace KibakoEngine {
             return false;
         }
 
+#if defined(_WIN32)
         m_hwnd = info.info.win.window;
+#endif
         KBK_ASSERT(m_hwnd != nullptr, "SDL window did not provide a valid HWND");
         return true;
     }
@@ -108,10 +124,18 @@ namespace KibakoEngine {
     bool Application::Init(int width, int height, const char* title)
     {
         KBK_PROFILE_SCOPE("AppInit");
+        Profiler::SetThreadName("Main");
 
         if (m_running)
             return true;
 
+#if !defined(_WIN32)
+        KBK_UNUSED(width);
+        KBK_UNUSED(height);
+        KBK_UNUSED(title);
+        KbkError(kLogChannel, "Windowed mode needs Direct3D 11; use InitHeadless on this platform");
+        return false;
+#else
         if (!CreateWindowSDL(width, height, title))
             return false;
 
@@ -120,18 +144,21 @@ namespace KibakoEngine {
         m_pendingHeight = m_height;
         KbkLog(kLogChannel, "Drawable size: %dx%d", m_width, m_height);
 
-        if (!m_renderer.Init(m_hwnd,
+        auto renderer = std::make_unique<RendererD3D11>();
+        if (!renderer->Init(m_hwnd,
             static_cast<std::uint32_t>(m_width),
             static_cast<std::uint32_t>(m_height))) {
-            Shutdown();
+            DestroyWindowSDL();
             return false;
         }
 
-#if KBK_DEBUG_BUILD
-        DebugUI::Init(m_window, m_renderer.GetDevice(), m_renderer.GetImmediateContext());
+#if KBK_ENABLE_DEBUG_UI
+        DebugUI::Init(m_window, renderer->GetDevice(), renderer->GetImmediateContext());
 #endif
 
-        m_assets.Init(m_renderer.GetDevice());
+        m_renderer = std::move(renderer);
+
+        m_assets.Init(m_renderer->GetDevice());
         KbkLog(kLogChannel, "AssetManager initialized");
 
         GameServices::Init();
@@ -139,6 +166,52 @@ namespace KibakoEngine {
         m_running = true;
         m_fullscreen = (SDL_GetWindowFlags(m_window) & SDL_WINDOW_FULLSCREEN_DESKTOP) != 0u;
         return true;
+#endif
+    }
+
+    bool Application::InitHeadless(int width, int height, HeadlessBackend backend)
+    {
+        KBK_PROFILE_SCOPE("AppInitHeadless");
+        Profiler::SetThreadName("Main");
+
+        if (m_running)
+            return true;
+
+        if (width <= 0 || height <= 0) {
+            KbkError(kLogChannel, "InitHeadless requires a positive size (%dx%d)", width, height);
+            return false;
+        }
+
+        m_width = width;
+        m_height = height;
+        m_pendingWidth = width;
+        m_pendingHeight = height;
+
+        const auto w = static_cast<std::uint32_t>(width);
+        const auto h = static_cast<std::uint32_t>(height);
+        if (backend == HeadlessBackend::Software) {
+            auto renderer = std::make_unique<RendererSoftware>();
+            if (!renderer->Init(w, h))
+                return false;
+            m_renderer = std::move(renderer);
+        }
+        else {
+            auto renderer = std::make_unique<RendererNull>();
+            if (!renderer->Init(w, h))
+                return false;
+            m_renderer = std::move(renderer);
+        }
+
+        // No device: textures stay on the CPU
+        m_assets.Init(nullptr);
+        GameServices::Init();
+
+        m_headless = true;
+        m_quitRequested = false;
+        m_frameCount = 0;
+        m_running = true;
+        KbkLog(kLogChannel, "Headless mode: %dx%d (%s backend)", m_width, m_height, m_renderer->Name());
+        return true;
     }
 
     void Application::Shutdown()
@@ -148,6 +221,11 @@ namespace KibakoEngine {
         if (!m_running)
             return;
 
+        m_renderThread.Stop();
+
+        m_recorder.Close();
+        StopReplay();
+
         for (Layer* layer : m_layers) {
             if (layer)
                 layer->OnDetach();
@@ -158,15 +236,25 @@ namespace KibakoEngine {
 
         GameServices::Shutdown();
 
-#if KBK_DEBUG_BUILD
+#if KBK_ENABLE_DEBUG_UI
         DebugUI::Shutdown();
 #endif
 
-        m_renderer.Shutdown();
-        DestroyWindowSDL();
+        if (m_renderer) {
+            m_renderer->Shutdown();
+            m_renderer.reset();
+        }
+        if (!m_headless)
+            DestroyWindowSDL();
 
+        m_frameStats.LogSummary();
+        MemoryTracker::LogSummary();
+        PerfCounters::LogSummary();
+        PerfCounters::CloseJsonLines();
         Profiler::Flush();
+        FlushLog();
 
+        m_headless = false;
         m_running = false;
     }
 
@@ -180,15 +268,44 @@ namespace KibakoEngine {
         if (HasBreakpointRequest())
             return false;
 
+        if (m_quitRequested)
+            return false;
+
+        if (m_frameLimit != 0 && m_frameCount >= m_frameLimit) {
+            // No frame follows the last one to close it
+            m_frameStats.EndFrame();
+            return false;
+        }
+        ++m_frameCount;
+
         Profiler::BeginFrame();
+        MemoryTracker::BeginFrame();
+        PerfCounters::BeginFrame();
+        BinaryLog::BeginFrame();
+        m_frameStats.BeginFrame();
+        FrameStats::PhaseScope eventsPhase(m_frameStats, FramePhase::Events);
 
         m_input.BeginFrame();
-        m_time.Tick();
+        if (m_player.IsOpen()) {
+            if (!AdvanceReplay())
+                return false;
+        }
+        else if (m_fixedTimeStep > 0.0) {
+            m_time.TickFixed(m_fixedTimeStep);
+        }
+        else {
+            m_time.Tick();
+        }
+
+        if (m_headless) {
+            FinishInputFrame();
+            return true;
+        }
 
         SDL_Event evt{};
         while (SDL_PollEvent(&evt) != 0) {
 
-#if KBK_DEBUG_BUILD
+#if KBK_ENABLE_DEBUG_UI
             DebugUI::ProcessEvent(evt);
 #endif
 
@@ -230,9 +347,87 @@ namespace KibakoEngine {
         }
 
         ApplyPendingResize();
+        FinishInputFrame();
+        return true;
+    }
+
+    bool Application::StartRecording(const std::string& path, bool withSprites)
+    {
+        ReplayHeader header{};
+        header.width = static_cast<std::uint32_t>(m_width);
+        header.height = static_cast<std::uint32_t>(m_height);
+        header.hasSprites = withSprites;
+        return m_recorder.Open(path, header);
+    }
+
+    bool Application::StartReplay(const std::string& path, double fixedStepSeconds)
+    {
+        if (!m_player.Open(path))
+            return false;
+
+        const ReplayHeader& header = m_player.Header();
+        if (header.width != static_cast<std::uint32_t>(m_width) || header.height != static_cast<std::uint32_t>(m_height)) {
+            KbkWarn(kLogChannel, "Replay was recorded at %ux%u, running at %dx%d; sprite hashes will not match",
+                header.width, header.height, m_width, m_height);
+        }
+
+        m_replayFixedStep = fixedStepSeconds;
+        m_replayMismatches = 0;
+        return true;
+    }
+
+    bool Application::AdvanceReplay()
+    {
+        if (!m_player.ReadFrame(m_replayFrame)) {
+            StopReplay();
+            return false;
+        }
+
+        m_time.TickFixed(m_replayFixedStep > 0.0 ? m_replayFixedStep : m_replayFrame.deltaSeconds);
         return true;
     }
 
+    void Application::FinishInputFrame()
+    {
+        // Replayed input wins over whatever SDL delivered this frame
+        if (m_player.IsOpen())
+            m_input.Override(m_replayFrame.input);
+
+        if (m_recorder.IsOpen()) {
+            InputSnapshot snapshot;
+            m_input.Capture(snapshot);
+            m_recorder.BeginFrame(m_time.DeltaSeconds(), snapshot);
+        }
+    }
+
+    void Application::TrackFrameSprites(std::span<const SpriteCommand> sprites)
+    {
+        if (m_recorder.IsOpen())
+            m_recorder.EndFrame(sprites);
+
+        if (!m_player.IsOpen())
+            return;
+
+        // Recorded and replayed frames must take the same path to compare equal
+        const bool matches = sprites.size() == m_replayFrame.spriteCount
+            && HashSpriteCommands(sprites) == m_replayFrame.spriteHash;
+        if (!matches && m_replayMismatches++ == 0) {
+            KbkWarn(kLogChannel, "Replay diverged at frame %llu: %zu sprites drawn, %u recorded",
+                static_cast<unsigned long long>(m_player.FramesRead() - 1), sprites.size(), m_replayFrame.spriteCount);
+        }
+    }
+
+    void Application::StopReplay()
+    {
+        if (!m_player.IsOpen())
+            return;
+
+        KbkLog(kLogChannel, "Replay finished after %llu frames, %llu with different sprite output",
+            static_cast<unsigned long long>(m_player.FramesRead()), static_cast<unsigned long long>(m_replayMismatches));
+        m_player.Close();
+        m_input.StopOverride();
+    }
+
     void Application::ApplyPendingResize()
     {
         if (!m_hasPendingResize)
@@ -257,7 +452,14 @@ namespace KibakoEngine {
         }
 
         KbkLog(kLogChannel, "Resize -> %dx%d", m_width, m_height);
-        m_renderer.OnResize(static_cast<std::uint32_t>(m_width),
+
+        // The render thread resizes the swap chain when it sees the new size in a command list
+        if (m_renderThread.IsRunning()) {
+            m_renderer->Camera().SetViewport(static_cast<float>(m_width), static_cast<float>(m_height));
+            return;
+        }
+
+        m_renderer->OnResize(static_cast<std::uint32_t>(m_width),
             static_cast<std::uint32_t>(m_height));
     }
 
@@ -292,28 +494,58 @@ namespace KibakoEngine {
     void Application::BeginFrame(const float clearColor[4])
     {
         KBK_PROFILE_SCOPE("BeginFrame");
-        m_renderer.BeginFrame(clearColor);
+        m_renderer->BeginFrame(clearColor);
     }
 
     void Application::EndFrame(bool waitForVSync)
     {
         KBK_PROFILE_SCOPE("EndFrame");
-        m_renderer.EndFrame(waitForVSync);
+        FrameStats::PhaseScope presentPhase(m_frameStats, FramePhase::Present);
+        m_renderer->EndFrame(waitForVSync);
         m_input.EndFrame();
     }
 
+    void Application::UpdateLayers()
+    {
+        FrameStats::PhaseScope updatePhase(m_frameStats, FramePhase::Update);
+        const double rawDt = m_time.DeltaSeconds();
+        GameServices::Update(rawDt);
+        const float scaledDt = static_cast<float>(GameServices::GetScaledDeltaTime());
+
+        for (Layer* layer : m_layers) {
+            if (layer)
+                layer->OnUpdate(scaledDt);
+        }
+    }
+
+    void Application::RenderLayers(SpriteBatch2D& batch)
+    {
+        for (Layer* layer : m_layers) {
+            if (layer)
+                layer->OnRender(batch);
+        }
+    }
+
     void Application::Run(const float clearColor[4], bool waitForVSync)
     {
         KBK_ASSERT(m_running, "Run() called before Init()");
 
+        if (m_threadedRendering) {
+            RunThreaded(clearColor, waitForVSync);
+            return;
+        }
+
         while (PumpEvents()) {
 
-#if KBK_DEBUG_BUILD
+#if KBK_ENABLE_DEBUG_UI
             if (m_input.KeyPressed(SDL_SCANCODE_F2)) {
                 DebugUI::ToggleEnabled();
             }
 #endif
 
+            if (m_input.KeyPressed(SDL_SCANCODE_F3))
+                Profiler::BeginCapture(kTraceCaptureFrames, kTraceCapturePath);
+
             if (ConsumeBreakpointRequest()) {
                 AnnounceBreakpointStop();
                 break;
@@ -321,44 +553,103 @@ namespace KibakoEngine {
 
             KBK_PROFILE_FRAME("Frame");
 
-            const double rawDt = m_time.DeltaSeconds();
-            GameServices::Update(rawDt);
-            const float scaledDt = static_cast<float>(GameServices::GetScaledDeltaTime());
+            UpdateLayers();
 
-            for (Layer* layer : m_layers) {
-                if (layer)
-                    layer->OnUpdate(scaledDt);
-            }
+            {
+                FrameStats::PhaseScope renderPhase(m_frameStats, FramePhase::Render);
 
-#if KBK_DEBUG_BUILD
-            DebugUI::SetVSyncEnabled(waitForVSync);
+#if KBK_ENABLE_DEBUG_UI
+                DebugUI::SetVSyncEnabled(waitForVSync);
 
-            DebugUI::NewFrame();
+                DebugUI::NewFrame();
 #endif
 
-            BeginFrame(clearColor);
+                BeginFrame(clearColor);
 
-            SpriteBatch2D& batch = m_renderer.Batch();
-            batch.Begin(m_renderer.Camera().GetViewProjectionT());
+                SpriteBatch2D& batch = m_renderer->Batch();
+                batch.Begin(m_renderer->Camera().GetViewProjectionT());
+                RenderLayers(batch);
+                batch.End();
+                TrackFrameSprites(batch.FrameCommands());
 
-            for (Layer* layer : m_layers) {
-                if (layer)
-                    layer->OnRender(batch);
+#if KBK_ENABLE_DEBUG_UI
+                DebugUI::Render();
+#endif
             }
 
-            batch.End();
+            EndFrame(waitForVSync);
 
-#if KBK_DEBUG_BUILD
-            const SpriteBatchStats& batchStats = batch.Stats();
-            DebugUI::RenderStats rs{};
-            rs.drawCalls = batchStats.drawCalls;
-            rs.spritesSubmitted = batchStats.spritesSubmitted;
-            DebugUI::SetRenderStats(rs);
+            if (ConsumeBreakpointRequest()) {
+                AnnounceBreakpointStop();
+                break;
+            }
+        }
 
-            DebugUI::Render();
-#endif
+        if (ConsumeBreakpointRequest()) {
+            AnnounceBreakpointStop();
+        }
+    }
 
-            EndFrame(waitForVSync);
+    void Application::RunThreaded(const float clearColor[4], bool waitForVSync)
+    {
+        const bool started = m_renderThread.Start([this](const RenderCommandList& list) {
+            ExecuteCommandList(list);
+        });
+        if (!started) {
+            KbkError(kLogChannel, "Failed to start render thread");
+            return;
+        }
+
+        // ImGui shares the immediate context, so the overlay stays off in this mode
+        KbkLog(kLogChannel, "Threaded rendering enabled (DebugUI overlay disabled)");
+
+        SpriteBatch2D& batch = m_renderer->Batch();
+        RenderFrameQueue& queue = m_renderThread.Queue();
+        std::uint64_t frameIndex = 0;
+
+        while (PumpEvents()) {
+            if (m_input.KeyPressed(SDL_SCANCODE_F3))
+                Profiler::BeginCapture(kTraceCaptureFrames, kTraceCapturePath);
+
+            if (ConsumeBreakpointRequest()) {
+                AnnounceBreakpointStop();
+                break;
+            }
+
+            KBK_PROFILE_FRAME("Frame");
+
+            UpdateLayers();
+
+            // Waiting for a free command list is the render thread's backpressure
+            RenderCommandList* list = nullptr;
+            {
+                FrameStats::PhaseScope presentPhase(m_frameStats, FramePhase::Present);
+                list = queue.BeginRecord();
+            }
+            if (!list)
+                break;
+
+            {
+                FrameStats::PhaseScope renderPhase(m_frameStats, FramePhase::Render);
+                list->SetFrameIndex(frameIndex++);
+                list->SetViewport(static_cast<std::uint32_t>(m_width), static_cast<std::uint32_t>(m_height));
+                list->SetClearColor(clearColor);
+                list->SetVSync(waitForVSync);
+                list->SetViewProjection(m_renderer->Camera().GetViewProjectionT());
+
+                batch.BeginRecord(*list);
+                RenderLayers(batch);
+                batch.End();
+                // Recordings hash the draw-order stream, which the render thread only builds later
+                if (m_recorder.IsOpen() || m_player.IsOpen()) {
+                    m_trackedSprites.assign(list->Sprites().begin(), list->Sprites().end());
+                    SpriteBatch2D::PrepareForDraw(m_trackedSprites);
+                    TrackFrameSprites(m_trackedSprites);
+                }
+
+                queue.Submit();
+            }
+            m_input.EndFrame();
 
             if (ConsumeBreakpointRequest()) {
                 AnnounceBreakpointStop();
@@ -366,11 +657,21 @@ namespace KibakoEngine {
             }
         }
 
+        m_renderThread.Stop();
+
         if (ConsumeBreakpointRequest()) {
             AnnounceBreakpointStop();
         }
     }
 
+    void Application::ExecuteCommandList(const RenderCommandList& list)
+    {
+        m_renderer->ResizeTargets(list.ViewportWidth(), list.ViewportHeight());
+        m_renderer->BeginFrame(list.ClearColor());
+        m_renderer->Batch().Submit(list);
+        m_renderer->EndFrame(list.WaitForVSync());
+    }
+
     void Application::PushLayer(Layer* layer)
     {
         if (!layer)
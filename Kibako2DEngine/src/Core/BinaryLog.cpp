@@ -0,0 +1,707 @@
+// Deferred binary logging: raw arguments now, printf formatting offline
+#include "KibakoEngine/Core/BinaryLog.h"
+
+#include "KibakoEngine/Core/CrashLog.h"
+#include "KibakoEngine/Core/Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdarg>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace KibakoEngine {
+
+    namespace
+    {
+        constexpr const char* kLogChannel = "BinaryLog";
+
+        constexpr char          kMagic[4] = { 'K', 'B', 'K', 'L' };
+        constexpr std::uint32_t kVersion = 1;
+        // Magic, version and open time precede the tick rate, which Close rewrites
+        constexpr long kTickRateOffset = 4 + sizeof(std::uint32_t) + sizeof(std::int64_t);
+
+        constexpr std::uint8_t kTagSite = 1;
+        constexpr std::uint8_t kTagEntry = 2;
+
+        // Tag, site id and ticks since open
+        constexpr std::size_t kEntryHeaderBytes = 1 + sizeof(std::uint32_t) + sizeof(std::int64_t);
+        // Per thread; a full buffer is written out by the thread that filled it
+        constexpr std::size_t kThreadBufferBytes = 64u * 1024u;
+
+        struct ThreadBuffer
+        {
+            std::atomic<bool>                         busy{ false };
+            std::uint32_t                             epoch = 0;  // Log file the contents belong to
+            std::size_t                               size = 0;
+            std::array<std::uint8_t, kThreadBufferBytes> bytes;
+        };
+
+        struct LogState
+        {
+            std::mutex                 fileMutex;
+            std::FILE*                 file = nullptr;
+            std::uint32_t              lastEpoch = 0;
+            std::uint32_t              nextSiteId = 1;
+
+            std::mutex                                 buffersMutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+            // Read on every call; zero while closed
+            std::atomic<std::uint32_t> epoch{ 0 };
+            std::atomic<std::int64_t>  openedTicks{ 0 };
+            std::atomic<std::int64_t>  lastFlushNs{ 0 };
+
+            // Under fileMutex
+            std::int64_t               openedNs = 0;
+        };
+
+        LogState& State()
+        {
+            static LogState s_state;
+            return s_state;
+        }
+
+        thread_local ThreadBuffer* t_buffer = nullptr;
+        // Records from other thread_local destructors after the buffer was freed are dropped
+        thread_local bool t_bufferFreed = false;
+
+        void FlushBuffer(LogState& state, ThreadBuffer& buffer);
+
+        // Writes out and frees the thread's buffer when the thread exits
+        struct BufferOwner
+        {
+            ~BufferOwner()
+            {
+                ThreadBuffer* buffer = t_buffer;
+                t_buffer = nullptr;
+                t_bufferFreed = true;
+                if (!buffer)
+                    return;
+
+                LogState& state = State();
+                std::lock_guard<std::mutex> guard(state.buffersMutex);
+                while (buffer->busy.exchange(true, std::memory_order_acquire))
+                    std::this_thread::yield();
+                FlushBuffer(state, *buffer);
+                std::erase_if(state.buffers, [buffer](const std::unique_ptr<ThreadBuffer>& owned) {
+                    return owned.get() == buffer;
+                });
+            }
+        };
+
+        thread_local BufferOwner t_bufferOwner;
+
+        // Buffers are owned by the state, so Flush and Close can reach them from any thread
+        ThreadBuffer* LocalBuffer()
+        {
+            if (!t_buffer && !t_bufferFreed) {
+                KBK_UNUSED(t_bufferOwner);  // Constructs the owner, which frees the buffer at thread exit
+                auto buffer = std::make_unique<ThreadBuffer>();
+                t_buffer = buffer.get();
+
+                LogState& state = State();
+                std::lock_guard<std::mutex> guard(state.buffersMutex);
+                state.buffers.push_back(std::move(buffer));
+            }
+            return t_buffer;
+        }
+
+        std::int64_t SteadyNanoseconds()
+        {
+            const auto now = std::chrono::steady_clock::now().time_since_epoch();
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+        }
+
+        // The profiler's clock: TSC where available, a fraction of steady_clock's cost
+        std::int64_t NowTicks()
+        {
+#if KBK_ENABLE_PROFILING
+            return Profiler::Detail::NowTicks();
+#else
+            return SteadyNanoseconds();
+#endif
+        }
+
+        // The profiler's calibrated rate; Close replaces it with one measured over the whole log
+        double NsPerTick()
+        {
+#if KBK_ENABLE_PROFILING
+            return Profiler::Detail::NsPerTick();
+#else
+            return 1.0;
+#endif
+        }
+
+        template <typename T>
+        void Put(std::vector<std::uint8_t>& out, const T& value)
+        {
+            const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        void PutString(std::vector<std::uint8_t>& out, const char* text)
+        {
+            const auto length = static_cast<std::uint16_t>(BinaryLog::Detail::StringBytes(text));
+            Put(out, length);
+            out.insert(out.end(), text, text + length);
+        }
+
+        // Caller holds fileMutex
+        void WriteChunk(LogState& state, const std::uint8_t* data, std::size_t size)
+        {
+            if (state.file && size > 0)
+                std::fwrite(data, 1, size, state.file);
+        }
+
+        void FlushBuffer(LogState& state, ThreadBuffer& buffer)
+        {
+            std::lock_guard<std::mutex> guard(state.fileMutex);
+            if (buffer.epoch == state.lastEpoch)
+                WriteChunk(state, buffer.bytes.data(), buffer.size);
+            buffer.size = 0;
+        }
+
+        // Crash callback: writes what it can without blocking. A buffer whose thread is
+        // mid-record, or a lock held by the crashing thread, loses those records.
+        void FlushOnCrash()
+        {
+            LogState& state = State();
+            if (state.epoch.load(std::memory_order_acquire) == 0)
+                return;
+            if (!state.buffersMutex.try_lock())
+                return;
+            if (state.fileMutex.try_lock()) {
+                for (const auto& buffer : state.buffers) {
+                    if (buffer->busy.exchange(true, std::memory_order_acquire))
+                        continue;
+                    if (buffer->epoch == state.lastEpoch)
+                        WriteChunk(state, buffer->bytes.data(), buffer->size);
+                    buffer->size = 0;
+                    buffer->busy.store(false, std::memory_order_release);
+                }
+                if (state.file)
+                    std::fflush(state.file);
+                state.fileMutex.unlock();
+            }
+            state.buffersMutex.unlock();
+        }
+
+        // Written once per site and file, before any entry that refers to it
+        bool DefineSite(BinaryLog::Detail::Site& site,
+                        const char* fmt,
+                        const BinaryLogArg* types,
+                        std::size_t count,
+                        std::uint32_t epoch)
+        {
+            LogState& state = State();
+            std::lock_guard<std::mutex> guard(state.fileMutex);
+            if (state.epoch.load(std::memory_order_acquire) != epoch || !state.file)
+                return false;
+            if (site.epoch.load(std::memory_order_acquire) == epoch)
+                return true;
+
+            if (site.id == 0)
+                site.id = state.nextSiteId++;
+
+            std::vector<std::uint8_t> record;
+            Put(record, kTagSite);
+            Put(record, site.id);
+            Put(record, static_cast<std::uint8_t>(site.level));
+            Put(record, static_cast<std::int32_t>(site.line));
+            Put(record, static_cast<std::uint8_t>(count));
+            for (std::size_t i = 0; i < count; ++i)
+                Put(record, static_cast<std::uint8_t>(types[i]));
+            PutString(record, site.channel ? site.channel : "");
+            PutString(record, site.file ? site.file : "");
+            PutString(record, site.function ? site.function : "");
+            PutString(record, fmt ? fmt : "");
+            WriteChunk(state, record.data(), record.size());
+
+            site.epoch.store(epoch, std::memory_order_release);
+            return true;
+        }
+
+        struct DecodedArg
+        {
+            BinaryLogArg  type = BinaryLogArg::Int;
+            std::uint64_t bits = 0;
+            std::string   text;
+        };
+
+        std::int64_t AsInt(const DecodedArg& arg)
+        {
+            if (arg.type == BinaryLogArg::Double) {
+                double value = 0.0;
+                std::memcpy(&value, &arg.bits, sizeof(value));
+                return static_cast<std::int64_t>(value);
+            }
+            return static_cast<std::int64_t>(arg.bits);
+        }
+
+        double AsDouble(const DecodedArg& arg)
+        {
+            if (arg.type == BinaryLogArg::Double) {
+                double value = 0.0;
+                std::memcpy(&value, &arg.bits, sizeof(value));
+                return value;
+            }
+            if (arg.type == BinaryLogArg::Int)
+                return static_cast<double>(static_cast<std::int64_t>(arg.bits));
+            return static_cast<double>(arg.bits);
+        }
+
+        void AppendFormatted(std::string& out, const char* spec, ...)
+        {
+            char buffer[kMaxBinaryLogString * 2];
+            std::va_list args;
+            va_start(args, spec);
+            const int written = std::vsnprintf(buffer, sizeof(buffer), spec, args);
+            va_end(args);
+            if (written > 0)
+                out.append(buffer, std::min(static_cast<std::size_t>(written), sizeof(buffer) - 1));
+        }
+
+        // printf semantics over the stored arguments. The length modifiers in the
+        // format are replaced by the stored width, so "%u" and "%zu" decode alike.
+        std::string FormatMessage(const std::string& format, const std::vector<DecodedArg>& args)
+        {
+            std::string out;
+            std::size_t next = 0;
+            const DecodedArg missing{};
+
+            auto take = [&]() -> const DecodedArg& {
+                return next < args.size() ? args[next++] : missing;
+            };
+
+            for (std::size_t i = 0; i < format.size(); ++i) {
+                if (format[i] != '%') {
+                    out.push_back(format[i]);
+                    continue;
+                }
+                if (i + 1 < format.size() && format[i + 1] == '%') {
+                    out.push_back('%');
+                    ++i;
+                    continue;
+                }
+
+                std::string spec = "%";
+                std::size_t j = i + 1;
+                while (j < format.size() && format[j] != '\0' && std::strchr("-+ #0", format[j]))
+                    spec.push_back(format[j++]);
+
+                for (int part = 0; part < 2; ++part) {
+                    if (part == 1) {
+                        if (j >= format.size() || format[j] != '.')
+                            break;
+                        spec.push_back(format[j++]);
+                    }
+                    if (j < format.size() && format[j] == '*') {
+                        spec += std::to_string(AsInt(take()));
+                        ++j;
+                    }
+                    while (j < format.size() && format[j] >= '0' && format[j] <= '9')
+                        spec.push_back(format[j++]);
+                }
+
+                while (j < format.size() && format[j] != '\0' && std::strchr("hljztLqI0123456789", format[j]))
+                    ++j;
+                if (j >= format.size())
+                    break;
+
+                const char conversion = format[j];
+                i = j;
+
+                switch (conversion) {
+                case 'd':
+                case 'i':
+                    AppendFormatted(out, (spec + "lld").c_str(), static_cast<long long>(AsInt(take())));
+                    break;
+                case 'u':
+                case 'x':
+                case 'X':
+                case 'o':
+                    AppendFormatted(out, (spec + "ll" + conversion).c_str(), static_cast<unsigned long long>(AsInt(take())));
+                    break;
+                case 'c':
+                    AppendFormatted(out, (spec + "c").c_str(), static_cast<int>(AsInt(take())));
+                    break;
+                case 'f':
+                case 'F':
+                case 'e':
+                case 'E':
+                case 'g':
+                case 'G':
+                case 'a':
+                case 'A':
+                    AppendFormatted(out, (spec + conversion).c_str(), AsDouble(take()));
+                    break;
+                case 's': {
+                    const DecodedArg& arg = take();
+                    AppendFormatted(out, (spec + "s").c_str(), arg.type == BinaryLogArg::String ? arg.text.c_str() : "<not a string>");
+                    break;
+                }
+                case 'p':
+                    AppendFormatted(out, "0x%llx", static_cast<unsigned long long>(take().bits));
+                    break;
+                default:
+                    out += spec;
+                    out.push_back(conversion);
+                    break;
+                }
+            }
+            return out;
+        }
+
+        template <typename T>
+        bool Get(std::FILE* file, T& out)
+        {
+            return std::fread(&out, sizeof(T), 1, file) == 1;
+        }
+
+        bool GetString(std::FILE* file, std::string& out)
+        {
+            std::uint16_t length = 0;
+            if (!Get(file, length))
+                return false;
+            out.resize(length);
+            return length == 0 || std::fread(out.data(), 1, length, file) == length;
+        }
+    } // namespace
+
+    namespace BinaryLog {
+
+        bool Open(const char* path, LogLevel minimumLevel)
+        {
+            Close();
+
+            if (!path || path[0] == '\0')
+                return false;
+
+            std::FILE* file = std::fopen(path, "wb");
+            if (!file) {
+                KbkError(kLogChannel, "Failed to open %s for writing", path);
+                return false;
+            }
+
+            const std::int64_t openedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            const std::int64_t openedTicks = NowTicks();
+            const std::int64_t openedNs = SteadyNanoseconds();
+            const double nsPerTick = NsPerTick();
+            std::fwrite(kMagic, 1, sizeof(kMagic), file);
+            std::fwrite(&kVersion, sizeof(kVersion), 1, file);
+            std::fwrite(&openedMs, sizeof(openedMs), 1, file);
+            std::fwrite(&nsPerTick, sizeof(nsPerTick), 1, file);
+
+            static const bool crashFlushAdded = CrashLog::AddCrashCallback(&FlushOnCrash);
+            KBK_UNUSED(crashFlushAdded);
+
+            LogState& state = State();
+            {
+                std::lock_guard<std::mutex> guard(state.fileMutex);
+                state.file = file;
+                ++state.lastEpoch;
+                if (state.lastEpoch == 0)
+                    state.lastEpoch = 1;
+                state.openedNs = openedNs;
+                state.openedTicks.store(openedTicks, std::memory_order_relaxed);
+                state.lastFlushNs.store(openedNs, std::memory_order_relaxed);
+                Detail::g_minimumLevel.store(static_cast<std::uint8_t>(minimumLevel), std::memory_order_relaxed);
+                state.epoch.store(state.lastEpoch, std::memory_order_release);
+            }
+
+            KbkLog(kLogChannel, "Deferred log calls now go to %s", path);
+            return true;
+        }
+
+        void Close()
+        {
+            LogState& state = State();
+            if (state.epoch.exchange(0, std::memory_order_acq_rel) == 0)
+                return;
+            Detail::g_minimumLevel.store(Detail::kNotOpen, std::memory_order_relaxed);
+
+            // A thread mid-record holds its buffer; waiting for it keeps that record
+            {
+                std::lock_guard<std::mutex> guard(state.buffersMutex);
+                for (const auto& buffer : state.buffers) {
+                    while (buffer->busy.exchange(true, std::memory_order_acquire))
+                        std::this_thread::yield();
+                    FlushBuffer(state, *buffer);
+                    buffer->busy.store(false, std::memory_order_release);
+                }
+            }
+
+            std::lock_guard<std::mutex> guard(state.fileMutex);
+
+            const std::int64_t ticks = NowTicks() - state.openedTicks.load(std::memory_order_relaxed);
+            const std::int64_t ns = SteadyNanoseconds() - state.openedNs;
+            if (ticks > 0 && ns >= 100'000'000) {
+                const double nsPerTick = static_cast<double>(ns) / static_cast<double>(ticks);
+                if (std::fseek(state.file, kTickRateOffset, SEEK_SET) == 0)
+                    std::fwrite(&nsPerTick, sizeof(nsPerTick), 1, state.file);
+            }
+
+            const bool ok = std::ferror(state.file) == 0;
+            std::fclose(state.file);
+            state.file = nullptr;
+            if (!ok)
+                KbkError(kLogChannel, "Failed to write the binary log");
+        }
+
+        bool IsOpen()
+        {
+            return State().epoch.load(std::memory_order_relaxed) != 0;
+        }
+
+        void Flush()
+        {
+            LogState& state = State();
+            if (state.epoch.load(std::memory_order_acquire) == 0)
+                return;
+
+            state.lastFlushNs.store(SteadyNanoseconds(), std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> guard(state.buffersMutex);
+                for (const auto& buffer : state.buffers) {
+                    while (buffer->busy.exchange(true, std::memory_order_acquire))
+                        std::this_thread::yield();
+                    FlushBuffer(state, *buffer);
+                    buffer->busy.store(false, std::memory_order_release);
+                }
+            }
+
+            std::lock_guard<std::mutex> guard(state.fileMutex);
+            if (state.file)
+                std::fflush(state.file);
+        }
+
+        void BeginFrame()
+        {
+            LogState& state = State();
+            if (state.epoch.load(std::memory_order_relaxed) == 0)
+                return;
+
+            const std::int64_t sinceFlushNs = SteadyNanoseconds() - state.lastFlushNs.load(std::memory_order_relaxed);
+            if (sinceFlushNs >= static_cast<std::int64_t>(kFlushIntervalMs) * 1'000'000)
+                Flush();
+        }
+
+        bool Decode(const char* binaryPath, const char* textPath)
+        {
+            BinaryLogReader reader;
+            if (!reader.Open(binaryPath))
+                return false;
+
+            std::vector<BinaryLogEntry> entries;
+            BinaryLogEntry entry;
+            while (reader.Next(entry))
+                entries.push_back(std::move(entry));
+
+            std::stable_sort(entries.begin(), entries.end(), [](const BinaryLogEntry& a, const BinaryLogEntry& b) {
+                return a.timeNs < b.timeNs;
+            });
+
+            std::FILE* file = std::fopen(textPath, "wb");
+            if (!file) {
+                KbkError(kLogChannel, "Failed to open %s for writing", textPath);
+                return false;
+            }
+
+            std::array<char, 1024> prefix;
+            for (const BinaryLogEntry& decoded : entries) {
+                KibakoEngine::Detail::FormatLogPrefix(prefix.data(), prefix.size(), decoded.level, decoded.timeMs,
+                    decoded.channel.c_str(), decoded.file.c_str(), decoded.line, decoded.function.c_str());
+                std::fputs(prefix.data(), file);
+                std::fputs(decoded.message.c_str(), file);
+                std::fputc('\n', file);
+            }
+
+            const bool ok = std::ferror(file) == 0;
+            std::fclose(file);
+            if (!ok) {
+                KbkError(kLogChannel, "Failed to write %s", textPath);
+                return false;
+            }
+
+            KbkLog(kLogChannel, "Decoded %zu entries from %s to %s", entries.size(), binaryPath, textPath);
+            return true;
+        }
+
+        namespace Detail
+        {
+            std::uint8_t* BeginRecord(Site& site,
+                                      const char* fmt,
+                                      const BinaryLogArg* types,
+                                      std::size_t count,
+                                      std::size_t payloadBytes)
+            {
+                LogState& state = State();
+                const std::uint32_t epoch = state.epoch.load(std::memory_order_acquire);
+                if (epoch == 0 || static_cast<std::uint8_t>(site.level) < g_minimumLevel.load(std::memory_order_relaxed))
+                    return nullptr;
+
+                if (site.epoch.load(std::memory_order_acquire) != epoch && !DefineSite(site, fmt, types, count, epoch))
+                    return nullptr;
+
+                const std::size_t recordBytes = kEntryHeaderBytes + payloadBytes;
+                if (recordBytes > kThreadBufferBytes)
+                    return nullptr;
+
+                ThreadBuffer* local = LocalBuffer();
+                if (!local)
+                    return nullptr;
+                ThreadBuffer& buffer = *local;
+                while (buffer.busy.exchange(true, std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                // Close may have run since the epoch was read; leftovers of an older file are stale
+                if (state.epoch.load(std::memory_order_acquire) != epoch) {
+                    buffer.busy.store(false, std::memory_order_release);
+                    return nullptr;
+                }
+                if (buffer.epoch != epoch) {
+                    buffer.epoch = epoch;
+                    buffer.size = 0;
+                }
+                if (buffer.size + recordBytes > kThreadBufferBytes)
+                    FlushBuffer(state, buffer);
+
+                std::uint8_t* out = buffer.bytes.data() + buffer.size;
+                buffer.size += recordBytes;
+
+                const std::int64_t ticks = NowTicks() - state.openedTicks.load(std::memory_order_relaxed);
+                out[0] = kTagEntry;
+                std::memcpy(out + 1, &site.id, sizeof(site.id));
+                std::memcpy(out + 1 + sizeof(site.id), &ticks, sizeof(ticks));
+                return out + kEntryHeaderBytes;
+            }
+
+            void EndRecord()
+            {
+                t_buffer->busy.store(false, std::memory_order_release);
+            }
+        } // namespace Detail
+
+    } // namespace BinaryLog
+
+    bool BinaryLogReader::Open(const char* path)
+    {
+        Close();
+
+        m_file = path ? std::fopen(path, "rb") : nullptr;
+        if (!m_file) {
+            KbkError(kLogChannel, "Failed to open binary log %s", path ? path : "<null>");
+            return false;
+        }
+
+        char magic[4] = {};
+        std::uint32_t version = 0;
+        const bool read = std::fread(magic, 1, sizeof(magic), m_file) == sizeof(magic)
+            && Get(m_file, version) && Get(m_file, m_openedMs) && Get(m_file, m_nsPerTick);
+        if (!read || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion) {
+            KbkError(kLogChannel, "%s is not a version %u binary log", path, kVersion);
+            Close();
+            return false;
+        }
+
+        m_sites.clear();
+        return true;
+    }
+
+    void BinaryLogReader::Close()
+    {
+        if (!m_file)
+            return;
+
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+
+    bool BinaryLogReader::Next(BinaryLogEntry& out)
+    {
+        if (!m_file)
+            return false;
+
+        std::uint8_t tag = 0;
+        while (Get(m_file, tag)) {
+            if (tag == kTagSite) {
+                if (!ReadSite())
+                    break;
+                continue;
+            }
+            if (tag == kTagEntry && ReadEntry(out))
+                return true;
+
+            KbkWarn(kLogChannel, "Damaged record; stopping");
+            break;
+        }
+        return false;
+    }
+
+    bool BinaryLogReader::ReadSite()
+    {
+        std::uint32_t id = 0;
+        std::uint8_t level = 0;
+        std::int32_t line = 0;
+        std::uint8_t count = 0;
+        if (!Get(m_file, id) || !Get(m_file, level) || !Get(m_file, line) || !Get(m_file, count))
+            return false;
+
+        SiteInfo site;
+        site.defined = true;
+        site.level = static_cast<LogLevel>(level);
+        site.line = line;
+        site.args.resize(count);
+        for (BinaryLogArg& arg : site.args) {
+            std::uint8_t type = 0;
+            if (!Get(m_file, type) || type > static_cast<std::uint8_t>(BinaryLogArg::Pointer))
+                return false;
+            arg = static_cast<BinaryLogArg>(type);
+        }
+
+        if (!GetString(m_file, site.channel) || !GetString(m_file, site.file)
+            || !GetString(m_file, site.function) || !GetString(m_file, site.format))
+            return false;
+
+        // Ids are dense from 1, so a huge one means damage
+        if (id == 0 || id > m_sites.size() + 65536)
+            return false;
+        if (id >= m_sites.size())
+            m_sites.resize(id + 1);
+        m_sites[id] = std::move(site);
+        return true;
+    }
+
+    bool BinaryLogReader::ReadEntry(BinaryLogEntry& out)
+    {
+        std::uint32_t id = 0;
+        std::int64_t ticks = 0;
+        if (!Get(m_file, id) || !Get(m_file, ticks) || id >= m_sites.size() || !m_sites[id].defined)
+            return false;
+
+        const SiteInfo& site = m_sites[id];
+        std::vector<DecodedArg> args(site.args.size());
+        for (std::size_t i = 0; i < args.size(); ++i) {
+            args[i].type = site.args[i];
+            const bool ok = site.args[i] == BinaryLogArg::String ? GetString(m_file, args[i].text) : Get(m_file, args[i].bits);
+            if (!ok)
+                return false;
+        }
+
+        out.timeNs = static_cast<std::int64_t>(static_cast<double>(ticks) * m_nsPerTick);
+        out.timeMs = m_openedMs + out.timeNs / 1000000;
+        out.level = site.level;
+        out.channel = site.channel;
+        out.file = site.file;
+        out.line = site.line;
+        out.function = site.function;
+        out.message = FormatMessage(site.format, args);
+        return true;
+    }
+
+} // namespace KibakoEngine
@@ -0,0 +1,629 @@
+// In-memory ring of recent log messages, written out when the process crashes
+#include "KibakoEngine/Core/CrashLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#    include <fcntl.h>
+#    include <io.h>
+#    include <sys/stat.h>
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <signal.h>
+#    include <unistd.h>
+#endif
+
+namespace KibakoEngine::CrashLog {
+
+    namespace
+    {
+        constexpr const char* kLogChannel = "CrashLog";
+
+        constexpr std::size_t kChannelSize = 24;
+        constexpr std::size_t kPathSize = 512;
+
+        // Sequence is 2 * position + 1 while the slot is written and 2 * position + 2
+        // once it is complete, so a dump can tell a finished message from a torn one
+        struct Slot
+        {
+            std::atomic<std::uint64_t> sequence{ 0 };
+            std::int64_t               timeMs = 0;
+            const char*                file = nullptr;
+            const char*                function = nullptr;
+            int                        line = 0;
+            LogLevel                   level = LogLevel::Trace;
+            char                       channel[kChannelSize] = {};
+            char                       text[Detail::kCrashTextSize] = {};
+        };
+
+        // Plain copy of a slot taken by the dump
+        struct Message
+        {
+            std::int64_t timeMs;
+            const char*  file;
+            const char*  function;
+            int          line;
+            LogLevel     level;
+            char         channel[kChannelSize];
+            char         text[Detail::kCrashTextSize];
+        };
+
+        struct Ring
+        {
+            std::unique_ptr<Slot[]>    slots;
+            std::uint64_t              mask = 0;
+            std::atomic<std::uint64_t> head{ 0 };
+            std::atomic<bool>          enabled{ false };
+            std::atomic<std::uint32_t> writers{ 0 };
+            std::atomic<bool>          dumping{ false };
+            std::atomic<bool>          crashed{ false };  // The fatal handlers dump once
+            std::int64_t               utcOffsetMs = 0;   // Local time of the dump lines, taken at Enable
+            LogLevel                   minimumLevel = LogLevel::Trace;
+            bool                       dumpOnBreakpoint = true;
+            char                       path[kPathSize] = {};
+        };
+
+        Ring& State()
+        {
+            static Ring s_ring;
+            return s_ring;
+        }
+
+        std::mutex& ControlMutex()
+        {
+            static std::mutex s_mutex;
+            return s_mutex;
+        }
+
+        thread_local Slot*         t_slot = nullptr;
+        thread_local std::uint64_t t_position = 0;
+
+        std::int64_t NowMilliseconds()
+        {
+            const auto now = std::chrono::system_clock::now();
+            return std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+        }
+
+        std::int64_t LocalUtcOffsetMs()
+        {
+            const std::time_t now = std::time(nullptr);
+            std::tm local{};
+#if defined(_WIN32)
+            if (localtime_s(&local, &now) != 0)
+                return 0;
+            return static_cast<std::int64_t>(_mkgmtime(&local) - now) * 1000;
+#else
+            if (!localtime_r(&now, &local))
+                return 0;
+            return static_cast<std::int64_t>(timegm(&local) - now) * 1000;
+#endif
+        }
+
+        // Channels are usually literals but need not outlive the message
+        void CopyChannel(char* out, const char* channel)
+        {
+            std::size_t i = 0;
+            if (channel) {
+                for (; i + 1 < kChannelSize && channel[i] != '\0'; ++i)
+                    out[i] = channel[i];
+            }
+            out[i] = '\0';
+        }
+
+        // Everything below runs in signal handlers: no locks, no allocation, no stdio
+
+        using FileHandle = int;
+
+        FileHandle OpenDumpFile(const char* path)
+        {
+#if defined(_WIN32)
+            return _open(path, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+            return open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+        }
+
+        void WriteDumpFile(FileHandle file, const char* data, std::size_t length)
+        {
+            while (length > 0) {
+#if defined(_WIN32)
+                const int written = _write(file, data, static_cast<unsigned int>(length));
+#else
+                const ssize_t written = write(file, data, length);
+#endif
+                if (written <= 0)
+                    return;
+                data += written;
+                length -= static_cast<std::size_t>(written);
+            }
+        }
+
+        void CloseDumpFile(FileHandle file)
+        {
+#if defined(_WIN32)
+            _close(file);
+#else
+            close(file);
+#endif
+        }
+
+        // Collects lines and writes them in blocks
+        class DumpWriter
+        {
+        public:
+            explicit DumpWriter(FileHandle file)
+                : m_file(file)
+            {
+            }
+
+            ~DumpWriter() { Flush(); }
+
+            DumpWriter(const DumpWriter&) = delete;
+            DumpWriter& operator=(const DumpWriter&) = delete;
+
+            void Append(const char* text, std::size_t length)
+            {
+                if (m_used + length > sizeof(m_buffer))
+                    Flush();
+                if (length > sizeof(m_buffer)) {
+                    WriteDumpFile(m_file, text, length);
+                    return;
+                }
+                std::memcpy(m_buffer + m_used, text, length);
+                m_used += length;
+            }
+
+            void Append(const char* text) { Append(text, std::strlen(text)); }
+
+            // Zero-padded to width digits
+            void AppendNumber(std::uint64_t value, int width = 1)
+            {
+                char digits[24];
+                int count = 0;
+                do {
+                    digits[count++] = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                } while (value > 0 && count < static_cast<int>(sizeof(digits)));
+                while (count < width && count < static_cast<int>(sizeof(digits)))
+                    digits[count++] = '0';
+
+                char text[24];
+                for (int i = 0; i < count; ++i)
+                    text[i] = digits[count - 1 - i];
+                Append(text, static_cast<std::size_t>(count));
+            }
+
+            void Flush()
+            {
+                WriteDumpFile(m_file, m_buffer, m_used);
+                m_used = 0;
+            }
+
+        private:
+            FileHandle  m_file;
+            char        m_buffer[4096];
+            std::size_t m_used = 0;
+        };
+
+        // Same layout as the console prefix
+        void WriteMessage(DumpWriter& out, const Message& message, std::int64_t utcOffsetMs)
+        {
+            constexpr std::int64_t kDayMs = 24 * 60 * 60 * 1000;
+            const std::int64_t dayMs = ((message.timeMs + utcOffsetMs) % kDayMs + kDayMs) % kDayMs;
+            const auto clock = static_cast<std::uint64_t>(dayMs);
+
+            out.Append("[");
+            out.AppendNumber(clock / 3600000, 2);
+            out.Append(":");
+            out.AppendNumber(clock / 60000 % 60, 2);
+            out.Append(":");
+            out.AppendNumber(clock / 1000 % 60, 2);
+            out.Append(".");
+            out.AppendNumber(clock % 1000, 3);
+            out.Append("][");
+            out.Append(LogLevelName(message.level));
+            out.Append("]");
+
+            if (message.channel[0] != '\0') {
+                out.Append("[");
+                out.Append(message.channel);
+                out.Append("]");
+            }
+            if (message.file) {
+                const char* slash = std::strrchr(message.file, '/');
+                const char* backslash = std::strrchr(message.file, '\\');
+                const char* separator = (slash && backslash) ? std::max(slash, backslash) : (slash ? slash : backslash);
+                out.Append("[");
+                out.Append(separator ? separator + 1 : message.file);
+                out.Append(":");
+                out.AppendNumber(static_cast<std::uint64_t>(std::max(message.line, 0)));
+                out.Append("]");
+            }
+            if (message.function && message.function[0] != '\0') {
+                out.Append("[");
+                out.Append(message.function);
+                out.Append("]");
+            }
+            out.Append(" ");
+            out.Append(message.text);
+            out.Append("\n");
+        }
+
+        // False for a slot that is empty, being written, or already reused
+        bool ReadSlot(const Slot& slot, std::uint64_t position, Message& out)
+        {
+            const std::uint64_t expected = 2 * position + 2;
+            if (slot.sequence.load(std::memory_order_acquire) != expected)
+                return false;
+
+            out.timeMs = slot.timeMs;
+            out.file = slot.file;
+            out.function = slot.function;
+            out.line = slot.line;
+            out.level = slot.level;
+            std::memcpy(out.channel, slot.channel, sizeof(out.channel));
+            std::memcpy(out.text, slot.text, sizeof(out.text));
+            out.channel[kChannelSize - 1] = '\0';
+            out.text[Detail::kCrashTextSize - 1] = '\0';
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return slot.sequence.load(std::memory_order_relaxed) == expected;
+        }
+
+        std::atomic<CrashCallback> g_crashCallbacks[kMaxCrashCallbacks] = {};
+        std::atomic<bool>          g_crashCallbacksRan{ false };
+
+        void DumpOnce(const char* reason)
+        {
+            // Callbacks run even with the ring disabled; their output does not depend on it
+            if (!g_crashCallbacksRan.exchange(true)) {
+                for (auto& slot : g_crashCallbacks) {
+                    if (CrashCallback callback = slot.load(std::memory_order_acquire))
+                        callback();
+                }
+            }
+
+            Ring& ring = State();
+            if (ring.enabled.load(std::memory_order_acquire) && !ring.crashed.exchange(true))
+                Dump(reason);
+        }
+
+        // Fatal handlers
+
+        constexpr int kFatalSignals[] = {
+            SIGSEGV, SIGABRT, SIGFPE, SIGILL,
+#if !defined(_WIN32)
+            SIGBUS,
+#endif
+        };
+
+        const char* SignalName(int signal)
+        {
+            switch (signal) {
+            case SIGSEGV: return "SIGSEGV";
+            case SIGABRT: return "SIGABRT";
+            case SIGFPE: return "SIGFPE";
+            case SIGILL: return "SIGILL";
+#if !defined(_WIN32)
+            case SIGBUS: return "SIGBUS";
+#endif
+            default: return "fatal signal";
+            }
+        }
+
+        std::terminate_handler& PreviousTerminateHandler()
+        {
+            static std::terminate_handler s_handler = nullptr;
+            return s_handler;
+        }
+
+        [[noreturn]] void OnTerminate()
+        {
+            char reason[Detail::kCrashTextSize] = "std::terminate";
+            if (std::exception_ptr current = std::current_exception()) {
+                try {
+                    std::rethrow_exception(current);
+                }
+                catch (const std::exception& error) {
+                    std::snprintf(reason, sizeof(reason), "std::terminate: %s", error.what());
+                }
+                catch (...) {
+                    std::snprintf(reason, sizeof(reason), "std::terminate: unknown exception");
+                }
+            }
+            DumpOnce(reason);
+
+            if (std::terminate_handler previous = PreviousTerminateHandler())
+                previous();
+            std::abort();
+        }
+
+#if defined(_WIN32)
+        using SignalHandler = void(__cdecl*)(int);
+        SignalHandler g_previousSignals[std::size(kFatalSignals)] = {};
+        LPTOP_LEVEL_EXCEPTION_FILTER g_previousFilter = nullptr;
+
+        void __cdecl OnFatalSignal(int signal)
+        {
+            DumpOnce(SignalName(signal));
+            for (std::size_t i = 0; i < std::size(kFatalSignals); ++i) {
+                if (kFatalSignals[i] == signal)
+                    std::signal(signal, g_previousSignals[i] ? g_previousSignals[i] : SIG_DFL);
+            }
+            std::raise(signal);
+        }
+
+        // Access violations and other SEH exceptions never become signals on the main thread
+        LONG WINAPI OnUnhandledException(EXCEPTION_POINTERS* info)
+        {
+            char reason[64] = "unhandled exception";
+            if (info && info->ExceptionRecord)
+                std::snprintf(reason, sizeof(reason), "unhandled exception 0x%08lX", info->ExceptionRecord->ExceptionCode);
+            DumpOnce(reason);
+            return g_previousFilter ? g_previousFilter(info) : EXCEPTION_CONTINUE_SEARCH;
+        }
+
+        void InstallFatalHandlers()
+        {
+            for (std::size_t i = 0; i < std::size(kFatalSignals); ++i) {
+                const SignalHandler previous = std::signal(kFatalSignals[i], OnFatalSignal);
+                g_previousSignals[i] = previous == SIG_ERR ? nullptr : previous;
+            }
+            g_previousFilter = SetUnhandledExceptionFilter(OnUnhandledException);
+        }
+#else
+        struct sigaction g_previousSignals[std::size(kFatalSignals)] = {};
+
+        // A stack overflow leaves no room for the handler on the thread's own stack;
+        // this covers the thread that enabled the crash log
+        constexpr std::size_t kAltStackSize = 64 * 1024;
+        char g_altStack[kAltStackSize];
+
+        void OnFatalSignal(int signal)
+        {
+            DumpOnce(SignalName(signal));
+            // Delivered with the previous disposition once this handler returns
+            for (std::size_t i = 0; i < std::size(kFatalSignals); ++i) {
+                if (kFatalSignals[i] == signal)
+                    sigaction(signal, &g_previousSignals[i], nullptr);
+            }
+            raise(signal);
+        }
+
+        void InstallFatalHandlers()
+        {
+            stack_t stack{};
+            stack.ss_sp = g_altStack;
+            stack.ss_size = kAltStackSize;
+            if (sigaltstack(&stack, nullptr) != 0)
+                KbkWarn(kLogChannel, "No alternate signal stack; stack overflows will not be dumped");
+
+            struct sigaction action{};
+            action.sa_handler = OnFatalSignal;
+            action.sa_flags = SA_ONSTACK;
+            sigemptyset(&action.sa_mask);
+            for (std::size_t i = 0; i < std::size(kFatalSignals); ++i) {
+                if (sigaction(kFatalSignals[i], &action, &g_previousSignals[i]) != 0)
+                    KbkWarn(kLogChannel, "Failed to install the %s handler", SignalName(kFatalSignals[i]));
+            }
+        }
+#endif
+
+        void InstallHandlersOnce()
+        {
+            static std::once_flag s_once;
+            std::call_once(s_once, []() {
+                InstallFatalHandlers();
+                PreviousTerminateHandler() = std::set_terminate(OnTerminate);
+            });
+        }
+
+        // Caller holds ControlMutex
+        void StopCapture()
+        {
+            Ring& ring = State();
+            KibakoEngine::Detail::SetLogCaptureLevel(KibakoEngine::Detail::kNoLogCapture);
+
+            // Sequentially consistent with BeginCapture: either a writer sees the ring
+            // disabled, or this loop sees the writer
+            if (!ring.enabled.exchange(false))
+                return;
+            while (ring.writers.load() != 0)
+                std::this_thread::yield();
+        }
+    } // namespace
+
+    bool Enable(const CrashLogConfig& config)
+    {
+        std::lock_guard<std::mutex> guard(ControlMutex());
+        Ring& ring = State();
+
+        if (config.path.empty() || config.path.size() >= kPathSize) {
+            KbkError(kLogChannel, "Crash log path must be 1 to %zu characters", kPathSize - 1);
+            return false;
+        }
+
+        StopCapture();
+
+        std::uint64_t capacity = 1;
+        while (capacity < std::max<std::uint32_t>(config.capacity, 16))
+            capacity <<= 1;
+
+        if (!ring.slots || ring.mask + 1 != capacity)
+            ring.slots = std::make_unique<Slot[]>(capacity);
+        for (std::uint64_t i = 0; i < capacity; ++i)
+            ring.slots[i].sequence.store(0, std::memory_order_relaxed);
+
+        ring.mask = capacity - 1;
+        ring.head.store(0, std::memory_order_relaxed);
+        ring.utcOffsetMs = LocalUtcOffsetMs();
+        ring.minimumLevel = config.minimumLevel;
+        ring.dumpOnBreakpoint = config.dumpOnBreakpoint;
+        std::memcpy(ring.path, config.path.c_str(), config.path.size() + 1);
+
+        ring.enabled.store(true);
+        KibakoEngine::Detail::SetLogCaptureLevel(static_cast<std::uint8_t>(config.minimumLevel));
+
+        if (config.installHandlers)
+            InstallHandlersOnce();
+
+        KbkLogFmt(kLogChannel, "Keeping the last {} messages at {} and above, dumped to {} on a crash", capacity,
+            LogLevelName(config.minimumLevel), config.path);
+        return true;
+    }
+
+    void Disable()
+    {
+        std::lock_guard<std::mutex> guard(ControlMutex());
+        StopCapture();
+    }
+
+    bool IsEnabled()
+    {
+        return State().enabled.load(std::memory_order_acquire);
+    }
+
+    bool AddCrashCallback(CrashCallback callback)
+    {
+        if (!callback)
+            return false;
+
+        for (auto& slot : g_crashCallbacks) {
+            CrashCallback empty = nullptr;
+            if (slot.compare_exchange_strong(empty, callback, std::memory_order_acq_rel))
+                return true;
+        }
+        KbkError(kLogChannel, "Crash callbacks are limited to %zu", kMaxCrashCallbacks);
+        return false;
+    }
+
+    bool Dump(const char* reason)
+    {
+        Ring& ring = State();
+        if (!ring.slots || ring.path[0] == '\0')
+            return false;
+
+        // A crash inside a dump must not start another
+        if (ring.dumping.exchange(true))
+            return false;
+
+        const FileHandle file = OpenDumpFile(ring.path);
+        if (file < 0) {
+            ring.dumping.store(false);
+            return false;
+        }
+
+        {
+            DumpWriter out(file);
+            const std::uint64_t head = ring.head.load(std::memory_order_acquire);
+            const std::uint64_t capacity = ring.mask + 1;
+            const std::uint64_t first = head > capacity ? head - capacity : 0;
+
+            // Breakpoint reasons are whole log lines; the newline is added here
+            const char* text = reason ? reason : "dump requested";
+            std::size_t length = std::strlen(text);
+            while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r'))
+                --length;
+            out.Append("Kibako crash log: ");
+            out.Append(text, length);
+            out.Append("\nLast ");
+            out.AppendNumber(head - first);
+            out.Append(" of ");
+            out.AppendNumber(head);
+            out.Append(" messages at ");
+            out.Append(LogLevelName(ring.minimumLevel));
+            out.Append(" and above, oldest first\n");
+
+            Message message;
+            for (std::uint64_t position = first; position < head; ++position) {
+                if (ReadSlot(ring.slots[position & ring.mask], position, message))
+                    WriteMessage(out, message, ring.utcOffsetMs);
+            }
+        }
+
+        CloseDumpFile(file);
+        ring.dumping.store(false);
+        return true;
+    }
+
+    namespace Detail
+    {
+        char* BeginCapture(LogLevel level, const char* channel, const char* file, int line, const char* function)
+        {
+            Ring& ring = State();
+            if (static_cast<std::uint8_t>(level) < KibakoEngine::Detail::g_logCaptureLevel.load(std::memory_order_relaxed))
+                return nullptr;
+
+            ring.writers.fetch_add(1);
+            if (!ring.enabled.load()) {
+                ring.writers.fetch_sub(1, std::memory_order_release);
+                return nullptr;
+            }
+
+            // The oldest message is overwritten; a dump skips it while the sequence is odd
+            const std::uint64_t position = ring.head.fetch_add(1, std::memory_order_relaxed);
+            Slot& slot = ring.slots[position & ring.mask];
+            slot.sequence.store(2 * position + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            slot.timeMs = NowMilliseconds();
+            slot.file = file;
+            slot.function = function;
+            slot.line = line;
+            slot.level = level;
+            CopyChannel(slot.channel, channel);
+            slot.text[0] = '\0';
+
+            t_slot = &slot;
+            t_position = position;
+            return slot.text;
+        }
+
+        void EndCapture()
+        {
+            if (!t_slot)
+                return;
+            t_slot->sequence.store(2 * t_position + 2, std::memory_order_release);
+            t_slot = nullptr;
+            State().writers.fetch_sub(1, std::memory_order_release);
+        }
+
+        void Capture(LogLevel level,
+                     const char* channel,
+                     const char* file,
+                     int line,
+                     const char* function,
+                     const char* text,
+                     std::size_t length)
+        {
+            char* out = BeginCapture(level, channel, file, line, function);
+            if (!out)
+                return;
+            const std::size_t copied = std::min(length, kCrashTextSize - 1);
+            std::memcpy(out, text, copied);
+            out[copied] = '\0';
+            EndCapture();
+        }
+
+        void OnBreakpoint(const char* reason)
+        {
+            const Ring& ring = State();
+            if (ring.enabled.load(std::memory_order_acquire) && ring.dumpOnBreakpoint)
+                Dump(reason);
+        }
+    } // namespace Detail
+
+} // namespace KibakoEngine::CrashLog
@@ -1,6 +1,7 @@
 // Assertion and HRESULT helpers
 #include "KibakoEngine/Core/Debug.h"
 
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 
@@ -32,7 +33,8 @@ namespace KibakoEngine::Debug {
             return true;
 
         char buffer[16]{};
-        std::snprintf(buffer, sizeof(buffer), "0x%08lX", static_cast<unsigned long>(hr));
+        // HRESULTs are 32 bits; long is 64 outside Windows
+        std::snprintf(buffer, sizeof(buffer), "0x%08lX", static_cast<unsigned long>(static_cast<std::uint32_t>(hr)));
         ReportAssertion("HRESULT", expression, buffer, file, line);
 #if KBK_DEBUG_BUILD
         KBK_BREAK();
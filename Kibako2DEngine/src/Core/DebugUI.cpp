@@ -1,11 +1,14 @@
 // Debug UI overlay
 #include "KibakoEngine/Core/DebugUI.h"
 
-#if KBK_DEBUG_BUILD
+#if KBK_ENABLE_DEBUG_UI
 
 #include "KibakoEngine/Core/Debug.h"
 #include "KibakoEngine/Core/GameServices.h"
 #include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/MemoryTracker.h"
+#include "KibakoEngine/Core/PerfCounters.h"
+#include "KibakoEngine/Core/Profiler.h"
 
 #include <d3d11.h>
 
@@ -24,11 +27,119 @@ namespace KibakoEngine::DebugUI {
         ID3D11Device*        g_device = nullptr;
         ID3D11DeviceContext* g_context = nullptr;
 
-        RenderStats g_renderStats{};
-        bool        g_vsyncEnabled = true;
+        bool g_vsyncEnabled = true;
 
         void*         g_sceneInspectorUserData = nullptr;
         PanelCallback g_sceneInspectorCallback = nullptr;
+
+        Profiler::CallTree g_callTree;
+        std::vector<PerfCounterValue> g_counters;
+
+        void DrawCallTree()
+        {
+            Profiler::GetCallTree(g_callTree);
+            if (g_callTree.nodes.empty()) {
+                ImGui::TextDisabled("No profiler scopes recorded.");
+                return;
+            }
+
+            const ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit;
+            if (!ImGui::BeginTable("##calltree", 5, flags))
+                return;
+
+            ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Incl ms");
+            ImGui::TableSetupColumn("Excl ms");
+            ImGui::TableSetupColumn("Hits");
+            ImGui::TableSetupColumn("p95 ms");
+            ImGui::TableHeadersRow();
+
+            for (const Profiler::CallTreeNode& node : g_callTree.nodes) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%*s%s", static_cast<int>(node.depth * 2), "", node.name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", node.inclusiveMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", node.exclusiveMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", node.hits);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", node.p95Ms);
+            }
+            ImGui::EndTable();
+        }
+
+        void DrawMemoryTags()
+        {
+            if (!MemoryTracker::IsEnabled()) {
+                ImGui::TextDisabled("Memory tracking disabled (KBK_ENABLE_MEMORY_TRACKING=0).");
+                return;
+            }
+
+            const ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit;
+            if (!ImGui::BeginTable("##memorytags", 5, flags))
+                return;
+
+            ImGui::TableSetupColumn("Tag", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Live KB");
+            ImGui::TableSetupColumn("Peak KB");
+            ImGui::TableSetupColumn("Blocks");
+            ImGui::TableSetupColumn("Allocs/frame");
+            ImGui::TableHeadersRow();
+
+            for (std::size_t i = 0; i < kMemoryTagCount; ++i) {
+                const MemoryTag tag = static_cast<MemoryTag>(i);
+                const MemoryTagStats stats = MemoryTracker::Stats(tag);
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(MemoryTagName(tag));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", static_cast<double>(stats.liveBytes) / 1024.0);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", static_cast<double>(stats.peakBytes) / 1024.0);
+                ImGui::TableNextColumn();
+                ImGui::Text("%lld", static_cast<long long>(stats.liveAllocations));
+                ImGui::TableNextColumn();
+                // Steady-state hot paths should read 0 here
+                if (stats.frameAllocations > 0)
+                    ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "%llu", static_cast<unsigned long long>(stats.frameAllocations));
+                else
+                    ImGui::TextUnformatted("0");
+            }
+            ImGui::EndTable();
+        }
+
+        void DrawPerfCounters()
+        {
+            PerfCounters::GetSnapshot(g_counters);
+
+            const ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit;
+            if (!ImGui::BeginTable("##perfcounters", 3, flags))
+                return;
+
+            ImGui::TableSetupColumn("Counter", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Last frame");
+            ImGui::TableSetupColumn("Total");
+            ImGui::TableHeadersRow();
+
+            for (const PerfCounterValue& value : g_counters) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(value.name.c_str());
+                ImGui::TableNextColumn();
+                if (value.unit == PerfCounterUnit::Nanoseconds)
+                    ImGui::Text("%.3f ms", static_cast<double>(value.frameValue) / 1.0e6);
+                else if (value.unit == PerfCounterUnit::Bytes)
+                    ImGui::Text("%.1f KB", static_cast<double>(value.frameValue) / 1024.0);
+                else
+                    ImGui::Text("%llu", static_cast<unsigned long long>(value.frameValue));
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(value.total));
+            }
+            ImGui::EndTable();
+        }
     }
 
     void Init(SDL_Window* window, ID3D11Device* device, ID3D11DeviceContext* context)
@@ -121,8 +232,10 @@ namespace KibakoEngine::DebugUI {
                 ImGui::Text("Renderer");
                 ImGui::BulletText("Backbuffer: %.0f x %.0f", display.x, display.y);
                 ImGui::BulletText("VSync: %s", g_vsyncEnabled ? "ON" : "OFF");
-                ImGui::BulletText("Sprites: %u", g_renderStats.spritesSubmitted);
-                ImGui::BulletText("Draw calls: %u", g_renderStats.drawCalls);
+                static const PerfCounterId spritesId = PerfCounters::Register("render.spritesSubmitted");
+                static const PerfCounterId drawCallsId = PerfCounters::Register("render.drawCalls");
+                ImGui::BulletText("Sprites: %llu", static_cast<unsigned long long>(PerfCounters::FrameValue(spritesId)));
+                ImGui::BulletText("Draw calls: %llu", static_cast<unsigned long long>(PerfCounters::FrameValue(drawCallsId)));
 
                 const GameTime& gt = GameServices::GetTime();
 
@@ -146,6 +259,7 @@ namespace KibakoEngine::DebugUI {
                 ImGui::Separator();
                 ImGui::Text("Shortcuts");
                 ImGui::BulletText("F2: toggle debug overlay");
+                ImGui::BulletText("F3: capture a Chrome trace (kibako_trace.json)");
                 ImGui::BulletText("F1: toggle collision overlay (sandbox)");
 
                 ImGui::EndTabItem();
@@ -172,6 +286,20 @@ namespace KibakoEngine::DebugUI {
                     ImVec2(0.0f, 80.0f));
                 ImGui::Text("Target: 16.6 ms (60 FPS)");
 
+                ImGui::Separator();
+                ImGui::Text("Call tree (last frame, p95 over %u frames)", g_callTree.windowFrames);
+                DrawCallTree();
+
+                ImGui::EndTabItem();
+            }
+
+            if (ImGui::BeginTabItem("Counters")) {
+                DrawPerfCounters();
+                ImGui::EndTabItem();
+            }
+
+            if (ImGui::BeginTabItem("Memory")) {
+                DrawMemoryTags();
                 ImGui::EndTabItem();
             }
 
@@ -236,16 +364,6 @@ namespace KibakoEngine::DebugUI {
         return g_vsyncEnabled;
     }
 
-    void SetRenderStats(const RenderStats& stats)
-    {
-        g_renderStats = stats;
-    }
-
-    RenderStats GetRenderStats()
-    {
-        return g_renderStats;
-    }
-
     void SetSceneInspector(void* userData, PanelCallback callback)
     {
         g_sceneInspectorUserData = userData;
@@ -254,4 +372,4 @@ namespace KibakoEngine::DebugUI {
 
 } // namespace KibakoEngine::DebugUI
 
-#endif // KBK_DEBUG_BUILD
+#endif // KBK_ENABLE_DEBUG_UI
@@ -0,0 +1,238 @@
+// Rolling frame-time statistics with per-phase breakdown
+#include "KibakoEngine/Core/FrameStats.h"
+
+#include "KibakoEngine/Core/Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace KibakoEngine {
+
+    namespace
+    {
+        constexpr const char* kLogChannel = "FrameStats";
+
+        using Clock = std::chrono::steady_clock;
+
+        double ElapsedMs(Clock::time_point start, Clock::time_point end)
+        {
+            return std::chrono::duration<double, std::milli>(end - start).count();
+        }
+
+        // Nearest-rank percentiles over an unsorted copy
+        FrameTimeStats ComputeStats(std::vector<double>& values)
+        {
+            FrameTimeStats stats{};
+            if (values.empty())
+                return stats;
+
+            std::sort(values.begin(), values.end());
+            const double count = static_cast<double>(values.size());
+            auto percentile = [&](double p) {
+                const auto rank = static_cast<std::size_t>(std::ceil(p * count));
+                return values[std::max<std::size_t>(rank, 1) - 1];
+            };
+
+            double total = 0.0;
+            for (double value : values)
+                total += value;
+
+            stats.avgMs = total / count;
+            stats.p50Ms = percentile(0.50);
+            stats.p95Ms = percentile(0.95);
+            stats.p99Ms = percentile(0.99);
+            stats.maxMs = values.back();
+            return stats;
+        }
+    }
+
+    const char* FramePhaseName(FramePhase phase)
+    {
+        switch (phase) {
+        case FramePhase::Events:  return "events";
+        case FramePhase::Update:  return "update";
+        case FramePhase::Render:  return "render";
+        case FramePhase::Present: return "present";
+        default:                  return "unknown";
+        }
+    }
+
+    FrameStats::PhaseScope::PhaseScope(FrameStats& stats, FramePhase phase)
+        : m_stats(stats)
+        , m_phase(phase)
+        , m_start(Clock::now())
+    {
+    }
+
+    FrameStats::PhaseScope::~PhaseScope()
+    {
+        m_stats.AddPhaseTime(m_phase, ElapsedMs(m_start, Clock::now()));
+    }
+
+    void FrameStats::BeginFrame()
+    {
+        const Clock::time_point now = Clock::now();
+        if (m_frameOpen)
+            CloseFrame(now);
+
+        m_current = FrameSample{};
+        m_current.frame = m_totalFrames;
+        m_frameStart = now;
+        m_frameOpen = true;
+    }
+
+    void FrameStats::EndFrame()
+    {
+        if (!m_frameOpen)
+            return;
+
+        CloseFrame(Clock::now());
+        m_frameOpen = false;
+    }
+
+    void FrameStats::AddPhaseTime(FramePhase phase, double ms)
+    {
+        const auto index = static_cast<std::size_t>(phase);
+        if (index < kFramePhaseCount)
+            m_current.phaseMs[index] += ms;
+    }
+
+    void FrameStats::CloseFrame(Clock::time_point now)
+    {
+        m_current.frameMs = ElapsedMs(m_frameStart, now);
+        m_current.hitch = m_current.frameMs > m_hitchMs;
+
+        ++m_totalFrames;
+        if (m_current.hitch) {
+            ++m_totalHitches;
+            const double* phases = m_current.phaseMs;
+            KbkWarnFields(kLogChannel, "Hitch", { "frame", m_current.frame }, { "duration_ms", m_current.frameMs },
+                { "events_ms", phases[0] }, { "update_ms", phases[1] }, { "render_ms", phases[2] },
+                { "present_ms", phases[3] });
+        }
+
+        if (m_window == 0)
+            return;
+
+        if (m_samples.size() < m_window)
+            m_samples.push_back(m_current);
+        else
+            m_samples[m_next] = m_current;
+        m_next = (m_next + 1) % m_window;
+    }
+
+    void FrameStats::SetWindowSize(std::size_t frames)
+    {
+        m_window = frames;
+        m_samples.clear();
+        m_samples.reserve(frames);
+        m_next = 0;
+    }
+
+    FrameStatsSummary FrameStats::Summary() const
+    {
+        FrameStatsSummary summary{};
+        summary.frames = static_cast<std::uint32_t>(m_samples.size());
+        summary.totalFrames = m_totalFrames;
+        summary.totalHitches = m_totalHitches;
+
+        std::vector<double> values;
+        values.reserve(m_samples.size());
+
+        for (const FrameSample& sample : m_samples) {
+            values.push_back(sample.frameMs);
+            if (sample.hitch)
+                ++summary.hitchesInWindow;
+        }
+        summary.frame = ComputeStats(values);
+
+        for (std::size_t phase = 0; phase < kFramePhaseCount; ++phase) {
+            values.clear();
+            for (const FrameSample& sample : m_samples)
+                values.push_back(sample.phaseMs[phase]);
+            summary.phases[phase] = ComputeStats(values);
+        }
+        return summary;
+    }
+
+    std::vector<FrameSample> FrameStats::Samples() const
+    {
+        std::vector<FrameSample> ordered;
+        ordered.reserve(m_samples.size());
+
+        // Until the ring wraps, m_next == size and the oldest sample is at 0
+        const std::size_t start = m_samples.size() < m_window ? 0 : m_next;
+        for (std::size_t i = 0; i < m_samples.size(); ++i)
+            ordered.push_back(m_samples[(start + i) % m_samples.size()]);
+        return ordered;
+    }
+
+    const FrameSample* FrameStats::LastFrame() const
+    {
+        if (m_samples.empty())
+            return nullptr;
+        const std::size_t last = (m_next + m_samples.size() - 1) % m_samples.size();
+        return &m_samples[last];
+    }
+
+    bool FrameStats::ExportCSV(const std::string& path) const
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            KbkError(kLogChannel, "Failed to open %s for writing", path.c_str());
+            return false;
+        }
+
+        std::fprintf(file, "frame,frame_ms");
+        for (std::size_t phase = 0; phase < kFramePhaseCount; ++phase)
+            std::fprintf(file, ",%s_ms", FramePhaseName(static_cast<FramePhase>(phase)));
+        std::fprintf(file, ",hitch\n");
+
+        for (const FrameSample& sample : Samples()) {
+            std::fprintf(file, "%llu,%.4f", static_cast<unsigned long long>(sample.frame), sample.frameMs);
+            for (double ms : sample.phaseMs)
+                std::fprintf(file, ",%.4f", ms);
+            std::fprintf(file, ",%d\n", sample.hitch ? 1 : 0);
+        }
+
+        const bool ok = std::ferror(file) == 0;
+        std::fclose(file);
+        if (!ok) {
+            KbkError(kLogChannel, "Failed to write %s", path.c_str());
+            return false;
+        }
+
+        KbkLog(kLogChannel, "Wrote %zu frames to %s", m_samples.size(), path.c_str());
+        return true;
+    }
+
+    void FrameStats::LogSummary() const
+    {
+        const FrameStatsSummary summary = Summary();
+        if (summary.frames == 0)
+            return;
+
+        KbkLog(kLogChannel, "%u frames: avg %.2f ms, p50 %.2f, p95 %.2f, p99 %.2f, max %.2f, %llu hitches > %.1f ms",
+            summary.frames, summary.frame.avgMs, summary.frame.p50Ms, summary.frame.p95Ms,
+            summary.frame.p99Ms, summary.frame.maxMs,
+            static_cast<unsigned long long>(summary.hitchesInWindow), m_hitchMs);
+
+        for (std::size_t phase = 0; phase < kFramePhaseCount; ++phase) {
+            const FrameTimeStats& stats = summary.phases[phase];
+            KbkLog(kLogChannel, "  %-8s avg %.3f ms, p95 %.3f, max %.3f",
+                FramePhaseName(static_cast<FramePhase>(phase)), stats.avgMs, stats.p95Ms, stats.maxMs);
+        }
+    }
+
+    void FrameStats::Reset()
+    {
+        m_samples.clear();
+        m_next = 0;
+        m_current = FrameSample{};
+        m_frameOpen = false;
+        m_totalFrames = 0;
+        m_totalHitches = 0;
+    }
+
+} // namespace KibakoEngine
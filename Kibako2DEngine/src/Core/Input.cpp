@@ -17,19 +17,27 @@ namespace KibakoEngine {
         m_wheelX = 0;
         m_wheelY = 0;
         m_textChar = 0;
+        m_keysPressed.fill(0);
+        m_mousePressed = 0;
         m_prevMouseButtons = m_mouseButtons;
-        m_keyboard = SDL_GetKeyboardState(nullptr);
+        m_keyboard = m_overridden ? m_overrideKeyboard.data() : SDL_GetKeyboardState(nullptr);
     }
 
     void Input::HandleEvent(const SDL_Event& e)
     {
         switch (e.type) {
+        case SDL_KEYDOWN:
+            // The keyboard state only shows the end of the frame; a tap shorter than a frame lives here
+            if (!e.key.repeat && e.key.keysym.scancode < SDL_NUM_SCANCODES)
+                m_keysPressed[e.key.keysym.scancode] = 1;
+            break;
         case SDL_MOUSEMOTION:
             m_mouseX = e.motion.x;
             m_mouseY = e.motion.y;
             break;
         case SDL_MOUSEBUTTONDOWN:
             m_mouseButtons |= SDL_BUTTON(e.button.button);
+            m_mousePressed |= SDL_BUTTON(e.button.button);
             break;
         case SDL_MOUSEBUTTONUP:
             m_mouseButtons &= ~SDL_BUTTON(e.button.button);
@@ -55,6 +63,45 @@ namespace KibakoEngine {
         }
     }
 
+    void Input::Capture(InputSnapshot& out) const
+    {
+        if (m_keyboard)
+            std::memcpy(out.keys.data(), m_keyboard, out.keys.size());
+        else
+            out.keys.fill(0);
+
+        out.mouseX = m_mouseX;
+        out.mouseY = m_mouseY;
+        out.wheelX = m_wheelX;
+        out.wheelY = m_wheelY;
+        out.keysPressed = m_keysPressed;
+        out.mouseButtons = m_mouseButtons;
+        out.mousePressed = m_mousePressed;
+        out.textChar = m_textChar;
+    }
+
+    void Input::Override(const InputSnapshot& snapshot)
+    {
+        m_overrideKeyboard = snapshot.keys;
+        m_keyboard = m_overrideKeyboard.data();
+        m_overridden = true;
+
+        m_mouseX = snapshot.mouseX;
+        m_mouseY = snapshot.mouseY;
+        m_wheelX = snapshot.wheelX;
+        m_wheelY = snapshot.wheelY;
+        m_keysPressed = snapshot.keysPressed;
+        m_mouseButtons = snapshot.mouseButtons;
+        m_mousePressed = snapshot.mousePressed;
+        m_textChar = snapshot.textChar;
+    }
+
+    void Input::StopOverride()
+    {
+        m_overridden = false;
+        m_keyboard = SDL_GetKeyboardState(nullptr);
+    }
+
     bool Input::KeyDown(SDL_Scancode scancode) const
     {
         return m_keyboard && m_keyboard[scancode] != 0;
@@ -64,7 +111,7 @@ namespace KibakoEngine {
     {
         const uint8_t now = m_keyboard ? m_keyboard[scancode] : 0;
         const uint8_t prev = m_prevKeyboard[scancode];
-        return (now != 0u) && (prev == 0u);
+        return m_keysPressed[scancode] != 0u || ((now != 0u) && (prev == 0u));
     }
 
     bool Input::MouseDown(uint8_t button) const
@@ -75,7 +122,7 @@ namespace KibakoEngine {
     bool Input::MousePressed(uint8_t button) const
     {
         const uint32_t mask = SDL_BUTTON(button);
-        return ((m_mouseButtons & mask) != 0u) && ((m_prevMouseButtons & mask) == 0u);
+        return (m_mousePressed & mask) != 0u || (((m_mouseButtons & mask) != 0u) && ((m_prevMouseButtons & mask) == 0u));
     }
 
 } // namespace KibakoEngine
@@ -1,15 +1,27 @@
 // Logging helpers
 #include "KibakoEngine/Core/Log.h"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <cctype>
+#include <cmath>
+#include <charconv>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <exception>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "KibakoEngine/Core/CrashLog.h"
 #include "KibakoEngine/Core/Debug.h"
 
 #ifdef _WIN32
@@ -22,12 +34,25 @@ namespace KibakoEngine {
     {
         constexpr std::size_t kLogBufferSize = 2048;
 
+        // One queued message: ~1 KB with its metadata, longer text is truncated
+        constexpr std::size_t kAsyncChannelSize = 32;
+        constexpr std::size_t kAsyncTextSize = 960;
+        // How long std::terminate and synchronous errors wait for the writer thread
+        constexpr std::chrono::milliseconds kAsyncDrainTimeout{ 1000 };
+
         std::mutex& OutputMutex()
         {
             static std::mutex s_mutex;
             return s_mutex;
         }
 
+        // Under OutputMutex
+        std::vector<LogSink*>& Sinks()
+        {
+            static std::vector<LogSink*> s_sinks;
+            return s_sinks;
+        }
+
         std::mutex& ConfigMutex()
         {
             static std::mutex s_mutex;
@@ -40,12 +65,90 @@ namespace KibakoEngine {
             return s_mutex;
         }
 
-        LogConfig& ConfigStorage()
+        // Every message reads the config, so it is packed into one word instead of
+        // taking ConfigMutex; writers still serialize on the mutex
+        std::uint32_t PackConfig(const LogConfig& config)
         {
-            static LogConfig s_config{};
+            return static_cast<std::uint32_t>(config.minimumLevel)
+                | (static_cast<std::uint32_t>(config.debuggerBreakLevel) << 8)
+                | (config.breakIntoDebugger ? 1u << 16 : 0u)
+                | (config.haltRenderingOnBreak ? 1u << 17 : 0u)
+                | (config.collapseRepeats ? 1u << 18 : 0u);
+        }
+
+        std::atomic<std::uint32_t>& PackedConfig()
+        {
+            static std::atomic<std::uint32_t> s_config{ PackConfig(LogConfig{}) };
             return s_config;
         }
 
+        // Resolved channel levels, keyed by the channel pointer and checked against the
+        // name, since a freed channel string's address can come back holding another.
+        // Slots are filled once and never reused, so a reader that matched a key always
+        // reads that channel's level; overrides rewrite the levels in place.
+        constexpr std::size_t kChannelSlots = 256;
+        constexpr std::size_t kChannelProbes = 8;
+
+        struct ChannelSlot
+        {
+            std::atomic<const char*>  channel{ nullptr };
+            std::atomic<std::uint8_t> level{ 0 };
+            std::string               name;  // Written once before channel is published
+        };
+
+        struct ChannelOverride
+        {
+            std::string name;
+            LogLevel    level;
+        };
+
+        struct ChannelTable
+        {
+            std::array<ChannelSlot, kChannelSlots> slots;
+            std::vector<ChannelOverride>           overrides;  // Under ConfigMutex
+        };
+
+        ChannelTable& Channels()
+        {
+            static ChannelTable s_table;
+            return s_table;
+        }
+
+        std::size_t ChannelHash(const char* channel)
+        {
+            auto key = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(channel));
+            key = (key >> 3) * 0x9E3779B97F4A7C15ull;
+            return static_cast<std::size_t>(key >> 56) % kChannelSlots;
+        }
+
+        // Caller holds ConfigMutex
+        LogLevel ResolveChannelLevel(const char* name)
+        {
+            for (const ChannelOverride& entry : Channels().overrides) {
+                if (entry.name == name)
+                    return entry.level;
+            }
+            return static_cast<LogLevel>(PackedConfig().load(std::memory_order_relaxed) & 0xFFu);
+        }
+
+        // Caller holds ConfigMutex; run after the default level or any override changes
+        void RefreshChannelLevels()
+        {
+            ChannelTable& table = Channels();
+            std::uint8_t floor = static_cast<std::uint8_t>(PackedConfig().load(std::memory_order_relaxed) & 0xFFu);
+            for (const ChannelOverride& entry : table.overrides)
+                floor = std::min(floor, static_cast<std::uint8_t>(entry.level));
+            floor = std::min(floor, Detail::g_logCaptureLevel.load(std::memory_order_relaxed));
+
+            for (ChannelSlot& slot : table.slots) {
+                if (slot.channel.load(std::memory_order_relaxed))
+                    slot.level.store(static_cast<std::uint8_t>(ResolveChannelLevel(slot.name.c_str())), std::memory_order_relaxed);
+            }
+
+            Detail::g_logFloor.store(floor, std::memory_order_relaxed);
+            Detail::g_logChannelOverrides.store(!table.overrides.empty(), std::memory_order_release);
+        }
+
         std::atomic<bool>& BreakRequestedFlag()
         {
             static std::atomic<bool> s_requested{false};
@@ -111,6 +214,7 @@ namespace KibakoEngine {
             else
                 StoreBreakpointMessage("");
 
+            CrashLog::Detail::OnBreakpoint(message);
 
             if (config.breakIntoDebugger)
                 KBK_BREAK();
@@ -118,15 +222,925 @@ namespace KibakoEngine {
 
         LogConfig CopyConfig()
         {
-            std::lock_guard<std::mutex> guard(ConfigMutex());
-            return ConfigStorage();
+            const std::uint32_t packed = PackedConfig().load(std::memory_order_acquire);
+            LogConfig config;
+            config.minimumLevel = static_cast<LogLevel>(packed & 0xFFu);
+            config.debuggerBreakLevel = static_cast<LogLevel>((packed >> 8) & 0xFFu);
+            config.breakIntoDebugger = (packed & (1u << 16)) != 0;
+            config.haltRenderingOnBreak = (packed & (1u << 17)) != 0;
+            config.collapseRepeats = (packed & (1u << 18)) != 0;
+            return config;
+        }
+
+        std::int64_t NowMilliseconds()
+        {
+            const auto now = std::chrono::system_clock::now();
+            return std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+        }
+
+        std::FILE* StreamFor(LogLevel level)
+        {
+            return (level == LogLevel::Error || level == LogLevel::Critical) ? stderr : stdout;
+        }
+
+        // Appends text and a newline after a prefix; returns the line length
+        std::size_t FinishLine(char* buffer, std::size_t size, std::size_t offset, const char* text, std::size_t length)
+        {
+            const std::size_t copied = std::min(length, size - 2 - std::min(offset, size - 2));
+            std::memcpy(buffer + offset, text, copied);
+            offset += copied;
+            buffer[offset++] = '\n';
+            buffer[offset] = '\0';
+            return offset;
+        }
+
+        // Where the message and the structured fields sit in formatted text
+        struct TextLayout
+        {
+            std::size_t length = 0;
+            std::size_t messageLength = 0;
+            std::size_t fieldsOffset = 0;
+            std::size_t fieldsLength = 0;
+        };
+
+        TextLayout FormatPrintf(char* out, std::size_t size, const char* fmt, std::va_list args)
+        {
+            const int written = std::vsnprintf(out, size, fmt, args);
+            TextLayout layout;
+            layout.length = written < 0 ? 0 : std::min(static_cast<std::size_t>(written), size - 1);
+            layout.messageLength = layout.length;
+            out[layout.length] = '\0';
+            return layout;
+        }
+
+        std::size_t AppendRaw(char* out, std::size_t limit, std::size_t offset, const char* text, std::size_t length)
+        {
+            const std::size_t copied = std::min(length, limit - std::min(offset, limit));
+            std::memcpy(out + offset, text, copied);
+            return offset + copied;
+        }
+
+        std::size_t AppendBracketed(char* out, std::size_t limit, std::size_t offset, const char* text)
+        {
+            offset = AppendRaw(out, limit, offset, "[", 1);
+            offset = AppendRaw(out, limit, offset, text, std::strlen(text));
+            return AppendRaw(out, limit, offset, "]", 1);
+        }
+
+        // "[HH:MM:SS.mmm]"
+        constexpr std::size_t kTimestampSize = 14;
+
+        // "[HH:MM:SS." of the last second this thread formatted; a burst of lines calls
+        // localtime once per second rather than once per line, and only the
+        // milliseconds are written per line
+        struct TimestampCache
+        {
+            std::int64_t second = std::numeric_limits<std::int64_t>::min();
+            char         text[10] = { '[', '0', '0', ':', '0', '0', ':', '0', '0', '.' };
+        };
+
+        thread_local TimestampCache t_timestamp;
+
+        void WriteTwoDigits(char* out, int value)
+        {
+            out[0] = static_cast<char>('0' + value / 10 % 10);
+            out[1] = static_cast<char>('0' + value % 10);
+        }
+
+        // "message {"key":value,...}"; fields from the first one that does not fit on are dropped
+        TextLayout FormatFields(char* out, std::size_t size, const char* message, std::initializer_list<LogField> fields)
+        {
+            const std::size_t limit = size - 1;
+            TextLayout layout;
+            std::size_t offset = AppendRaw(out, limit, 0, message ? message : "", message ? std::strlen(message) : 0);
+            layout.messageLength = offset;
+
+            if (fields.size() > 0 && offset + 3 <= limit) {
+                out[offset++] = ' ';
+                out[offset++] = '{';
+                layout.fieldsOffset = offset;
+
+                // Leaves room for the closing brace
+                const std::size_t fieldLimit = limit - 1;
+                bool first = true;
+                for (const LogField& field : fields) {
+                    const std::size_t mark = offset;
+                    if (!first)
+                        offset = AppendRaw(out, fieldLimit, offset, ",", 1);
+                    offset = Detail::AppendJsonString(out, fieldLimit, offset, field.key ? field.key : "",
+                        field.key ? std::strlen(field.key) : 0);
+                    offset = AppendRaw(out, fieldLimit, offset, ":", 1);
+
+                    char number[32];
+                    int written = 0;
+                    switch (field.type) {
+                    case LogFieldType::Int:
+                        written = std::snprintf(number, sizeof(number), "%lld", static_cast<long long>(field.i));
+                        break;
+                    case LogFieldType::UInt:
+                        written = std::snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(field.u));
+                        break;
+                    case LogFieldType::Double:
+                        written = std::isfinite(field.d) ? std::snprintf(number, sizeof(number), "%.9g", field.d)
+                                                         : std::snprintf(number, sizeof(number), "null");
+                        break;
+                    case LogFieldType::Bool:
+                        written = std::snprintf(number, sizeof(number), "%s", field.u ? "true" : "false");
+                        break;
+                    case LogFieldType::String:
+                        offset = Detail::AppendJsonString(out, fieldLimit, offset, field.text, field.length);
+                        break;
+                    }
+                    if (written > 0)
+                        offset = AppendRaw(out, fieldLimit, offset, number, static_cast<std::size_t>(written));
+
+                    if (offset >= fieldLimit) {
+                        offset = mark;
+                        break;
+                    }
+                    first = false;
+                }
+
+                layout.fieldsLength = offset - layout.fieldsOffset;
+                out[offset++] = '}';
+            }
+
+            out[offset] = '\0';
+            layout.length = offset;
+            return layout;
+        }
+
+        LogRecord MakeRecord(LogLevel level,
+                             std::int64_t timeMs,
+                             const char* channel,
+                             const char* file,
+                             int line,
+                             const char* function,
+                             const char* text,
+                             const TextLayout& layout)
+        {
+            LogRecord record;
+            record.level = level;
+            record.timeMs = timeMs;
+            record.channel = channel ? channel : "";
+            record.file = file;
+            record.line = line;
+            record.function = function;
+            record.message = text;
+            record.messageLength = layout.messageLength;
+            record.fields = text + layout.fieldsOffset;
+            record.fieldsLength = layout.fieldsLength;
+            return record;
+        }
+
+        // Writes one finished line to the console, the debugger and every sink; caller holds OutputMutex
+        void EmitLine(const LogRecord& record, const char* line, std::size_t length, bool flush)
+        {
+            FILE* stream = StreamFor(record.level);
+            std::fputs(line, stream);
+            if (flush)
+                std::fflush(stream);
+            OutputToDebugger(line);
+            for (LogSink* sink : Sinks()) {
+                sink->Write(record.level, line, length);
+                sink->WriteRecord(record);
+            }
+        }
+
+        // A line the logger writes about itself, such as a repeat count
+        void EmitNotice(LogLevel level, const char* channel, std::int64_t timeMs, const char* text)
+        {
+            std::array<char, 256> buffer;
+            const std::size_t prefix = Detail::FormatLogPrefix(buffer.data(), buffer.size(), level, timeMs, channel,
+                nullptr, 0, nullptr);
+            TextLayout layout;
+            layout.messageLength = AppendRaw(buffer.data() + prefix, buffer.size() - prefix - 2, 0, text, std::strlen(text));
+            const std::size_t length = FinishLine(buffer.data(), buffer.size(), prefix + layout.messageLength, "", 0);
+            EmitLine(MakeRecord(level, timeMs, channel, nullptr, 0, nullptr, buffer.data() + prefix, layout), buffer.data(),
+                length, true);
+        }
+
+        // Identical consecutive messages from one call site are counted instead of
+        // written. A steady stream still reports its count about once a second.
+        constexpr std::int64_t kRepeatReportMs = 1000;
+
+        class RepeatCollapser
+        {
+        public:
+            // True if the message repeats the previous one; caller holds OutputMutex
+            bool Collapse(LogLevel level,
+                          const char* channel,
+                          const char* file,
+                          int line,
+                          const char* text,
+                          std::size_t length,
+                          std::int64_t timeMs)
+            {
+                const bool repeat = m_line == line && m_file == file && m_level == level && m_length == length
+                    && std::memcmp(m_text.data(), text, length) == 0;
+                if (repeat) {
+                    if (m_repeats == 0)
+                        m_firstRepeatMs = timeMs;
+                    ++m_repeats;
+                    if (timeMs - m_firstRepeatMs >= kRepeatReportMs)
+                        Report(timeMs);
+                    return true;
+                }
+
+                Report(timeMs);
+                m_level = level;
+                m_file = file;
+                m_line = line;
+                m_length = std::min(length, m_text.size());
+                std::memcpy(m_text.data(), text, m_length);
+                std::snprintf(m_channel, sizeof(m_channel), "%s", channel ? channel : "");
+                return false;
+            }
+
+            // Writes the pending count, if any
+            void Report(std::int64_t timeMs)
+            {
+                if (m_repeats == 0)
+                    return;
+
+                char text[64];
+                std::snprintf(text, sizeof(text), "Last message repeated %u times", m_repeats);
+                m_repeats = 0;
+                EmitNotice(m_level, m_channel, timeMs, text);
+            }
+
+            void ReportIfStale(std::int64_t timeMs)
+            {
+                if (m_repeats > 0 && timeMs - m_firstRepeatMs >= kRepeatReportMs)
+                    Report(timeMs);
+            }
+
+        private:
+            std::array<char, kLogBufferSize> m_text;
+            std::size_t                      m_length = 0;
+            const char*                      m_file = nullptr;
+            int                              m_line = -1;  // Matches no call site until the first message
+            LogLevel                         m_level = LogLevel::Trace;
+            char                             m_channel[kAsyncChannelSize] = {};
+            std::uint32_t                    m_repeats = 0;
+            std::int64_t                     m_firstRepeatMs = 0;
+        };
+
+        RepeatCollapser& Repeats()
+        {
+            static RepeatCollapser s_repeats;
+            return s_repeats;
+        }
+
+        // Tick resolution (1 to 16 ms) is plenty for one-second rate windows, and these
+        // clocks cost a few nanoseconds where steady_clock costs tens
+        std::int64_t CoarseMilliseconds()
+        {
+#if defined(_WIN32)
+            return static_cast<std::int64_t>(GetTickCount64());
+#elif defined(CLOCK_MONOTONIC_COARSE)
+            timespec now{};
+            clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+            return static_cast<std::int64_t>(now.tv_sec) * 1000 + now.tv_nsec / 1'000'000;
+#else
+            const auto now = std::chrono::steady_clock::now();
+            return std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+#endif
+        }
+
+        thread_local bool t_isLogWriter = false;
+
+        // Multi-producer, single-consumer ring of fixed-size records. Each slot carries a
+        // sequence number, so producers claim slots with one CAS and the writer thread
+        // sees a record only once it is complete.
+        class AsyncLogQueue
+        {
+        public:
+            bool Start(const AsyncLogConfig& config)
+            {
+                if (m_running.load(std::memory_order_acquire))
+                    return true;
+
+                std::uint64_t capacity = 1;
+                while (capacity < std::max<std::uint32_t>(config.capacity, 2))
+                    capacity <<= 1;
+
+                if (!m_records || m_mask + 1 != capacity)
+                    m_records = std::make_unique<Record[]>(capacity);
+                for (std::uint64_t i = 0; i < capacity; ++i)
+                    m_records[i].sequence.store(i, std::memory_order_relaxed);
+
+                m_config = config;
+                m_config.sampleEvery = std::max<std::uint32_t>(config.sampleEvery, 1);
+                m_config.flushIntervalMs = std::max<std::uint32_t>(config.flushIntervalMs, 1);
+                m_mask = capacity - 1;
+                m_enqueue.store(0, std::memory_order_relaxed);
+                m_written.store(0, std::memory_order_relaxed);
+                m_dropped.store(0, std::memory_order_relaxed);
+                m_reportedDropped = 0;
+                m_stopRequested = false;
+
+                m_running.store(true, std::memory_order_release);
+                m_worker = std::thread([this]() { WorkerMain(); });
+                return true;
+            }
+
+            void Stop()
+            {
+                // Sequentially consistent with Push: either a producer sees the queue
+                // stopped, or this loop sees the producer
+                if (!m_running.exchange(false))
+                    return;
+
+                // Producers that saw the queue running finish their push first
+                while (m_writers.load() != 0) {
+                    Wake();
+                    std::this_thread::yield();
+                }
+
+                {
+                    std::lock_guard<std::mutex> guard(m_mutex);
+                    m_stopRequested = true;
+                }
+                m_wake.notify_one();
+                if (m_worker.joinable())
+                    m_worker.join();
+            }
+
+            [[nodiscard]] bool IsRunning() const
+            {
+                return m_running.load(std::memory_order_acquire);
+            }
+
+            [[nodiscard]] std::uint64_t Dropped() const
+            {
+                return m_dropped.load(std::memory_order_relaxed);
+            }
+
+            // False when the queue is not running and format was not called; the caller
+            // then writes the message itself
+            template <typename Format>
+            bool Push(LogLevel level,
+                      const char* channel,
+                      const char* file,
+                      int line,
+                      const char* function,
+                      Format&& format)
+            {
+                m_writers.fetch_add(1);
+                if (!m_running.load()) {
+                    m_writers.fetch_sub(1, std::memory_order_release);
+                    return false;
+                }
+
+                Record* record = nullptr;
+                std::uint64_t position = 0;
+                if (Claim(level, record, position)) {
+                    record->timeMs = NowMilliseconds();
+                    record->level = level;
+                    record->file = file;
+                    record->line = line;
+                    record->function = function;
+                    std::snprintf(record->channel, sizeof(record->channel), "%s", channel ? channel : "");
+
+                    record->layout = format(record->text, sizeof(record->text));
+
+                    record->sequence.store(position + 1, std::memory_order_release);
+
+                    // The writer also wakes on its own every flushIntervalMs
+                    const std::uint64_t queued = position + 1 - m_written.load(std::memory_order_relaxed);
+                    if (level >= LogLevel::Warning || queued > (m_mask + 1) / 2)
+                        Wake();
+                }
+
+                m_writers.fetch_sub(1, std::memory_order_release);
+                return true;
+            }
+
+            // False if the writer did not catch up in time
+            bool WaitUntilWritten(std::chrono::milliseconds timeout)
+            {
+                if (!IsRunning())
+                    return true;
+
+                // The writer cannot wait for itself, and may hold the output lock
+                if (t_isLogWriter)
+                    return true;
+
+                const std::uint64_t target = m_enqueue.load(std::memory_order_acquire);
+                Wake();
+
+                std::unique_lock<std::mutex> lock(m_mutex);
+                return m_drained.wait_for(lock, timeout, [&]() {
+                    return m_written.load(std::memory_order_acquire) >= target;
+                });
+            }
+
+        private:
+            struct Record
+            {
+                std::atomic<std::uint64_t> sequence{ 0 };
+                std::int64_t               timeMs = 0;
+                const char*                file = nullptr;
+                const char*                function = nullptr;
+                int                        line = 0;
+                LogLevel                   level = LogLevel::Info;
+                TextLayout                 layout{};
+                char                       channel[kAsyncChannelSize] = {};
+                char                       text[kAsyncTextSize] = {};
+            };
+
+            // False if the message was dropped by the overflow policy
+            bool Claim(LogLevel level, Record*& out, std::uint64_t& position)
+            {
+                const std::uint64_t capacity = m_mask + 1;
+                const bool droppable = level <= LogLevel::Info;
+
+                if (m_config.overflow == LogOverflowPolicy::Sample && droppable) {
+                    const std::uint64_t queued = m_enqueue.load(std::memory_order_relaxed)
+                        - m_written.load(std::memory_order_relaxed);
+                    if (queued >= capacity - capacity / 4
+                        && m_sampleCounter.fetch_add(1, std::memory_order_relaxed) % m_config.sampleEvery != 0) {
+                        m_dropped.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                }
+
+                std::uint64_t pos = m_enqueue.load(std::memory_order_relaxed);
+                for (;;) {
+                    Record& record = m_records[pos & m_mask];
+                    const std::uint64_t sequence = record.sequence.load(std::memory_order_acquire);
+                    const auto difference = static_cast<std::int64_t>(sequence - pos);
+
+                    if (difference == 0) {
+                        if (m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            out = &record;
+                            position = pos;
+                            return true;
+                        }
+                        continue;
+                    }
+
+                    if (difference < 0) {
+                        // Full
+                        const bool drop = m_config.overflow == LogOverflowPolicy::Drop
+                            || (m_config.overflow == LogOverflowPolicy::Sample && droppable);
+                        if (drop) {
+                            m_dropped.fetch_add(1, std::memory_order_relaxed);
+                            return false;
+                        }
+                        Wake();
+                        std::this_thread::yield();
+                    }
+                    pos = m_enqueue.load(std::memory_order_relaxed);
+                }
+            }
+
+            void Wake()
+            {
+                if (m_wakeRequested.exchange(true, std::memory_order_acq_rel))
+                    return;
+                std::lock_guard<std::mutex> guard(m_mutex);
+                m_wake.notify_one();
+            }
+
+            void WorkerMain()
+            {
+                t_isLogWriter = true;
+                const std::chrono::milliseconds interval(m_config.flushIntervalMs);
+                for (;;) {
+                    bool stop = false;
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_wake.wait_for(lock, interval, [&]() {
+                            return m_stopRequested || m_wakeRequested.load(std::memory_order_acquire);
+                        });
+                        m_wakeRequested.store(false, std::memory_order_release);
+                        stop = m_stopRequested;
+                    }
+
+                    Drain();
+
+                    {
+                        std::lock_guard<std::mutex> guard(m_mutex);
+                    }
+                    m_drained.notify_all();
+
+                    if (stop)
+                        return;
+                }
+            }
+
+            // Writes every completed record in order, then flushes once
+            void Drain()
+            {
+                std::array<char, kLogBufferSize> buffer;
+                bool wrote = false;
+
+                const bool collapse = CopyConfig().collapseRepeats;
+                RepeatCollapser& repeats = Repeats();
+
+                std::lock_guard<std::mutex> guard(OutputMutex());
+                for (;;) {
+                    const std::uint64_t position = m_written.load(std::memory_order_relaxed);
+                    Record& record = m_records[position & m_mask];
+                    if (record.sequence.load(std::memory_order_acquire) != position + 1)
+                        break;
+
+                    if (!collapse || !repeats.Collapse(record.level, record.channel, record.file, record.line, record.text,
+                                                       record.layout.length, record.timeMs)) {
+                        const std::size_t prefix = Detail::FormatLogPrefix(buffer.data(), buffer.size(), record.level,
+                            record.timeMs, record.channel, record.file, record.line, record.function);
+                        const std::size_t length = FinishLine(buffer.data(), buffer.size(), prefix, record.text,
+                            record.layout.length);
+                        EmitLine(MakeRecord(record.level, record.timeMs, record.channel, record.file, record.line,
+                                            record.function, record.text, record.layout),
+                                 buffer.data(), length, false);
+                    }
+                    wrote = true;
+
+                    record.sequence.store(position + m_mask + 1, std::memory_order_release);
+                    m_written.store(position + 1, std::memory_order_release);
+                }
+
+                const std::uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+                if (dropped != m_reportedDropped) {
+                    char text[64];
+                    std::snprintf(text, sizeof(text), "%llu messages dropped by the async queue",
+                        static_cast<unsigned long long>(dropped - m_reportedDropped));
+                    EmitNotice(LogLevel::Warning, "Log", NowMilliseconds(), text);
+                    m_reportedDropped = dropped;
+                    wrote = true;
+                }
+
+                repeats.ReportIfStale(NowMilliseconds());
+
+                if (wrote) {
+                    std::fflush(stdout);
+                    std::fflush(stderr);
+                }
+
+                // Also runs on idle wakeups, so buffered sinks flush on time
+                for (LogSink* sink : Sinks())
+                    sink->Update();
+            }
+
+            std::unique_ptr<Record[]>  m_records;
+            std::uint64_t              m_mask = 0;
+            AsyncLogConfig             m_config{};
+
+            std::atomic<bool>          m_running{ false };
+            std::atomic<std::uint32_t> m_writers{ 0 };
+            std::atomic<std::uint64_t> m_enqueue{ 0 };
+            std::atomic<std::uint64_t> m_written{ 0 };
+            std::atomic<std::uint64_t> m_dropped{ 0 };
+            std::atomic<std::uint64_t> m_sampleCounter{ 0 };
+            std::atomic<bool>          m_wakeRequested{ false };
+
+            // Writer thread only
+            std::uint64_t              m_reportedDropped = 0;
+
+            std::thread                m_worker;
+            std::mutex                 m_mutex;
+            std::condition_variable    m_wake;
+            std::condition_variable    m_drained;
+            bool                       m_stopRequested = false;
+        };
+
+        AsyncLogQueue& AsyncQueue()
+        {
+            static AsyncLogQueue s_queue;
+            return s_queue;
+        }
+
+        std::terminate_handler& PreviousTerminateHandler()
+        {
+            static std::terminate_handler s_handler = nullptr;
+            return s_handler;
+        }
+
+        // Queued lines are usually the ones explaining the crash
+        [[noreturn]] void DrainOnTerminate()
+        {
+            AsyncQueue().WaitUntilWritten(kAsyncDrainTimeout);
+            // This thread may have died holding the lock
+            std::unique_lock<std::mutex> lock(OutputMutex(), std::try_to_lock);
+            if (lock.owns_lock()) {
+                for (LogSink* sink : Sinks())
+                    sink->Flush();
+            }
+            if (std::terminate_handler previous = PreviousTerminateHandler())
+                previous();
+            std::abort();
+        }
+
+        void InstallAsyncHooksOnce()
+        {
+            static std::once_flag s_once;
+            std::call_once(s_once, []() {
+                // Registered after the queue exists, so it runs before the queue is destroyed
+                std::atexit(StopAsyncLogging);
+                PreviousTerminateHandler() = std::set_terminate(DrainOnTerminate);
+            });
+        }
+
+        // ShouldLog also passes levels only the crash log captures; this is the output's own filter
+        bool OutputAllows(LogLevel level, const char* channel)
+        {
+            if (Detail::g_logChannelOverrides.load(std::memory_order_relaxed))
+                return Detail::ChannelAllows(level, channel);
+            return static_cast<std::uint8_t>(level) >= (PackedConfig().load(std::memory_order_relaxed) & 0xFFu);
+        }
+
+        // Shared by printf and structured messages; format(out, size) fills the text
+        template <typename Format>
+        void Dispatch(LogLevel level, const char* channel, const char* file, int line, const char* function, Format&& format)
+        {
+            const bool capture = static_cast<std::uint8_t>(level) >= Detail::g_logCaptureLevel.load(std::memory_order_relaxed);
+            if (capture && !OutputAllows(level, channel)) {
+                // Only the crash log wants it; format straight into the ring
+                if (char* text = CrashLog::Detail::BeginCapture(level, channel, file, line, function)) {
+                    format(text, CrashLog::Detail::kCrashTextSize);
+                    CrashLog::Detail::EndCapture();
+                }
+                return;
+            }
+
+            auto captured = [&](char* out, std::size_t size) {
+                const TextLayout layout = format(out, size);
+                if (capture)
+                    CrashLog::Detail::Capture(level, channel, file, line, function, out, layout.length);
+                return layout;
+            };
+
+            const LogConfig config = CopyConfig();
+
+            AsyncLogQueue& queue = AsyncQueue();
+            const bool canBreak = config.breakIntoDebugger || config.haltRenderingOnBreak;
+            const bool synchronous = level >= LogLevel::Error || (canBreak && level >= config.debuggerBreakLevel);
+            if (!synchronous && queue.Push(level, channel, file, line, function, captured))
+                return;
+
+            // Whatever is still queued happened before this message
+            if (queue.IsRunning())
+                queue.WaitUntilWritten(kAsyncDrainTimeout);
+
+            // Not zero-filled: the prefix and the formatter write every byte the line uses
+            std::array<char, kLogBufferSize> buffer;
+            const std::int64_t timeMs = NowMilliseconds();
+
+            {
+                std::lock_guard<std::mutex> guard(OutputMutex());
+
+                const std::size_t prefix = Detail::FormatLogPrefix(buffer.data(), buffer.size(), level, timeMs, channel, file,
+                    line, function);
+                if (prefix == 0)
+                    return;
+
+                // One byte stays free for the newline
+                const TextLayout layout = captured(buffer.data() + prefix, buffer.size() - prefix - 1);
+                const char* text = buffer.data() + prefix;
+                const bool repeat = config.collapseRepeats
+                    && Repeats().Collapse(level, channel, file, line, text, layout.length, timeMs);
+
+                std::size_t offset = prefix + layout.length;
+                buffer[offset++] = '\n';
+                buffer[offset] = '\0';
+
+                if (!repeat)
+                    EmitLine(MakeRecord(level, timeMs, channel, file, line, function, text, layout), buffer.data(), offset, true);
+            }
+
+            TriggerBreakpoint(level, buffer.data(), config);
         }
     } // namespace
 
+    namespace Detail
+    {
+        std::size_t FormatLogPrefix(char* buffer,
+                                    std::size_t size,
+                                    LogLevel level,
+                                    std::int64_t timeMs,
+                                    const char* channel,
+                                    const char* file,
+                                    int line,
+                                    const char* function)
+        {
+            if (size == 0)
+                return 0;
+
+            // Lines that do not fit are cut, as the snprintf chain this replaced did
+            const std::size_t limit = size - 1;
+
+            const std::int64_t milliseconds = ((timeMs % 1000) + 1000) % 1000;
+            const std::int64_t second = (timeMs - milliseconds) / 1000;
+            TimestampCache& cache = t_timestamp;
+            if (cache.second != second) {
+                std::tm local{};
+                LocalTime(static_cast<std::time_t>(second), local);
+                WriteTwoDigits(cache.text + 1, local.tm_hour);
+                WriteTwoDigits(cache.text + 4, local.tm_min);
+                WriteTwoDigits(cache.text + 7, local.tm_sec);
+                cache.second = second;
+            }
+
+            char stamp[kTimestampSize];
+            std::memcpy(stamp, cache.text, sizeof(cache.text));
+            stamp[10] = static_cast<char>('0' + milliseconds / 100);
+            WriteTwoDigits(stamp + 11, static_cast<int>(milliseconds % 100));
+            stamp[13] = ']';
+            std::size_t offset = AppendRaw(buffer, limit, 0, stamp, sizeof(stamp));
+
+            offset = AppendBracketed(buffer, limit, offset, LevelPrefix(level));
+
+            if (channel && channel[0] != '\0')
+                offset = AppendBracketed(buffer, limit, offset, channel);
+
+            if (file) {
+                const char* filename = std::strrchr(file, '/');
+                const char* backslash = std::strrchr(file, '\\');
+                const char* trimmed = filename ? filename + 1 : (backslash ? backslash + 1 : file);
+                char number[16];
+                number[0] = ':';
+                const std::to_chars_result result = std::to_chars(number + 1, number + sizeof(number) - 1, line);
+                *result.ptr = ']';
+                offset = AppendRaw(buffer, limit, offset, "[", 1);
+                offset = AppendRaw(buffer, limit, offset, trimmed, std::strlen(trimmed));
+                offset = AppendRaw(buffer, limit, offset, number, static_cast<std::size_t>(result.ptr + 1 - number));
+            }
+
+            if (function && function[0] != '\0')
+                offset = AppendBracketed(buffer, limit, offset, function);
+
+            offset = AppendRaw(buffer, limit, offset, " ", 1);
+            buffer[offset] = '\0';
+            return offset;
+        }
+
+        bool ChannelAllows(LogLevel level, const char* channel)
+        {
+            if (!channel)
+                channel = "";
+
+            ChannelTable& table = Channels();
+            const std::size_t home = ChannelHash(channel);
+            for (std::size_t probe = 0; probe < kChannelProbes; ++probe) {
+                ChannelSlot& slot = table.slots[(home + probe) % kChannelSlots];
+                const char* key = slot.channel.load(std::memory_order_acquire);
+                if (key == channel && slot.name == channel)
+                    return static_cast<std::uint8_t>(level) >= slot.level.load(std::memory_order_relaxed);
+                if (!key)
+                    break;
+            }
+
+            // First message from this channel pointer: resolve by name and cache it
+            std::lock_guard<std::mutex> guard(ConfigMutex());
+            const LogLevel resolved = ResolveChannelLevel(channel);
+            for (std::size_t probe = 0; probe < kChannelProbes; ++probe) {
+                ChannelSlot& slot = table.slots[(home + probe) % kChannelSlots];
+                const char* key = slot.channel.load(std::memory_order_relaxed);
+                if (key == channel && slot.name == channel)
+                    break;
+                if (key)
+                    continue;
+                slot.name = channel;
+                slot.level.store(static_cast<std::uint8_t>(resolved), std::memory_order_relaxed);
+                slot.channel.store(channel, std::memory_order_release);
+                break;
+            }
+            return level >= resolved;
+        }
+
+        void SetLogCaptureLevel(std::uint8_t level)
+        {
+            std::lock_guard<std::mutex> guard(ConfigMutex());
+            g_logCaptureLevel.store(level, std::memory_order_relaxed);
+            RefreshChannelLevels();
+        }
+
+        std::size_t AppendJsonString(char* buffer, std::size_t size, std::size_t offset, const char* text, std::size_t length)
+        {
+            if (offset + 2 > size)
+                return offset;
+
+            // Keeps room for the closing quote
+            const std::size_t limit = size - 1;
+            buffer[offset++] = '"';
+            for (std::size_t i = 0; i < length; ++i) {
+                const auto c = static_cast<unsigned char>(text[i]);
+                char escaped[8];
+                std::size_t count = 2;
+                escaped[0] = '\\';
+                switch (c) {
+                case '"': escaped[1] = '"'; break;
+                case '\\': escaped[1] = '\\'; break;
+                case '\n': escaped[1] = 'n'; break;
+                case '\r': escaped[1] = 'r'; break;
+                case '\t': escaped[1] = 't'; break;
+                default:
+                    if (c < 0x20) {
+                        count = static_cast<std::size_t>(std::snprintf(escaped, sizeof(escaped), "\\u%04x", c));
+                    }
+                    else {
+                        escaped[0] = static_cast<char>(c);
+                        count = 1;
+                    }
+                    break;
+                }
+
+                if (offset + count > limit)
+                    break;
+                std::memcpy(buffer + offset, escaped, count);
+                offset += count;
+            }
+            buffer[offset++] = '"';
+            return offset;
+        }
+
+        void LogSuppressed(LogLevel level,
+                           const char* channel,
+                           const char* file,
+                           int line,
+                           const char* function,
+                           std::uint32_t count)
+        {
+            LogMessage(level, channel, file, line, function, "Suppressed %u messages from this call site", count);
+        }
+    } // namespace Detail
+
     void SetLogConfig(const LogConfig& config)
     {
         std::lock_guard<std::mutex> guard(ConfigMutex());
-        ConfigStorage() = config;
+        PackedConfig().store(PackConfig(config), std::memory_order_release);
+        RefreshChannelLevels();
+    }
+
+    void SetLogChannelLevel(const char* channel, LogLevel level)
+    {
+        const char* name = channel ? channel : "";
+        std::lock_guard<std::mutex> guard(ConfigMutex());
+        std::vector<ChannelOverride>& overrides = Channels().overrides;
+        auto it = std::find_if(overrides.begin(), overrides.end(), [name](const ChannelOverride& entry) { return entry.name == name; });
+        if (it != overrides.end())
+            it->level = level;
+        else
+            overrides.push_back({ name, level });
+        RefreshChannelLevels();
+    }
+
+    void ClearLogChannelLevel(const char* channel)
+    {
+        const char* name = channel ? channel : "";
+        std::lock_guard<std::mutex> guard(ConfigMutex());
+        std::vector<ChannelOverride>& overrides = Channels().overrides;
+        overrides.erase(std::remove_if(overrides.begin(), overrides.end(), [name](const ChannelOverride& entry) { return entry.name == name; }),
+                        overrides.end());
+        RefreshChannelLevels();
+    }
+
+    void ClearLogChannelLevels()
+    {
+        std::lock_guard<std::mutex> guard(ConfigMutex());
+        Channels().overrides.clear();
+        RefreshChannelLevels();
+    }
+
+    LogLevel GetLogChannelLevel(const char* channel)
+    {
+        std::lock_guard<std::mutex> guard(ConfigMutex());
+        return ResolveChannelLevel(channel ? channel : "");
+    }
+
+    bool ParseLogLevel(const char* text, LogLevel& out)
+    {
+        if (!text)
+            return false;
+
+        struct Name
+        {
+            const char* text;
+            LogLevel    level;
+        };
+        static constexpr Name kNames[] = {
+            { "trace", LogLevel::Trace },   { "info", LogLevel::Info },   { "warn", LogLevel::Warning },
+            { "warning", LogLevel::Warning }, { "error", LogLevel::Error }, { "critical", LogLevel::Critical },
+        };
+
+        for (const Name& name : kNames) {
+            std::size_t i = 0;
+            while (name.text[i] != '\0' && std::tolower(static_cast<unsigned char>(text[i])) == name.text[i])
+                ++i;
+            if (name.text[i] == '\0' && text[i] == '\0') {
+                out = name.level;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const char* LogLevelName(LogLevel level)
+    {
+        return LevelPrefix(level);
     }
 
     LogConfig GetLogConfig()
@@ -134,6 +1148,91 @@ namespace KibakoEngine {
         return CopyConfig();
     }
 
+    bool StartAsyncLogging(const AsyncLogConfig& config)
+    {
+        AsyncLogQueue& queue = AsyncQueue();
+        InstallAsyncHooksOnce();
+        return queue.Start(config);
+    }
+
+    void StopAsyncLogging()
+    {
+        AsyncQueue().Stop();
+    }
+
+    bool IsAsyncLogging()
+    {
+        return AsyncQueue().IsRunning();
+    }
+
+    void FlushLog()
+    {
+        AsyncLogQueue& queue = AsyncQueue();
+        while (!queue.WaitUntilWritten(kAsyncDrainTimeout) && queue.IsRunning()) {
+        }
+
+        std::lock_guard<std::mutex> guard(OutputMutex());
+        Repeats().Report(NowMilliseconds());
+        std::fflush(stdout);
+        std::fflush(stderr);
+        for (LogSink* sink : Sinks())
+            sink->Flush();
+    }
+
+    std::uint64_t DroppedLogMessages()
+    {
+        return AsyncQueue().Dropped();
+    }
+
+    void AddLogSink(LogSink* sink)
+    {
+        if (!sink)
+            return;
+
+        std::lock_guard<std::mutex> guard(OutputMutex());
+        std::vector<LogSink*>& sinks = Sinks();
+        if (std::find(sinks.begin(), sinks.end(), sink) == sinks.end())
+            sinks.push_back(sink);
+    }
+
+    void RemoveLogSink(LogSink* sink)
+    {
+        // Drain first so queued lines still reach the sink
+        FlushLog();
+
+        std::lock_guard<std::mutex> guard(OutputMutex());
+        std::vector<LogSink*>& sinks = Sinks();
+        sinks.erase(std::remove(sinks.begin(), sinks.end(), sink), sinks.end());
+    }
+
+    bool LogRateLimit::Allow(std::uint32_t maxPerSecond, std::uint32_t& suppressed)
+    {
+        // Budget first: while it lasts, only the call that opens a window reads the clock, to
+        // stamp its start; once spent, calls read it to see whether the window is over.
+        // Racing callers at a window boundary may let a few extra lines through.
+        const std::uint32_t used = m_count.fetch_add(1, std::memory_order_relaxed);
+        if (used < maxPerSecond) {
+            if (used == 0)
+                m_windowStartMs.store(CoarseMilliseconds(), std::memory_order_relaxed);
+            suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+            return true;
+        }
+
+        m_suppressed.fetch_add(1, std::memory_order_relaxed);
+        if (maxPerSecond == 0)
+            return false;
+
+        const std::int64_t now = CoarseMilliseconds();
+        std::int64_t start = m_windowStartMs.load(std::memory_order_relaxed);
+        if (now - start < 1000 || !m_windowStartMs.compare_exchange_strong(start, now, std::memory_order_relaxed))
+            return false;
+
+        // The window is over and this call opens the next one; it was counted as suppressed above
+        m_count.store(1, std::memory_order_relaxed);
+        suppressed = m_suppressed.exchange(0, std::memory_order_relaxed) - 1;
+        return true;
+    }
+
     void RequestBreakpoint(const char* reason, LogLevel level)
     {
         const LogConfig config = CopyConfig();
@@ -164,84 +1263,49 @@ namespace KibakoEngine {
                      const char* fmt,
                      std::va_list args)
     {
-        const LogConfig config = CopyConfig();
-        if (static_cast<int>(level) < static_cast<int>(config.minimumLevel))
+        // Direct LogMessage callers skip the macro check
+        if (!Detail::ShouldLog(level, channel))
             return;
 
-        std::array<char, kLogBufferSize> buffer{};
-        auto now = std::chrono::system_clock::now();
-        const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
-        const auto timeSeconds = static_cast<std::time_t>(ms / 1000);
-
-        std::tm local{};
-        LocalTime(timeSeconds, local);
-
-        const auto milliseconds = static_cast<long long>(ms % 1000);
-
-        {
-            std::lock_guard<std::mutex> guard(OutputMutex());
-
-            int written = std::snprintf(buffer.data(),
-                                        buffer.size(),
-                                        "[%02d:%02d:%02d.%03lld][%s]",
-                                        local.tm_hour,
-                                        local.tm_min,
-                                        local.tm_sec,
-                                        milliseconds,
-                                        LevelPrefix(level));
-            if (written < 0)
-                return;
-
-            std::size_t offset = static_cast<std::size_t>(written);
-
-            if (channel && channel[0] != '\0') {
-                written = std::snprintf(buffer.data() + offset, buffer.size() - offset, "[%s]", channel);
-                if (written < 0)
-                    return;
-                offset += static_cast<std::size_t>(written);
-            }
-
-            if (file) {
-                const char* filename = std::strrchr(file, '/');
-                const char* backslash = std::strrchr(file, '\\');
-                const char* trimmed = filename ? filename + 1 : (backslash ? backslash + 1 : file);
-                written = std::snprintf(buffer.data() + offset,
-                                        buffer.size() - offset,
-                                        "[%s:%d]",
-                                        trimmed,
-                                        line);
-                if (written < 0)
-                    return;
-                offset += static_cast<std::size_t>(written);
-            }
-
-            if (function && function[0] != '\0') {
-                written = std::snprintf(buffer.data() + offset, buffer.size() - offset, "[%s]", function);
-                if (written < 0)
-                    return;
-                offset += static_cast<std::size_t>(written);
-            }
-
-            if (offset < buffer.size()) {
-                buffer[offset++] = ' ';
-            }
+        Dispatch(level, channel, file, line, function, [fmt, &args](char* out, std::size_t size) {
+            return FormatPrintf(out, size, fmt, args);
+        });
+    }
 
-            written = std::vsnprintf(buffer.data() + offset, buffer.size() - offset, fmt, args);
-            if (written < 0)
-                return;
-            offset += static_cast<std::size_t>(written);
+    void LogFormatted(LogLevel level,
+                      const char* channel,
+                      const char* file,
+                      int line,
+                      const char* function,
+                      const char* fmt,
+                      const LogFormatArg* args,
+                      std::size_t count)
+    {
+        if (!Detail::ShouldLog(level, channel))
+            return;
 
-            if (offset + 1 < buffer.size())
-                buffer[offset++] = '\n';
-            buffer[offset] = '\0';
+        Dispatch(level, channel, file, line, function, [fmt, args, count](char* out, std::size_t size) {
+            TextLayout layout;
+            layout.length = FormatLogArgs(out, size, fmt, args, count);
+            layout.messageLength = layout.length;
+            return layout;
+        });
+    }
 
-            FILE* stream = (level == LogLevel::Error || level == LogLevel::Critical) ? stderr : stdout;
-            std::fputs(buffer.data(), stream);
-            std::fflush(stream);
-            OutputToDebugger(buffer.data());
-        }
+    void LogFields(LogLevel level,
+                   const char* channel,
+                   const char* file,
+                   int line,
+                   const char* function,
+                   const char* message,
+                   std::initializer_list<LogField> fields)
+    {
+        if (!Detail::ShouldLog(level, channel))
+            return;
 
-        TriggerBreakpoint(level, buffer.data(), config);
+        Dispatch(level, channel, file, line, function, [message, fields](char* out, std::size_t size) {
+            return FormatFields(out, size, message, fields);
+        });
     }
 
     void LogMessage(LogLevel level,
@@ -0,0 +1,322 @@
+// Buffered log file with size and time rotation and a disk cap
+#include "KibakoEngine/Core/LogFileSink.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <system_error>
+
+namespace KibakoEngine {
+
+    namespace
+    {
+        constexpr const char* kLogChannel = "Log";
+
+        // Room for several lines, so a write never holds less than one
+        constexpr std::size_t kMinBufferBytes = 4096;
+        // One JSON line; longer messages lose trailing fields
+        constexpr std::size_t kJsonLineBytes = 4096;
+
+        namespace fs = std::filesystem;
+
+        // Write() runs inside the logger, so its failures cannot be logged
+        void ReportFromSink(const char* message, const std::string& path)
+        {
+            std::fprintf(stderr, "[Log] %s %s\n", message, path.c_str());
+        }
+
+        std::string RotatedName(const std::string& baseName)
+        {
+            const std::time_t now = std::time(nullptr);
+            std::tm local{};
+#if defined(_WIN32)
+            localtime_s(&local, &now);
+#else
+            localtime_r(&now, &local);
+#endif
+            char stamp[32] = {};
+            std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &local);
+            return baseName + "-" + stamp;
+        }
+
+        std::size_t AppendLiteral(char* out, std::size_t limit, std::size_t offset, const char* text)
+        {
+            const std::size_t length = std::strlen(text);
+            if (offset + length > limit)
+                return offset;
+            std::memcpy(out + offset, text, length);
+            return offset + length;
+        }
+
+        bool IsRotatedFile(const fs::path& path, const std::string& baseName, const char* extension)
+        {
+            const std::string name = path.filename().string();
+            return path.extension() == extension && name.size() > baseName.size() + 1
+                && name.compare(0, baseName.size(), baseName) == 0 && name[baseName.size()] == '-';
+        }
+    }
+
+    RotatingFileSink::~RotatingFileSink()
+    {
+        Close();
+    }
+
+    bool RotatingFileSink::Open(const LogFileConfig& config)
+    {
+        Close();
+
+        m_config = config;
+        std::error_code error;
+        const fs::path directory = m_config.directory.empty() ? fs::path(".") : fs::path(m_config.directory);
+        fs::create_directories(directory, error);
+        m_activePath = (directory / (m_config.baseName + Extension())).string();
+
+        if (fs::exists(m_activePath, error) && !RenameActiveFile())
+            KbkWarn(kLogChannel, "Could not rotate the previous log %s; appending", m_activePath.c_str());
+
+        if (!OpenActiveFile()) {
+            KbkError(kLogChannel, "Failed to open log file %s", m_activePath.c_str());
+            return false;
+        }
+
+        m_buffer.resize(std::max(m_config.bufferBytes, kMinBufferBytes));
+        m_used = 0;
+        m_rotations = 0;
+        EnforceDiskCap();
+        return true;
+    }
+
+    void RotatingFileSink::Close()
+    {
+        if (!m_file)
+            return;
+
+        RemoveLogSink(this);
+        Flush();
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+
+    void RotatingFileSink::Write(LogLevel level, const char* line, std::size_t length)
+    {
+        if (m_config.format == LogFileFormat::Text)
+            Append(level, line, length);
+    }
+
+    void RotatingFileSink::WriteRecord(const LogRecord& record)
+    {
+        if (m_config.format != LogFileFormat::JsonLines || !m_file)
+            return;
+
+        char line[kJsonLineBytes];
+        // Keeps room for the closing brace and newline
+        const std::size_t limit = sizeof(line) - 2;
+        int written = std::snprintf(line, limit, "{\"time_ms\":%lld,\"level\":\"%s\",\"channel\":",
+            static_cast<long long>(record.timeMs), LogLevelName(record.level));
+        std::size_t offset = std::min(static_cast<std::size_t>(std::max(written, 0)), limit);
+        offset = Detail::AppendJsonString(line, limit, offset, record.channel, std::strlen(record.channel));
+
+        if (record.file) {
+            const char* slash = std::strrchr(record.file, '/');
+            const char* backslash = std::strrchr(record.file, '\\');
+            const char* separator = (slash && backslash) ? std::max(slash, backslash) : (slash ? slash : backslash);
+            const char* name = separator ? separator + 1 : record.file;
+            offset = AppendLiteral(line, limit, offset, ",\"file\":");
+            offset = Detail::AppendJsonString(line, limit, offset, name, std::strlen(name));
+            written = std::snprintf(line + offset, limit - offset, ",\"line\":%d", record.line);
+            offset = std::min(offset + static_cast<std::size_t>(std::max(written, 0)), limit);
+        }
+        if (record.function && record.function[0] != '\0') {
+            offset = AppendLiteral(line, limit, offset, ",\"function\":");
+            offset = Detail::AppendJsonString(line, limit, offset, record.function, std::strlen(record.function));
+        }
+
+        offset = AppendLiteral(line, limit, offset, ",\"message\":");
+        offset = Detail::AppendJsonString(line, limit, offset, record.message, record.messageLength);
+
+        // Fields arrive as complete JSON members; all or none of them are kept
+        if (record.fieldsLength > 0 && offset + 1 + record.fieldsLength <= limit) {
+            line[offset++] = ',';
+            std::memcpy(line + offset, record.fields, record.fieldsLength);
+            offset += record.fieldsLength;
+        }
+
+        line[offset++] = '}';
+        line[offset++] = '\n';
+        Append(record.level, line, offset);
+    }
+
+    void RotatingFileSink::Append(LogLevel level, const char* line, std::size_t length)
+    {
+        if (!m_file)
+            return;
+
+        const Clock::time_point now = Clock::now();
+        const bool full = m_config.maxFileBytes > 0 && m_fileBytes > 0 && m_fileBytes + length > m_config.maxFileBytes;
+        const bool expired = m_config.rotateIntervalMinutes > 0
+            && now - m_openedAt >= std::chrono::minutes(m_config.rotateIntervalMinutes);
+        if (full || expired) {
+            Rotate();
+            if (!m_file)
+                return;
+        }
+
+        if (m_used + length > m_buffer.size())
+            WriteBuffer();
+
+        if (length >= m_buffer.size()) {
+            std::fwrite(line, 1, length, m_file);
+        }
+        else {
+            std::memcpy(m_buffer.data() + m_used, line, length);
+            m_used += length;
+        }
+        m_fileBytes += length;
+
+        if (level >= LogLevel::Error)
+            Flush();
+        else
+            Update();
+    }
+
+    void RotatingFileSink::Update()
+    {
+        if (m_used > 0 && Clock::now() - m_lastFlush >= std::chrono::milliseconds(m_config.flushIntervalMs))
+            Flush();
+    }
+
+    void RotatingFileSink::Flush()
+    {
+        if (!m_file)
+            return;
+
+        WriteBuffer();
+        std::fflush(m_file);
+        m_lastFlush = Clock::now();
+    }
+
+    const char* RotatingFileSink::Extension() const
+    {
+        return m_config.format == LogFileFormat::JsonLines ? ".jsonl" : ".log";
+    }
+
+    bool RotatingFileSink::OpenActiveFile()
+    {
+        m_file = std::fopen(m_activePath.c_str(), "ab");
+        if (!m_file)
+            return false;
+
+        // Writes are already batched; the CRT buffer would only add a copy
+        std::setvbuf(m_file, nullptr, _IONBF, 0);
+
+        std::error_code error;
+        const std::uintmax_t size = fs::file_size(m_activePath, error);
+        m_fileBytes = error ? 0 : static_cast<std::uint64_t>(size);
+        m_openedAt = Clock::now();
+        m_lastFlush = m_openedAt;
+        return true;
+    }
+
+    void RotatingFileSink::Rotate()
+    {
+        Flush();
+        std::fclose(m_file);
+        m_file = nullptr;
+
+        if (RenameActiveFile())
+            ++m_rotations;
+        else
+            ReportFromSink("Could not rotate", m_activePath);
+
+        if (!OpenActiveFile()) {
+            ReportFromSink("Failed to reopen", m_activePath);
+            return;
+        }
+
+        // After a failed rename the same file continues; retry once it grows by half again
+        m_fileBytes = std::min(m_fileBytes, m_config.maxFileBytes / 2);
+        EnforceDiskCap();
+    }
+
+    bool RotatingFileSink::RenameActiveFile()
+    {
+        const fs::path active(m_activePath);
+        const std::string stem = RotatedName(m_config.baseName);
+
+        // Suffixes keep counting within one second, even past files the cap deleted,
+        // so names sort in rotation order
+        int suffix = stem == m_lastStem ? m_lastSuffix + 1 : 1;
+        std::error_code error;
+        fs::path target;
+        for (;; ++suffix) {
+            target = active.parent_path() / (suffix == 1 ? stem : stem + "-" + std::to_string(suffix));
+            target += Extension();
+            if (!fs::exists(target, error))
+                break;
+        }
+
+        fs::rename(active, target, error);
+        if (error)
+            return false;
+
+        m_lastStem = stem;
+        m_lastSuffix = suffix;
+        return true;
+    }
+
+    void RotatingFileSink::EnforceDiskCap()
+    {
+        if (m_config.maxTotalBytes == 0)
+            return;
+
+        struct RotatedFile
+        {
+            fs::path           path;
+            fs::file_time_type time;
+            std::uintmax_t     size;
+        };
+
+        std::vector<RotatedFile> files;
+        std::uint64_t total = m_fileBytes;
+        std::error_code error;
+        const fs::path directory = fs::path(m_activePath).parent_path();
+        for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+            std::error_code entryError;
+            if (!it->is_regular_file(entryError) || !IsRotatedFile(it->path(), m_config.baseName, Extension()))
+                continue;
+            RotatedFile file{ it->path(), it->last_write_time(entryError), it->file_size(entryError) };
+            if (entryError)
+                continue;
+            total += file.size;
+            files.push_back(std::move(file));
+        }
+
+        // Files rotated within one timestamp tick: "-2" follows the unnumbered one, "-10" follows "-9"
+        std::sort(files.begin(), files.end(), [](const RotatedFile& a, const RotatedFile& b) {
+            if (a.time != b.time)
+                return a.time < b.time;
+            const std::size_t aLength = a.path.native().size();
+            const std::size_t bLength = b.path.native().size();
+            return aLength != bLength ? aLength < bLength : a.path < b.path;
+        });
+
+        for (const RotatedFile& file : files) {
+            if (total <= m_config.maxTotalBytes)
+                break;
+            std::error_code removeError;
+            if (fs::remove(file.path, removeError))
+                total -= file.size;
+        }
+    }
+
+    void RotatingFileSink::WriteBuffer()
+    {
+        if (m_used == 0)
+            return;
+
+        std::fwrite(m_buffer.data(), 1, m_used, m_file);
+        m_used = 0;
+    }
+
+} // namespace KibakoEngine
@@ -0,0 +1,221 @@
+// Type-checked {} formatting for log messages
+#include "KibakoEngine/Core/LogFormat.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <system_error>
+
+namespace KibakoEngine {
+
+    namespace
+    {
+        struct Spec
+        {
+            int  width = 0;
+            int  precision = -1;
+            char type = '\0';
+            bool zeroPad = false;
+        };
+
+        // Appends up to the end of the buffer and silently drops the rest
+        class Output
+        {
+        public:
+            Output(char* out, std::size_t limit)
+                : m_out(out)
+                , m_limit(limit)
+            {
+            }
+
+            void Append(const char* text, std::size_t length)
+            {
+                const std::size_t copied = std::min(length, m_limit - m_used);
+                std::memcpy(m_out + m_used, text, copied);
+                m_used += copied;
+            }
+
+            void Fill(char c, std::size_t count)
+            {
+                const std::size_t filled = std::min(count, m_limit - m_used);
+                std::memset(m_out + m_used, c, filled);
+                m_used += filled;
+            }
+
+            [[nodiscard]] bool Full() const { return m_used >= m_limit; }
+            [[nodiscard]] std::size_t Used() const { return m_used; }
+
+        private:
+            char*       m_out;
+            std::size_t m_limit;
+            std::size_t m_used = 0;
+        };
+
+        // The format was checked at compile time; anything unexpected ends the placeholder
+        const char* ParseSpec(const char* p, Spec& spec)
+        {
+            if (*p != ':')
+                return p;
+            ++p;
+            if (*p == '0') {
+                spec.zeroPad = true;
+                ++p;
+            }
+            while (*p >= '0' && *p <= '9')
+                spec.width = spec.width * 10 + (*p++ - '0');
+            if (*p == '.') {
+                ++p;
+                spec.precision = 0;
+                while (*p >= '0' && *p <= '9')
+                    spec.precision = spec.precision * 10 + (*p++ - '0');
+            }
+            if (*p != '\0' && *p != '}')
+                spec.type = *p++;
+            return p;
+        }
+
+        // Numbers align right and may pad with zeros after the sign; text aligns left
+        void WritePadded(Output& out, const char* text, std::size_t length, const Spec& spec, bool number)
+        {
+            const std::size_t width = static_cast<std::size_t>(spec.width);
+            const std::size_t padding = width > length ? width - length : 0;
+            if (!number) {
+                out.Append(text, length);
+                out.Fill(' ', padding);
+                return;
+            }
+            if (spec.zeroPad) {
+                const std::size_t sign = (length > 0 && text[0] == '-') ? 1 : 0;
+                out.Append(text, sign);
+                out.Fill('0', padding);
+                out.Append(text + sign, length - sign);
+                return;
+            }
+            out.Fill(' ', padding);
+            out.Append(text, length);
+        }
+
+        template <typename T>
+        void WriteInteger(Output& out, T value, const Spec& spec)
+        {
+            char digits[32];
+            const int base = (spec.type == 'x' || spec.type == 'X') ? 16 : 10;
+            const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value, base);
+            const auto length = static_cast<std::size_t>(result.ptr - digits);
+            if (spec.type == 'X') {
+                for (std::size_t i = 0; i < length; ++i) {
+                    if (digits[i] >= 'a' && digits[i] <= 'f')
+                        digits[i] = static_cast<char>(digits[i] - 'a' + 'A');
+                }
+            }
+            WritePadded(out, digits, length, spec, true);
+        }
+
+        // Plain {} is the shortest text that reads back as the same double; a precision
+        // alone means fixed, as %.3f does
+        void WriteDouble(Output& out, double value, const Spec& spec)
+        {
+            char digits[64];
+            char* const end = digits + sizeof(digits);
+            std::to_chars_result result{};
+            if (spec.type == 'e')
+                result = std::to_chars(digits, end, value, std::chars_format::scientific, spec.precision < 0 ? 6 : spec.precision);
+            else if (spec.type == 'g')
+                result = std::to_chars(digits, end, value, std::chars_format::general, spec.precision < 0 ? 6 : spec.precision);
+            else if (spec.type == 'f' || spec.precision >= 0)
+                result = std::to_chars(digits, end, value, std::chars_format::fixed, spec.precision < 0 ? 6 : spec.precision);
+            else
+                result = std::to_chars(digits, end, value);
+
+            // Fixed notation of a huge value does not fit; scientific always does
+            if (result.ec != std::errc())
+                result = std::to_chars(digits, end, value, std::chars_format::scientific, spec.precision < 0 ? 6 : spec.precision);
+            if (result.ec != std::errc())
+                return;
+            WritePadded(out, digits, static_cast<std::size_t>(result.ptr - digits), spec, true);
+        }
+
+        void WriteArg(Output& out, const LogFormatArg& arg, const Spec& spec)
+        {
+            switch (arg.type) {
+            case LogArgType::Int:
+                WriteInteger(out, static_cast<long long>(arg.i), spec);
+                break;
+            case LogArgType::UInt:
+                WriteInteger(out, static_cast<unsigned long long>(arg.u), spec);
+                break;
+            case LogArgType::Double:
+                WriteDouble(out, arg.d, spec);
+                break;
+            case LogArgType::Bool:
+                WritePadded(out, arg.u ? "true" : "false", arg.u ? 4 : 5, spec, false);
+                break;
+            case LogArgType::Char: {
+                const char c = static_cast<char>(arg.u);
+                WritePadded(out, &c, 1, spec, false);
+                break;
+            }
+            case LogArgType::String: {
+                std::size_t length = arg.length;
+                if (spec.precision >= 0)
+                    length = std::min(length, static_cast<std::size_t>(spec.precision));
+                WritePadded(out, arg.text, length, spec, false);
+                break;
+            }
+            case LogArgType::Pointer: {
+                char digits[2 + 16] = { '0', 'x' };
+                const auto value = static_cast<unsigned long long>(reinterpret_cast<std::uintptr_t>(arg.pointer));
+                const std::to_chars_result result = std::to_chars(digits + 2, digits + sizeof(digits), value, 16);
+                WritePadded(out, digits, static_cast<std::size_t>(result.ptr - digits), spec, true);
+                break;
+            }
+            }
+        }
+    } // namespace
+
+    namespace Detail
+    {
+        void LogFormatError(const char* problem)
+        {
+            static_cast<void>(problem);
+        }
+    } // namespace Detail
+
+    std::size_t FormatLogArgs(char* out, std::size_t size, const char* fmt, const LogFormatArg* args, std::size_t count)
+    {
+        if (size == 0)
+            return 0;
+
+        Output output(out, size - 1);
+        std::size_t next = 0;
+        const char* p = fmt ? fmt : "";
+        while (*p != '\0' && !output.Full()) {
+            const char* run = p;
+            while (*p != '\0' && *p != '{' && *p != '}')
+                ++p;
+            output.Append(run, static_cast<std::size_t>(p - run));
+            if (*p == '\0')
+                break;
+
+            // {{ and }} print one brace, as does a stray }
+            if (*p == '}' || p[1] == '{') {
+                output.Append(p, 1);
+                p += (p[1] == *p) ? 2 : 1;
+                continue;
+            }
+
+            Spec spec;
+            p = ParseSpec(p + 1, spec);
+            if (*p != '}')
+                break;
+            ++p;
+            if (next < count)
+                WriteArg(output, args[next++], spec);
+        }
+
+        const std::size_t length = output.Used();
+        out[length] = '\0';
+        return length;
+    }
+
+} // namespace KibakoEngine
@@ -0,0 +1,230 @@
+// Heap allocation tracking per subsystem tag
+#include "KibakoEngine/Core/MemoryTracker.h"
+
+#include "KibakoEngine/Core/Log.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+namespace KibakoEngine {
+
+    namespace
+    {
+        constexpr const char* kLogChannel = "Memory";
+
+        struct TagCounters
+        {
+            std::atomic<std::int64_t>  liveBytes{ 0 };
+            std::atomic<std::int64_t>  peakBytes{ 0 };
+            std::atomic<std::int64_t>  liveAllocations{ 0 };
+            std::atomic<std::uint64_t> totalAllocations{ 0 };
+            std::atomic<std::uint64_t> frameAllocations{ 0 };
+            std::atomic<std::uint64_t> frameBytes{ 0 };
+            std::atomic<std::uint64_t> lastFrameAllocations{ 0 };
+            std::atomic<std::uint64_t> lastFrameBytes{ 0 };
+        };
+
+        // Constant-initialized, so allocations during static init are counted safely
+        TagCounters g_counters[kMemoryTagCount];
+
+        thread_local MemoryTag t_tag = MemoryTag::General;
+    }
+
+    const char* MemoryTagName(MemoryTag tag)
+    {
+        switch (tag) {
+        case MemoryTag::General:     return "General";
+        case MemoryTag::Renderer:    return "Renderer";
+        case MemoryTag::SpriteBatch: return "SpriteBatch";
+        case MemoryTag::Texture:     return "Texture";
+        case MemoryTag::Font:        return "Font";
+        case MemoryTag::UI:          return "UI";
+        case MemoryTag::Scene:       return "Scene";
+        case MemoryTag::Assets:      return "Assets";
+        case MemoryTag::Profiler:    return "Profiler";
+        default:                     return "Unknown";
+        }
+    }
+
+    namespace MemoryTracker {
+
+        void BeginFrame()
+        {
+            for (TagCounters& counters : g_counters) {
+                counters.lastFrameAllocations.store(counters.frameAllocations.exchange(0, std::memory_order_relaxed),
+                                                    std::memory_order_relaxed);
+                counters.lastFrameBytes.store(counters.frameBytes.exchange(0, std::memory_order_relaxed),
+                                              std::memory_order_relaxed);
+            }
+        }
+
+        MemoryTagStats Stats(MemoryTag tag)
+        {
+            MemoryTagStats stats{};
+            const auto index = static_cast<std::size_t>(tag);
+            if (index >= kMemoryTagCount)
+                return stats;
+
+            const TagCounters& counters = g_counters[index];
+            stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+            stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+            stats.liveAllocations = counters.liveAllocations.load(std::memory_order_relaxed);
+            stats.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+            stats.frameAllocations = counters.lastFrameAllocations.load(std::memory_order_relaxed);
+            stats.frameBytes = counters.lastFrameBytes.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+        void LogSummary()
+        {
+            if (!IsEnabled())
+                return;
+
+            for (std::size_t i = 0; i < kMemoryTagCount; ++i) {
+                const MemoryTagStats stats = Stats(static_cast<MemoryTag>(i));
+                if (stats.totalAllocations == 0)
+                    continue;
+
+                KbkLog(kLogChannel, "%-12s live %lld B in %lld blocks, peak %lld B, %llu allocations total",
+                    MemoryTagName(static_cast<MemoryTag>(i)),
+                    static_cast<long long>(stats.liveBytes), static_cast<long long>(stats.liveAllocations),
+                    static_cast<long long>(stats.peakBytes), static_cast<unsigned long long>(stats.totalAllocations));
+            }
+        }
+
+        MemoryTag CurrentTag()
+        {
+            return t_tag;
+        }
+
+#if KBK_ENABLE_MEMORY_TRACKING
+        TagScope::TagScope(MemoryTag tag)
+            : m_previous(t_tag)
+        {
+            t_tag = tag;
+        }
+
+        TagScope::~TagScope()
+        {
+            t_tag = m_previous;
+        }
+#endif
+
+    } // namespace MemoryTracker
+
+} // namespace KibakoEngine
+
+#if KBK_ENABLE_MEMORY_TRACKING
+
+namespace {
+
+    using KibakoEngine::MemoryTag;
+
+    // Sits right before the returned pointer; 16 bytes keeps the default new alignment
+    struct BlockHeader
+    {
+        std::uint64_t size;
+        std::uint32_t offset;  // From the malloc'd block to the user pointer
+        std::uint8_t  tag;
+        std::uint8_t  padding[3];
+    };
+    static_assert(sizeof(BlockHeader) == 16, "BlockHeader must stay 16 bytes");
+
+    void RecordAllocation(MemoryTag tag, std::size_t size)
+    {
+        auto& counters = KibakoEngine::g_counters[static_cast<std::size_t>(tag)];
+        const auto bytes = static_cast<std::int64_t>(size);
+
+        const std::int64_t live = counters.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        std::int64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+        while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+
+        counters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.frameBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void* TrackedAlloc(std::size_t size, std::size_t alignment)
+    {
+        if (alignment < alignof(BlockHeader))
+            alignment = alignof(BlockHeader);
+
+        // Room for the header plus worst-case alignment slack
+        const std::size_t slack = alignment > sizeof(BlockHeader) ? alignment : 0;
+        // The total would wrap to a tiny block; fail like malloc so operator new throws
+        if (size > std::numeric_limits<std::size_t>::max() - sizeof(BlockHeader) - slack)
+            return nullptr;
+        void* raw = std::malloc(size + sizeof(BlockHeader) + slack);
+        if (!raw)
+            return nullptr;
+
+        const auto base = reinterpret_cast<std::uintptr_t>(raw) + sizeof(BlockHeader);
+        const std::uintptr_t user = (base + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+
+        const MemoryTag tag = KibakoEngine::MemoryTracker::CurrentTag();
+        auto* header = reinterpret_cast<BlockHeader*>(user) - 1;
+        header->size = size;
+        header->offset = static_cast<std::uint32_t>(user - reinterpret_cast<std::uintptr_t>(raw));
+        header->tag = static_cast<std::uint8_t>(tag);
+
+        RecordAllocation(tag, size);
+        return reinterpret_cast<void*>(user);
+    }
+
+    void* TrackedAllocOrThrow(std::size_t size, std::size_t alignment)
+    {
+        for (;;) {
+            if (void* p = TrackedAlloc(size, alignment))
+                return p;
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void TrackedFree(void* p) noexcept
+    {
+        if (!p)
+            return;
+
+        const BlockHeader* header = static_cast<const BlockHeader*>(p) - 1;
+        auto& counters = KibakoEngine::g_counters[header->tag];
+        counters.liveBytes.fetch_sub(static_cast<std::int64_t>(header->size), std::memory_order_relaxed);
+        counters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+
+        std::free(static_cast<std::uint8_t*>(p) - header->offset);
+    }
+
+    constexpr std::size_t kDefaultAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+} // namespace
+
+void* operator new(std::size_t size) { return TrackedAllocOrThrow(size, kDefaultAlignment); }
+void* operator new[](std::size_t size) { return TrackedAllocOrThrow(size, kDefaultAlignment); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return TrackedAlloc(size, kDefaultAlignment); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return TrackedAlloc(size, kDefaultAlignment); }
+void* operator new(std::size_t size, std::align_val_t align) { return TrackedAllocOrThrow(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align) { return TrackedAllocOrThrow(size, static_cast<std::size_t>(align)); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return TrackedAlloc(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return TrackedAlloc(size, static_cast<std::size_t>(align)); }
+
+void operator delete(void* p) noexcept { TrackedFree(p); }
+void operator delete[](void* p) noexcept { TrackedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { TrackedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { TrackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { TrackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { TrackedFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { TrackedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { TrackedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { TrackedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { TrackedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { TrackedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { TrackedFree(p); }
+
+#endif
@@ -0,0 +1,244 @@
+// Named per-frame performance counters shared by every subsystem
+#include "KibakoEngine/Core/PerfCounters.h"
+
+#include "KibakoEngine/Core/Log.h"
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace KibakoEngine {
+
+    namespace
+    {
+        constexpr const char* kLogChannel = "PerfCounters";
+
+        // Slot 0 collects whatever is published once the registry is full
+        constexpr PerfCounterId kOverflowId = 0;
+
+        // Running totals owned by one thread; only that thread writes, BeginFrame reads
+        struct ThreadBlock
+        {
+            std::atomic<std::uint64_t> totals[PerfCounters::kMaxCounters] = {};
+        };
+
+        struct CounterInfo
+        {
+            std::string     name;
+            PerfCounterUnit unit = PerfCounterUnit::Count;
+        };
+
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<CounterInfo>                       counters;
+            std::unordered_map<std::string, PerfCounterId> ids;
+            std::vector<std::unique_ptr<ThreadBlock>>      blocks;
+
+            // Written under the mutex by BeginFrame
+            std::uint64_t previousTotals[PerfCounters::kMaxCounters] = {};
+            std::uint64_t frameValues[PerfCounters::kMaxCounters] = {};
+            std::uint64_t frameIndex = 0;
+
+            std::FILE* jsonLines = nullptr;
+
+            Registry()
+            {
+                counters.push_back({ "perf.overflow", PerfCounterUnit::Count });
+                ids.emplace(counters.back().name, kOverflowId);
+            }
+        };
+
+        Registry& GetRegistry()
+        {
+            static Registry s_registry;
+            return s_registry;
+        }
+
+        thread_local ThreadBlock* t_block = nullptr;
+
+        // Blocks are owned by the registry so totals survive their thread
+        ThreadBlock* RegisterThread()
+        {
+            auto block = std::make_unique<ThreadBlock>();
+            t_block = block.get();
+
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            registry.blocks.push_back(std::move(block));
+            return t_block;
+        }
+
+        std::uint64_t SumTotals(const Registry& registry, std::size_t index)
+        {
+            std::uint64_t sum = 0;
+            for (const auto& block : registry.blocks)
+                sum += block->totals[index].load(std::memory_order_relaxed);
+            return sum;
+        }
+
+        void WriteJsonLine(Registry& registry)
+        {
+            std::FILE* file = registry.jsonLines;
+            std::fprintf(file, "{\"frame\":%llu,\"counters\":{", static_cast<unsigned long long>(registry.frameIndex));
+            for (std::size_t i = 0; i < registry.counters.size(); ++i) {
+                std::fprintf(file, "%s\"%s\":%llu", i == 0 ? "" : ",", registry.counters[i].name.c_str(),
+                    static_cast<unsigned long long>(registry.frameValues[i]));
+            }
+            std::fprintf(file, "}}\n");
+        }
+    }
+
+    const char* PerfCounterUnitName(PerfCounterUnit unit)
+    {
+        switch (unit) {
+        case PerfCounterUnit::Count:       return "count";
+        case PerfCounterUnit::Bytes:       return "bytes";
+        case PerfCounterUnit::Nanoseconds: return "ns";
+        default:                           return "unknown";
+        }
+    }
+
+    namespace PerfCounters {
+
+        PerfCounterId Register(std::string_view name, PerfCounterUnit unit)
+        {
+            // Names are written into JSON unescaped
+            KBK_ASSERT(name.find('"') == std::string_view::npos && name.find('\\') == std::string_view::npos,
+                "Perf counter names must not contain quotes or backslashes");
+
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+
+            const std::string key(name);
+            const auto it = registry.ids.find(key);
+            if (it != registry.ids.end()) {
+                KBK_ASSERT(registry.counters[it->second].unit == unit, "Perf counter registered with two units");
+                return it->second;
+            }
+
+            if (registry.counters.size() >= kMaxCounters) {
+                KbkWarn(kLogChannel, "Counter limit (%zu) reached; '%s' is counted as perf.overflow",
+                    kMaxCounters, key.c_str());
+                return kOverflowId;
+            }
+
+            const auto id = static_cast<PerfCounterId>(registry.counters.size());
+            registry.counters.push_back({ key, unit });
+            registry.ids.emplace(key, id);
+            return id;
+        }
+
+        void Add(PerfCounterId id, std::uint64_t value)
+        {
+            KBK_ASSERT(id < kMaxCounters, "Invalid perf counter id");
+
+            ThreadBlock* block = t_block;
+            if (!block)
+                block = RegisterThread();
+
+            // Single writer: a plain load/store pair avoids a locked add
+            std::atomic<std::uint64_t>& total = block->totals[id];
+            total.store(total.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        void BeginFrame()
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+
+            for (std::size_t i = 0; i < registry.counters.size(); ++i) {
+                const std::uint64_t total = SumTotals(registry, i);
+                registry.frameValues[i] = total - registry.previousTotals[i];
+                registry.previousTotals[i] = total;
+            }
+
+            if (registry.jsonLines)
+                WriteJsonLine(registry);
+            ++registry.frameIndex;
+        }
+
+        std::uint64_t FrameIndex()
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            return registry.frameIndex;
+        }
+
+        std::uint64_t FrameValue(PerfCounterId id)
+        {
+            if (id >= kMaxCounters)
+                return 0;
+
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            return registry.frameValues[id];
+        }
+
+        void GetSnapshot(std::vector<PerfCounterValue>& out)
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+
+            out.resize(registry.counters.size());
+            for (std::size_t i = 0; i < registry.counters.size(); ++i) {
+                PerfCounterValue& value = out[i];
+                value.name = registry.counters[i].name;
+                value.unit = registry.counters[i].unit;
+                value.frameValue = registry.frameValues[i];
+                value.total = SumTotals(registry, i);
+            }
+        }
+
+        bool OpenJsonLines(const std::string& path)
+        {
+            CloseJsonLines();
+
+            std::FILE* file = std::fopen(path.c_str(), "wb");
+            if (!file) {
+                KbkError(kLogChannel, "Failed to open %s for writing", path.c_str());
+                return false;
+            }
+
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            registry.jsonLines = file;
+            KbkLog(kLogChannel, "Writing per-frame counters to %s", path.c_str());
+            return true;
+        }
+
+        void CloseJsonLines()
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            if (!registry.jsonLines)
+                return;
+
+            if (std::ferror(registry.jsonLines) != 0)
+                KbkError(kLogChannel, "Failed to write the counter JSON lines");
+            std::fclose(registry.jsonLines);
+            registry.jsonLines = nullptr;
+        }
+
+        void LogSummary()
+        {
+            std::vector<PerfCounterValue> values;
+            GetSnapshot(values);
+            const std::uint64_t frames = FrameIndex();
+
+            for (const PerfCounterValue& value : values) {
+                if (value.total == 0)
+                    continue;
+
+                const double perFrame = frames > 0 ? static_cast<double>(value.total) / static_cast<double>(frames) : 0.0;
+                KbkLog(kLogChannel, "%-24s total %llu %s, %.1f per frame",
+                    value.name.c_str(), static_cast<unsigned long long>(value.total),
+                    PerfCounterUnitName(value.unit), perFrame);
+            }
+        }
+
+    } // namespace PerfCounters
+
+} // namespace KibakoEngine
@@ -3,11 +3,22 @@
 
 #if KBK_ENABLE_PROFILING
 
+#include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/MemoryTracker.h"
+
 #include <algorithm>
-#include <limits>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace KibakoEngine::Profiler {
 
@@ -15,89 +26,864 @@ namespace KibakoEngine::Profiler {
     {
         using Clock = std::chrono::steady_clock;
 
-        struct SampleData
+        // Frames between logged summaries; shipping builds only log on Flush
+        constexpr std::uint32_t kFlushInterval = KBK_DEBUG_BUILD ? 120 : 0;
+        // Per thread; drained every frame, so this bounds events per thread per frame
+        constexpr std::uint64_t kRingCapacity = 8192;
+        static_assert((kRingCapacity & (kRingCapacity - 1)) == 0, "Ring capacity must be a power of two");
+        // Bounds capture memory (~32 bytes per event)
+        constexpr std::size_t kMaxCaptureEvents = 4u * 1024u * 1024u;
+        // Frames kept per call tree node for percentiles
+        constexpr std::uint32_t kHistoryFrames = 128;
+        // Events of a root scope that has not ended yet; beyond this the subtree is discarded
+        constexpr std::size_t kMaxPendingEvents = 65536;
+        constexpr std::uint32_t kNoNode = CallTree::kNoParent;
+
+        using Detail::ScopeId;
+
+        struct EventRecord
+        {
+            ScopeId       scope;
+            std::uint32_t depth;
+            std::int64_t  start;
+            std::int64_t  end;
+        };
+
+        // Drained record with its name resolved
+        struct PendingEvent
+        {
+            const char*   name;
+            std::uint32_t depth;
+            std::int64_t  start;
+            std::int64_t  end;
+        };
+
+        // Single producer (the owning thread), single consumer (the drain, under the registry mutex)
+        struct ThreadEventRing
+        {
+            std::array<EventRecord, kRingCapacity> records;
+
+            // Producer side; cachedTail spares a load of the consumer's line on every push
+            std::atomic<std::uint64_t> head{ 0 };
+            std::uint64_t              cachedTail = 0;
+            std::atomic<std::uint64_t> dropped{ 0 };
+            // Keeps the consumer's index off the producer's cache line
+            std::uint8_t               padding[64];
+            std::atomic<std::uint64_t> tail{ 0 };
+
+            // Set by the owning thread as it exits; the next drain empties and frees the ring
+            std::atomic<bool> retired{ false };
+
+            // Set at registration / SetThreadName, under the registry mutex
+            std::uint32_t threadIndex = 0;
+            char          name[32] = {};
+
+            // Consumer side: drained events waiting for their root scope to end
+            std::vector<PendingEvent> pending;
+            std::uint32_t            treeRoot = kNoNode;
+        };
+
+        struct TreeNode
+        {
+            const char*                name = nullptr;  // nullptr for thread roots
+            std::uint32_t              parent = kNoNode;
+            std::uint32_t              thread = 0;
+            std::vector<std::uint32_t> children;
+
+            // Frame being accumulated
+            std::int64_t  frameInclusive = 0;
+            std::int64_t  frameChildren = 0;
+            std::uint32_t frameHits = 0;
+
+            // Last closed frame
+            std::int64_t  lastInclusive = 0;
+            std::int64_t  lastExclusive = 0;
+            std::uint32_t lastHits = 0;
+
+            // Since the last logged summary
+            std::int64_t  intervalInclusive = 0;
+            std::int64_t  intervalExclusive = 0;
+            std::int64_t  intervalMax = 0;
+            std::uint64_t intervalHits = 0;
+
+            std::array<std::int64_t, kHistoryFrames> history{};
+        };
+
+        struct CapturedEvent
+        {
+            const char*   name;
+            std::int64_t  start;
+            std::int64_t  end;
+            std::uint32_t thread;
+        };
+
+        struct FrameMarker
         {
-            double totalMs = 0.0;
-            double maxMs = 0.0;
-            double minMs = std::numeric_limits<double>::max();
-            std::uint32_t hits = 0;
+            std::int64_t  ticks;
+            std::uint32_t frame;
         };
 
-        std::mutex& ProfilerMutex()
+        struct CaptureThread
         {
-            static std::mutex s_mutex;
-            return s_mutex;
+            std::uint32_t index;
+            std::string   name;
+        };
+
+        struct Capture
+        {
+            std::string                path;
+            std::int64_t               startTicks = 0;
+            std::uint32_t              framesLeft = 0;
+            std::vector<CapturedEvent> events;
+            std::vector<FrameMarker>   frames;
+            std::vector<CaptureThread> threads;
+            std::uint64_t              truncated = 0;
+        };
+
+        struct Registry
+        {
+            Registry();
+
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ThreadEventRing>> rings;
+            std::uint32_t nextThreadIndex = 0;
+            // Dropped by rings already freed, so the totals never go backwards
+            std::uint64_t retiredDropped = 0;
+            // Call tree roots of exited threads, handed to the next thread that registers
+            std::vector<std::uint32_t> freeRoots;
+
+            // Interned scope names, indexed by ScopeId
+            std::vector<const char*>                          scopeNames;
+            std::unordered_map<std::string_view, ScopeId>     scopeIds;
+
+            // Tick calibration base (steady_clock ns at tick0)
+            std::int64_t tick0 = 0;
+            std::int64_t ns0 = 0;
+
+            // Call tree; nodes are never removed, so indices stay valid
+            std::vector<TreeNode>      nodes;
+            std::vector<std::uint32_t> pathStack;
+            std::uint32_t              historyHead = 0;
+            std::uint32_t              historyCount = 0;
+            std::uint32_t              intervalFrames = 0;
+            std::uint64_t              discardedEvents = 0;
+
+            std::uint32_t frames = 0;
+            std::uint64_t droppedReported = 0;
+            std::uint64_t discardedReported = 0;
+
+            bool    capturing = false;
+            Capture capture;
+        };
+
+        // Read without the registry mutex, so trace writing and queries never block on it
+        std::atomic<double> g_msPerTick{ 1000.0 * static_cast<double>(Clock::period::num) /
+                                         static_cast<double>(Clock::period::den) };
+
+        std::int64_t SteadyNs()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
         }
 
-        std::unordered_map<std::string, SampleData>& Samples()
+        Registry::Registry()
         {
-            static std::unordered_map<std::string, SampleData> s_samples;
-            return s_samples;
+#if KBK_PROFILER_USE_TSC
+            // Rough rate from a short spin; RefineCalibration sharpens it every frame
+            tick0 = Detail::NowTicks();
+            ns0 = SteadyNs();
+            std::int64_t ns = ns0;
+            while (ns - ns0 < 1'000'000)
+                ns = SteadyNs();
+            const std::int64_t ticks = Detail::NowTicks() - tick0;
+            if (ticks > 0)
+                g_msPerTick.store(static_cast<double>(ns - ns0) / 1.0e6 / static_cast<double>(ticks), std::memory_order_relaxed);
+#endif
         }
 
-        std::uint32_t& FrameCounter()
+        // Caller holds registry.mutex; the longer the baseline, the better the estimate
+        void RefineCalibration(Registry& registry)
         {
-            static std::uint32_t s_frames = 0;
-            return s_frames;
+#if KBK_PROFILER_USE_TSC
+            const std::int64_t ns = SteadyNs() - registry.ns0;
+            const std::int64_t ticks = Detail::NowTicks() - registry.tick0;
+            if (ns >= 100'000'000 && ticks > 0)
+                g_msPerTick.store(static_cast<double>(ns) / 1.0e6 / static_cast<double>(ticks), std::memory_order_relaxed);
+#else
+            KBK_UNUSED(registry);
+#endif
         }
 
-        constexpr std::uint32_t kFlushInterval = 120;
+        Registry& GetRegistry()
+        {
+            static Registry s_registry;
+            return s_registry;
+        }
+
+        thread_local ThreadEventRing* t_ring = nullptr;
+        // Scopes closing in other thread_local destructors after the ring retired are dropped
+        thread_local bool t_ringRetired = false;
+
+        // Retires the thread's ring when the thread exits; it takes no lock, the drain frees it
+        struct RingOwner
+        {
+            ThreadEventRing* ring = nullptr;
+
+            ~RingOwner()
+            {
+                if (!ring)
+                    return;
+                t_ring = nullptr;
+                t_ringRetired = true;
+                ring->retired.store(true, std::memory_order_release);
+            }
+        };
+
+        thread_local RingOwner t_ringOwner;
+
+        // Rings are owned by the registry so events survive their thread until drained
+        ThreadEventRing* RegisterThread()
+        {
+            if (t_ringRetired)
+                return nullptr;
+
+            KBK_MEMORY_TAG(Profiler);
+            auto ring = std::make_unique<ThreadEventRing>();
+            t_ring = ring.get();
+            t_ringOwner.ring = t_ring;
+
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            ring->threadIndex = registry.nextThreadIndex++;
+            Detail::t_threadIndex = ring->threadIndex;
+            std::snprintf(ring->name, sizeof(ring->name), "Thread %u", ring->threadIndex);
+            if (!registry.freeRoots.empty()) {
+                ring->treeRoot = registry.freeRoots.back();
+                registry.freeRoots.pop_back();
+                registry.nodes[ring->treeRoot].thread = ring->threadIndex;
+            }
+            registry.rings.push_back(std::move(ring));
+            return t_ring;
+        }
+
+        // Null once the calling thread's ring has retired
+        ThreadEventRing* LocalRing()
+        {
+            ThreadEventRing* ring = t_ring;
+            return ring ? ring : RegisterThread();
+        }
+
+        double TicksToMs(std::int64_t ticks)
+        {
+            return static_cast<double>(ticks) * g_msPerTick.load(std::memory_order_relaxed);
+        }
+
+        double TicksToUs(std::int64_t ticks)
+        {
+            return TicksToMs(ticks) * 1000.0;
+        }
+
+        std::uint32_t AddNode(Registry& registry, const char* name, std::uint32_t parent, std::uint32_t thread)
+        {
+            const auto index = static_cast<std::uint32_t>(registry.nodes.size());
+            TreeNode& node = registry.nodes.emplace_back();
+            node.name = name;
+            node.parent = parent;
+            node.thread = thread;
+            if (parent != kNoNode)
+                registry.nodes[parent].children.push_back(index);
+            return index;
+        }
+
+        std::uint32_t FindOrAddChild(Registry& registry, std::uint32_t parent, const char* name)
+        {
+            for (std::uint32_t child : registry.nodes[parent].children) {
+                // Interned, so equal names share a pointer
+                if (registry.nodes[child].name == name)
+                    return child;
+            }
+            return AddNode(registry, name, parent, registry.nodes[parent].thread);
+        }
+
+        // pending holds one root scope and its descendants in end order (post-order).
+        // Walking it backwards visits every parent before its children.
+        void ResolvePending(Registry& registry, ThreadEventRing& ring)
+        {
+            if (ring.treeRoot == kNoNode)
+                ring.treeRoot = AddNode(registry, nullptr, kNoNode, ring.threadIndex);
+
+            std::vector<std::uint32_t>& stack = registry.pathStack;
+            std::uint32_t maxDepth = 0;
+            for (auto it = ring.pending.rbegin(); it != ring.pending.rend(); ++it) {
+                // A dropped parent leaves a gap; hang its children off the nearest ancestor
+                const std::uint32_t depth = std::min(it->depth, maxDepth);
+                const std::uint32_t parent = depth == 0 ? ring.treeRoot : stack[depth - 1];
+                const std::uint32_t index = FindOrAddChild(registry, parent, it->name);
+
+                if (stack.size() <= depth)
+                    stack.resize(depth + 1);
+                stack[depth] = index;
+                maxDepth = depth + 1;
+
+                const std::int64_t duration = it->end - it->start;
+                TreeNode& node = registry.nodes[index];
+                node.frameInclusive += duration;
+                node.frameHits += 1;
+
+                TreeNode& parentNode = registry.nodes[parent];
+                parentNode.frameChildren += duration;
+                if (depth == 0)
+                    parentNode.frameInclusive += duration;
+            }
+            ring.pending.clear();
+        }
+
+        // Caller holds registry.mutex
+        void CloseFrame(Registry& registry)
+        {
+            for (TreeNode& node : registry.nodes) {
+                const std::int64_t exclusive = node.frameInclusive - node.frameChildren;
+                node.lastInclusive = node.frameInclusive;
+                node.lastExclusive = exclusive;
+                node.lastHits = node.frameHits;
+
+                node.intervalInclusive += node.frameInclusive;
+                node.intervalExclusive += exclusive;
+                node.intervalMax = std::max(node.intervalMax, node.frameInclusive);
+                node.intervalHits += node.frameHits;
+
+                node.history[registry.historyHead] = node.frameInclusive;
+                node.frameInclusive = 0;
+                node.frameChildren = 0;
+                node.frameHits = 0;
+            }
+
+            registry.historyHead = (registry.historyHead + 1) % kHistoryFrames;
+            registry.historyCount = std::min(registry.historyCount + 1, kHistoryFrames);
+            ++registry.intervalFrames;
+        }
+
+        // Caller holds registry.mutex and has just drained every ring. The tree root of an
+        // exited thread is reused by the next new one, so short-lived threads do not grow the tree.
+        void FreeRetiredRings(Registry& registry)
+        {
+            auto retired = [](const std::unique_ptr<ThreadEventRing>& ring) {
+                return ring->retired.load(std::memory_order_acquire) &&
+                       ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_acquire);
+            };
+
+            for (const auto& ring : registry.rings) {
+                if (!retired(ring))
+                    continue;
+                // Scopes left open when the thread ended never resolve
+                registry.discardedEvents += ring->pending.size();
+                registry.retiredDropped += ring->dropped.load(std::memory_order_relaxed);
+                if (ring->treeRoot != kNoNode)
+                    registry.freeRoots.push_back(ring->treeRoot);
+                if (registry.capturing)
+                    registry.capture.threads.push_back({ ring->threadIndex, ring->name });
+            }
+
+            registry.rings.erase(std::remove_if(registry.rings.begin(), registry.rings.end(), retired),
+                                 registry.rings.end());
+        }
+
+        // Caller holds registry.mutex
+        void DrainRings(Registry& registry)
+        {
+            Capture& capture = registry.capture;
+            bool anyRetired = false;
+            for (const auto& ring : registry.rings) {
+                // Read before head: every event of a retired thread is then visible below
+                const bool retired = ring->retired.load(std::memory_order_acquire);
+                anyRetired = anyRetired || retired;
+
+                std::uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+                const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+
+                for (; tail != head; ++tail) {
+                    const EventRecord& record = ring->records[tail & (kRingCapacity - 1)];
+
+                    const char* name = registry.scopeNames[record.scope];
+
+                    if (registry.capturing && record.start >= capture.startTicks) {
+                        if (capture.events.size() < kMaxCaptureEvents)
+                            capture.events.push_back({ name, record.start, record.end, ring->threadIndex });
+                        else
+                            ++capture.truncated;
+                    }
+
+                    if (ring->pending.size() >= kMaxPendingEvents) {
+                        registry.discardedEvents += ring->pending.size();
+                        ring->pending.clear();
+                    }
+
+                    ring->pending.push_back({ name, record.depth, record.start, record.end });
+                    if (record.depth == 0)
+                        ResolvePending(registry, *ring);
+                }
+
+                ring->tail.store(tail, std::memory_order_release);
+            }
+
+            if (anyRetired)
+                FreeRetiredRings(registry);
+        }
+
+        void WriteJsonString(std::FILE* file, const char* text)
+        {
+            std::fputc('"', file);
+            for (const char* c = text ? text : "<null>"; *c != '\0'; ++c) {
+                const unsigned char ch = static_cast<unsigned char>(*c);
+                if (ch == '"' || ch == '\\')
+                    std::fprintf(file, "\\%c", ch);
+                else if (ch < 0x20)
+                    std::fprintf(file, "\\u%04x", ch);
+                else
+                    std::fputc(ch, file);
+            }
+            std::fputc('"', file);
+        }
+
+        // Complete ("X") events nest by time in the viewer; frames are global instant events
+        bool WriteChromeTrace(const Capture& capture)
+        {
+            std::FILE* file = std::fopen(capture.path.c_str(), "wb");
+            if (!file) {
+                KbkError("Profile", "Failed to open %s for the trace capture", capture.path.c_str());
+                return false;
+            }
+
+            std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+            bool first = true;
+            auto separator = [&]() {
+                if (!first)
+                    std::fprintf(file, ",\n");
+                first = false;
+            };
+
+            for (const CaptureThread& thread : capture.threads) {
+                separator();
+                std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", thread.index);
+                WriteJsonString(file, thread.name.c_str());
+                std::fprintf(file, "}}");
+            }
+
+            for (const FrameMarker& marker : capture.frames) {
+                separator();
+                std::fprintf(file, "{\"name\":\"Frame %u\",\"cat\":\"frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":%.3f}",
+                    marker.frame, TicksToUs(marker.ticks - capture.startTicks));
+            }
+
+            for (const CapturedEvent& event : capture.events) {
+                separator();
+                std::fprintf(file, "{\"name\":");
+                WriteJsonString(file, event.name);
+                std::fprintf(file, ",\"cat\":\"scope\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    event.thread,
+                    TicksToUs(event.start - capture.startTicks),
+                    TicksToUs(event.end - event.start));
+            }
+
+            std::fprintf(file, "\n]}\n");
+            const bool ok = std::ferror(file) == 0;
+            std::fclose(file);
+
+            if (!ok) {
+                KbkError("Profile", "Failed to write %s", capture.path.c_str());
+                return false;
+            }
+
+            KbkLog("Profile", "Wrote trace %s (%zu events, %zu frames%s)",
+                capture.path.c_str(), capture.events.size(), capture.frames.size(),
+                capture.truncated > 0 ? ", truncated" : "");
+            return true;
+        }
+
+        // Caller holds registry.mutex; returns the finished capture to write outside the lock
+        Capture EndCapture(Registry& registry)
+        {
+            Capture capture = std::move(registry.capture);
+            registry.capture = Capture{};
+            registry.capturing = false;
+
+            for (const auto& ring : registry.rings)
+                capture.threads.push_back({ ring->threadIndex, ring->name });
+            return capture;
+        }
+
+        struct VisitEntry
+        {
+            std::uint32_t node;
+            std::uint32_t depth;
+            std::uint32_t parentEntry;
+        };
+
+        // Caller holds registry.mutex; thread roots in registration order, children in first-seen order
+        void CollectPreorder(const Registry& registry, std::vector<VisitEntry>& out)
+        {
+            std::vector<VisitEntry> stack;
+            for (const auto& ring : registry.rings) {
+                if (ring->treeRoot == kNoNode)
+                    continue;
+
+                stack.push_back({ ring->treeRoot, 0, kNoNode });
+                while (!stack.empty()) {
+                    const VisitEntry entry = stack.back();
+                    stack.pop_back();
+
+                    const auto entryIndex = static_cast<std::uint32_t>(out.size());
+                    out.push_back(entry);
+
+                    const std::vector<std::uint32_t>& children = registry.nodes[entry.node].children;
+                    for (auto it = children.rbegin(); it != children.rend(); ++it)
+                        stack.push_back({ *it, entry.depth + 1, entryIndex });
+                }
+            }
+        }
+
+        std::string NodeName(const Registry& registry, const TreeNode& node)
+        {
+            if (node.name)
+                return node.name;
+            for (const auto& ring : registry.rings) {
+                if (ring->threadIndex == node.thread)
+                    return ring->name;
+            }
+            return "Thread " + std::to_string(node.thread);
+        }
+
+        void LogSummary()
+        {
+            struct SummaryLine
+            {
+                std::string   name;
+                std::uint32_t depth;
+                double        inclusiveMs;
+                double        exclusiveMs;
+                double        maxMs;
+                double        hits;
+            };
+
+            Registry& registry = GetRegistry();
+            std::vector<SummaryLine> lines;
+            std::uint64_t newlyDropped = 0;
+            std::uint64_t newlyDiscarded = 0;
+            {
+                std::lock_guard<std::mutex> guard(registry.mutex);
+                DrainRings(registry);
+
+                if (registry.intervalFrames > 0) {
+                    const double frames = static_cast<double>(registry.intervalFrames);
+                    std::vector<VisitEntry> order;
+                    CollectPreorder(registry, order);
+
+                    lines.reserve(order.size());
+                    for (const VisitEntry& entry : order) {
+                        const TreeNode& node = registry.nodes[entry.node];
+                        if (node.intervalInclusive == 0 && node.intervalHits == 0)
+                            continue;
+                        lines.push_back({ NodeName(registry, node), entry.depth,
+                            TicksToMs(node.intervalInclusive) / frames,
+                            TicksToMs(node.intervalExclusive) / frames,
+                            TicksToMs(node.intervalMax),
+                            static_cast<double>(node.intervalHits) / frames });
+                    }
+                }
+
+                for (TreeNode& node : registry.nodes) {
+                    node.intervalInclusive = 0;
+                    node.intervalExclusive = 0;
+                    node.intervalMax = 0;
+                    node.intervalHits = 0;
+                }
+                registry.intervalFrames = 0;
+
+                std::uint64_t dropped = registry.retiredDropped;
+                for (const auto& ring : registry.rings)
+                    dropped += ring->dropped.load(std::memory_order_relaxed);
+                newlyDropped = dropped - registry.droppedReported;
+                registry.droppedReported = dropped;
+
+                newlyDiscarded = registry.discardedEvents - registry.discardedReported;
+                registry.discardedReported = registry.discardedEvents;
+            }
+
+            if (newlyDropped > 0)
+                KbkWarn("Profile", "%llu events dropped (thread ring full)", static_cast<unsigned long long>(newlyDropped));
+            if (newlyDiscarded > 0)
+                KbkWarn("Profile", "%llu events discarded (root scope still open)", static_cast<unsigned long long>(newlyDiscarded));
+
+            // Per-frame averages over the interval; max is the worst single frame
+            for (const SummaryLine& line : lines) {
+                KbkTrace("Profile", "%*s%s -> incl %.3f ms, excl %.3f ms, max %.3f ms, %.1f hits/frame",
+                         static_cast<int>(line.depth * 2), "", line.name.c_str(),
+                         line.inclusiveMs, line.exclusiveMs, line.maxMs, line.hits);
+            }
+        }
     } // namespace
 
-    ScopedEvent::ScopedEvent(const char* name)
-        : m_name(name)
-        , m_start(Clock::now())
+    namespace Detail
+    {
+        ScopeId InternScope(const char* name)
+        {
+            KBK_MEMORY_TAG(Profiler);
+            if (!name)
+                name = "<null>";
+
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            const auto [it, inserted] = registry.scopeIds.try_emplace(std::string_view(name),
+                static_cast<ScopeId>(registry.scopeNames.size()));
+            if (inserted)
+                registry.scopeNames.push_back(name);
+            return it->second;
+        }
+
+        const char* ScopeName(ScopeId scope)
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            return scope < registry.scopeNames.size() ? registry.scopeNames[scope] : "<unknown>";
+        }
+
+        std::string ThreadName(std::uint32_t threadIndex)
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            for (const auto& ring : registry.rings) {
+                if (ring->threadIndex == threadIndex)
+                    return ring->name;
+            }
+            return "Thread";
+        }
+
+        double NsPerTick()
+        {
+            GetRegistry(); // Its constructor takes the first calibration
+            return g_msPerTick.load(std::memory_order_relaxed) * 1.0e6;
+        }
+
+        void RecordEvent(ScopeId scope, std::uint32_t depth, std::int64_t startTicks, std::int64_t endTicks)
+        {
+            ThreadEventRing* local = LocalRing();
+            if (!local)
+                return;
+            ThreadEventRing& ring = *local;
+
+            const std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+            if (head - ring.cachedTail >= kRingCapacity) {
+                ring.cachedTail = ring.tail.load(std::memory_order_acquire);
+                if (head - ring.cachedTail >= kRingCapacity) {
+                    ring.dropped.store(ring.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+
+            ring.records[head & (kRingCapacity - 1)] = EventRecord{ scope, depth, startTicks, endTicks };
+            ring.head.store(head + 1, std::memory_order_release);
+        }
+    }
+
+    void SetThreadName(const char* name)
+    {
+        KBK_MEMORY_TAG(Profiler);
+        ThreadEventRing* ring = LocalRing();
+        if (!ring)
+            return;
+
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        std::snprintf(ring->name, sizeof(ring->name), "%s", name ? name : "");
+    }
+
+    bool BeginCapture(std::uint32_t frameCount, const char* path)
     {
+        KBK_MEMORY_TAG(Profiler);
+        if (frameCount == 0 || !path || path[0] == '\0')
+            return false;
+
+        Registry& registry = GetRegistry();
+        {
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            if (registry.capturing)
+                return false;
+
+            // Pending events predate the capture
+            DrainRings(registry);
+
+            registry.capture = Capture{};
+            registry.capture.path = path;
+            registry.capture.framesLeft = frameCount;
+            registry.capture.startTicks = Detail::NowTicks();
+            registry.capturing = true;
+        }
+
+        KbkLog("Profile", "Capturing %u frames to %s", frameCount, path);
+        return true;
     }
 
-    ScopedEvent::~ScopedEvent()
+    bool IsCapturing()
     {
-        const auto end = Clock::now();
-        const double ms = std::chrono::duration<double, std::milli>(end - m_start).count();
-
-        std::lock_guard<std::mutex> guard(ProfilerMutex());
-        auto& sample = Samples()[m_name ? m_name : "<null>"];
-        sample.totalMs += ms;
-        sample.maxMs = std::max(sample.maxMs, ms);
-        sample.minMs = std::min(sample.minMs, ms);
-        sample.hits += 1;
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        return registry.capturing;
+    }
+
+    void GetCallTree(CallTree& out)
+    {
+        KBK_MEMORY_TAG(Profiler);
+        out.nodes.clear();
+
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        DrainRings(registry);
+
+        std::vector<VisitEntry> order;
+        CollectPreorder(registry, order);
+
+        const std::uint32_t count = registry.historyCount;
+        std::vector<std::int64_t> window(count);
+        out.windowFrames = count;
+        out.nodes.reserve(order.size());
+
+        for (const VisitEntry& entry : order) {
+            const TreeNode& node = registry.nodes[entry.node];
+            CallTreeNode& result = out.nodes.emplace_back();
+            result.name = NodeName(registry, node);
+            result.parent = entry.parentEntry;
+            result.depth = entry.depth;
+            result.inclusiveMs = TicksToMs(node.lastInclusive);
+            result.exclusiveMs = TicksToMs(node.lastExclusive);
+            result.hits = node.lastHits;
+
+            if (count == 0)
+                continue;
+
+            // The newest `count` slots, in any order
+            std::int64_t total = 0;
+            for (std::uint32_t i = 0; i < count; ++i) {
+                window[i] = node.history[(registry.historyHead + kHistoryFrames - 1 - i) % kHistoryFrames];
+                total += window[i];
+            }
+            std::sort(window.begin(), window.end());
+
+            // Nearest-rank percentiles
+            auto percentile = [&](double p) {
+                const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(count)));
+                return TicksToMs(window[std::max<std::size_t>(rank, 1) - 1]);
+            };
+            result.avgMs = TicksToMs(total) / static_cast<double>(count);
+            result.p50Ms = percentile(0.50);
+            result.p95Ms = percentile(0.95);
+            result.p99Ms = percentile(0.99);
+            result.maxMs = TicksToMs(window.back());
+        }
+    }
+
+    std::uint64_t DroppedEvents()
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+
+        std::uint64_t dropped = registry.retiredDropped;
+        for (const auto& ring : registry.rings)
+            dropped += ring->dropped.load(std::memory_order_relaxed);
+        return dropped;
     }
 
     void BeginFrame()
     {
+        KBK_MEMORY_TAG(Profiler);
+        Registry& registry = GetRegistry();
         bool flushNow = false;
+        bool captureDone = false;
+        Capture finished;
         {
-            std::lock_guard<std::mutex> guard(ProfilerMutex());
-            auto& frames = FrameCounter();
-            ++frames;
-            flushNow = (frames % kFlushInterval) == 0;
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            DrainRings(registry);
+            CloseFrame(registry);
+            ++registry.frames;
+            if constexpr (kFlushInterval != 0)
+                flushNow = (registry.frames % kFlushInterval) == 0;
+            RefineCalibration(registry);
+
+            if (registry.capturing) {
+                Capture& capture = registry.capture;
+                if (capture.framesLeft == 0) {
+                    finished = EndCapture(registry);
+                    captureDone = true;
+                }
+                else {
+                    --capture.framesLeft;
+                    capture.frames.push_back({ Detail::NowTicks(), registry.frames });
+                }
+            }
         }
 
+        if (captureDone)
+            WriteChromeTrace(finished);
+
         if (flushNow)
-            Flush();
+            LogSummary();
     }
 
     void Flush()
     {
-        std::unordered_map<std::string, SampleData> snapshot;
+        KBK_MEMORY_TAG(Profiler);
+        Registry& registry = GetRegistry();
+        bool captureDone = false;
+        Capture finished;
         {
-            std::lock_guard<std::mutex> guard(ProfilerMutex());
-            auto& samples = Samples();
-            if (samples.empty())
-                return;
-            snapshot.swap(samples);
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            // Writes whatever part of an unfinished capture exists (e.g. at shutdown)
+            if (registry.capturing) {
+                DrainRings(registry);
+                finished = EndCapture(registry);
+                captureDone = true;
+            }
         }
 
-        for (auto& [name, data] : snapshot) {
-            if (data.hits == 0)
-                continue;
-            const double avg = data.totalMs / static_cast<double>(data.hits);
-            KbkTrace("Profile", "%s -> avg %.3f ms (min %.3f / max %.3f) across %u samples",
-                     name.c_str(), avg, data.minMs, data.maxMs, data.hits);
-        }
+        if (captureDone)
+            WriteChromeTrace(finished);
+
+        LogSummary();
     }
 
 } // namespace KibakoEngine::Profiler
 
 #endif
 
+namespace KibakoEngine::Profiler {
+
+    const CallTreeNode* CallTree::Find(std::string_view path) const
+    {
+        std::uint32_t parent = kNoParent;
+        const CallTreeNode* found = nullptr;
+
+        while (!path.empty()) {
+            const std::size_t slash = path.find('/');
+            const std::string_view segment = path.substr(0, slash);
+            path = slash == std::string_view::npos ? std::string_view{} : path.substr(slash + 1);
+
+            found = nullptr;
+            // Children follow their parent in pre-order
+            const std::size_t begin = parent == kNoParent ? 0 : parent + 1;
+            for (std::size_t i = begin; i < nodes.size(); ++i) {
+                const CallTreeNode& node = nodes[i];
+                if (parent != kNoParent && node.depth <= nodes[parent].depth)
+                    break;
+                if (node.parent == parent && node.name == segment) {
+                    found = &node;
+                    parent = static_cast<std::uint32_t>(i);
+                    break;
+                }
+            }
+
+            if (!found)
+                return nullptr;
+        }
+        return found;
+    }
+
+} // namespace KibakoEngine::Profiler
@@ -0,0 +1,354 @@
+// Frame recording and deterministic replay of input, time steps and sprite output
+#include "KibakoEngine/Core/Replay.h"
+
+#include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/Profiler.h"
+#include "KibakoEngine/Renderer/Texture2D.h"
+
+#include <cstring>
+
+namespace KibakoEngine {
+
+    namespace
+    {
+        constexpr const char* kLogChannel = "Replay";
+
+        constexpr char          kMagic[4] = { 'K', 'B', 'K', 'R' };
+        constexpr std::uint32_t kVersion = 2;
+        constexpr std::uint32_t kFlagSprites = 1u << 0;
+
+        // A frame larger than this is treated as damage, not data
+        constexpr std::uint32_t kMaxFrameBytes = 256u * 1024u * 1024u;
+        constexpr std::uint64_t kSpriteRecordBytes = 60;
+
+        constexpr std::uint64_t kFnvOffset = 1469598103934665603ull;
+        constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+        // Captures are raw little-endian; every supported target is
+        template <typename T>
+        void Put(std::vector<std::uint8_t>& buffer, const T& value)
+        {
+            const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+        }
+
+        class Reader {
+        public:
+            Reader(const std::uint8_t* data, std::size_t size)
+                : m_data(data)
+                , m_size(size)
+            {
+            }
+
+            template <typename T>
+            bool Get(T& out)
+            {
+                if (m_offset + sizeof(T) > m_size)
+                    return false;
+                std::memcpy(&out, m_data + m_offset, sizeof(T));
+                m_offset += sizeof(T);
+                return true;
+            }
+
+        private:
+            const std::uint8_t* m_data;
+            std::size_t         m_size;
+            std::size_t         m_offset = 0;
+        };
+
+        std::uint64_t HashBytes(std::uint64_t hash, const void* data, std::size_t size)
+        {
+            const auto* bytes = static_cast<const std::uint8_t*>(data);
+            for (std::size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= kFnvPrime;
+            }
+            return hash;
+        }
+
+        ReplaySprite ToReplaySprite(const SpriteCommand& command)
+        {
+            ReplaySprite sprite{};
+            sprite.textureId = command.texture ? command.texture->SortId() : 0;
+            sprite.dst = command.dst;
+            sprite.src = command.src;
+            sprite.color = command.color;
+            sprite.rotation = command.rotation;
+            sprite.layer = command.layer;
+            return sprite;
+        }
+
+        void PutSprite(std::vector<std::uint8_t>& buffer, const ReplaySprite& sprite)
+        {
+            Put(buffer, sprite.textureId);
+            Put(buffer, sprite.dst);
+            Put(buffer, sprite.src);
+            Put(buffer, sprite.color);
+            Put(buffer, sprite.rotation);
+            Put(buffer, static_cast<std::int32_t>(sprite.layer));
+        }
+
+        bool GetSprite(Reader& reader, ReplaySprite& sprite)
+        {
+            std::int32_t layer = 0;
+            const bool ok = reader.Get(sprite.textureId) && reader.Get(sprite.dst) && reader.Get(sprite.src)
+                && reader.Get(sprite.color) && reader.Get(sprite.rotation) && reader.Get(layer);
+            sprite.layer = layer;
+            return ok;
+        }
+    }
+
+    std::uint64_t HashSpriteCommands(std::span<const SpriteCommand> commands)
+    {
+        KBK_PROFILE_SCOPE("ReplayHashSprites");
+
+        std::uint64_t hash = kFnvOffset;
+        for (const SpriteCommand& command : commands) {
+            const ReplaySprite sprite = ToReplaySprite(command);
+            hash = HashBytes(hash, &sprite.textureId, sizeof(sprite.textureId));
+            hash = HashBytes(hash, &sprite.dst, sizeof(sprite.dst));
+            hash = HashBytes(hash, &sprite.src, sizeof(sprite.src));
+            hash = HashBytes(hash, &sprite.color, sizeof(sprite.color));
+            hash = HashBytes(hash, &sprite.rotation, sizeof(sprite.rotation));
+            hash = HashBytes(hash, &sprite.layer, sizeof(sprite.layer));
+        }
+        return hash;
+    }
+
+    bool ReplayRecorder::Open(const std::string& path, const ReplayHeader& header)
+    {
+        Close();
+
+        m_file = std::fopen(path.c_str(), "wb");
+        if (!m_file) {
+            KbkError(kLogChannel, "Failed to open %s for writing", path.c_str());
+            return false;
+        }
+
+        m_header = header;
+        m_path = path;
+        m_previousInput = InputSnapshot{};
+        m_framePending = false;
+        m_frames = 0;
+
+        const std::uint32_t flags = header.hasSprites ? kFlagSprites : 0u;
+        std::fwrite(kMagic, 1, sizeof(kMagic), m_file);
+        std::fwrite(&kVersion, sizeof(kVersion), 1, m_file);
+        std::fwrite(&header.width, sizeof(header.width), 1, m_file);
+        std::fwrite(&header.height, sizeof(header.height), 1, m_file);
+        std::fwrite(&flags, sizeof(flags), 1, m_file);
+
+        KbkLog(kLogChannel, "Recording to %s (%s)", path.c_str(), header.hasSprites ? "with sprite stream" : "input only");
+        return true;
+    }
+
+    void ReplayRecorder::Close()
+    {
+        if (!m_file)
+            return;
+
+        // A frame whose sprites never arrived is still worth replaying
+        if (m_framePending)
+            EndFrame({});
+
+        const bool ok = std::ferror(m_file) == 0;
+        std::fclose(m_file);
+        m_file = nullptr;
+
+        if (ok)
+            KbkLog(kLogChannel, "Recorded %llu frames to %s", static_cast<unsigned long long>(m_frames), m_path.c_str());
+        else
+            KbkError(kLogChannel, "Failed to write %s", m_path.c_str());
+    }
+
+    void ReplayRecorder::BeginFrame(double deltaSeconds, const InputSnapshot& input)
+    {
+        if (!m_file)
+            return;
+
+        if (m_framePending)
+            EndFrame({});
+
+        m_delta = deltaSeconds;
+        m_input = input;
+        m_framePending = true;
+    }
+
+    void ReplayRecorder::EndFrame(std::span<const SpriteCommand> sprites)
+    {
+        if (!m_file || !m_framePending)
+            return;
+
+        KBK_PROFILE_SCOPE("ReplayRecordFrame");
+
+        m_framePending = false;
+        m_buffer.clear();
+
+        Put(m_buffer, m_delta);
+        Put(m_buffer, static_cast<std::int32_t>(m_input.mouseX));
+        Put(m_buffer, static_cast<std::int32_t>(m_input.mouseY));
+        Put(m_buffer, static_cast<std::int32_t>(m_input.wheelX));
+        Put(m_buffer, static_cast<std::int32_t>(m_input.wheelY));
+        Put(m_buffer, m_input.mouseButtons);
+        Put(m_buffer, m_input.mousePressed);
+        Put(m_buffer, m_input.textChar);
+
+        std::size_t changes = 0;
+        for (std::size_t key = 0; key < m_input.keys.size(); ++key) {
+            if (m_input.keys[key] != m_previousInput.keys[key])
+                ++changes;
+        }
+
+        Put(m_buffer, static_cast<std::uint16_t>(changes));
+        for (std::size_t key = 0; key < m_input.keys.size(); ++key) {
+            if (m_input.keys[key] == m_previousInput.keys[key])
+                continue;
+            Put(m_buffer, static_cast<std::uint16_t>(key));
+            Put(m_buffer, m_input.keys[key]);
+        }
+        m_previousInput = m_input;
+
+        // Presses are events, not state: a key tapped and released inside one frame
+        // shows no change above but still has to replay as pressed
+        std::size_t presses = 0;
+        for (const std::uint8_t pressed : m_input.keysPressed)
+            presses += pressed != 0 ? 1 : 0;
+
+        Put(m_buffer, static_cast<std::uint16_t>(presses));
+        for (std::size_t key = 0; key < m_input.keysPressed.size(); ++key) {
+            if (m_input.keysPressed[key] != 0)
+                Put(m_buffer, static_cast<std::uint16_t>(key));
+        }
+
+        Put(m_buffer, HashSpriteCommands(sprites));
+        Put(m_buffer, static_cast<std::uint32_t>(sprites.size()));
+        if (m_header.hasSprites) {
+            for (const SpriteCommand& command : sprites)
+                PutSprite(m_buffer, ToReplaySprite(command));
+        }
+
+        const auto size = static_cast<std::uint32_t>(m_buffer.size());
+        std::fwrite(&size, sizeof(size), 1, m_file);
+        std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+        ++m_frames;
+    }
+
+    bool ReplayPlayer::Open(const std::string& path)
+    {
+        Close();
+
+        m_file = std::fopen(path.c_str(), "rb");
+        if (!m_file) {
+            KbkError(kLogChannel, "Failed to open replay %s", path.c_str());
+            return false;
+        }
+
+        char magic[4] = {};
+        std::uint32_t version = 0;
+        std::uint32_t flags = 0;
+        const bool read = std::fread(magic, 1, sizeof(magic), m_file) == sizeof(magic)
+            && std::fread(&version, sizeof(version), 1, m_file) == 1
+            && std::fread(&m_header.width, sizeof(m_header.width), 1, m_file) == 1
+            && std::fread(&m_header.height, sizeof(m_header.height), 1, m_file) == 1
+            && std::fread(&flags, sizeof(flags), 1, m_file) == 1;
+
+        if (!read || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion) {
+            KbkError(kLogChannel, "%s is not a version %u replay", path.c_str(), kVersion);
+            Close();
+            return false;
+        }
+
+        m_header.hasSprites = (flags & kFlagSprites) != 0;
+        m_keys.fill(0);
+        m_frames = 0;
+
+        KbkLog(kLogChannel, "Replaying %s (%ux%u, %s)", path.c_str(), m_header.width, m_header.height,
+            m_header.hasSprites ? "with sprite stream" : "input only");
+        return true;
+    }
+
+    void ReplayPlayer::Close()
+    {
+        if (!m_file)
+            return;
+
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+
+    bool ReplayPlayer::ReadFrame(ReplayFrame& out)
+    {
+        if (!m_file)
+            return false;
+
+        KBK_PROFILE_SCOPE("ReplayReadFrame");
+
+        std::uint32_t size = 0;
+        if (std::fread(&size, sizeof(size), 1, m_file) != 1)
+            return false;
+
+        if (size > kMaxFrameBytes) {
+            KbkWarn(kLogChannel, "Frame %llu claims %u bytes; stopping", static_cast<unsigned long long>(m_frames), size);
+            return false;
+        }
+
+        m_buffer.resize(size);
+        if (std::fread(m_buffer.data(), 1, size, m_file) != size) {
+            KbkWarn(kLogChannel, "Frame %llu is truncated; stopping", static_cast<unsigned long long>(m_frames));
+            return false;
+        }
+
+        Reader reader(m_buffer.data(), m_buffer.size());
+        std::int32_t mouseX = 0;
+        std::int32_t mouseY = 0;
+        std::int32_t wheelX = 0;
+        std::int32_t wheelY = 0;
+        std::uint16_t changes = 0;
+        std::uint16_t presses = 0;
+        bool ok = reader.Get(out.deltaSeconds) && reader.Get(mouseX) && reader.Get(mouseY)
+            && reader.Get(wheelX) && reader.Get(wheelY) && reader.Get(out.input.mouseButtons)
+            && reader.Get(out.input.mousePressed) && reader.Get(out.input.textChar) && reader.Get(changes);
+
+        for (std::uint16_t i = 0; ok && i < changes; ++i) {
+            std::uint16_t key = 0;
+            std::uint8_t state = 0;
+            ok = reader.Get(key) && reader.Get(state) && key < m_keys.size();
+            if (ok)
+                m_keys[key] = state;
+        }
+
+        out.input.keysPressed.fill(0);
+        ok = ok && reader.Get(presses);
+        for (std::uint16_t i = 0; ok && i < presses; ++i) {
+            std::uint16_t key = 0;
+            ok = reader.Get(key) && key < out.input.keysPressed.size();
+            if (ok)
+                out.input.keysPressed[key] = 1;
+        }
+
+        ok = ok && reader.Get(out.spriteHash) && reader.Get(out.spriteCount);
+
+        out.sprites.clear();
+        if (ok && m_header.hasSprites) {
+            ok = static_cast<std::uint64_t>(out.spriteCount) * kSpriteRecordBytes <= size;
+            if (ok)
+                out.sprites.resize(out.spriteCount);
+            for (std::size_t i = 0; ok && i < out.sprites.size(); ++i)
+                ok = GetSprite(reader, out.sprites[i]);
+        }
+
+        if (!ok) {
+            KbkWarn(kLogChannel, "Frame %llu is malformed; stopping", static_cast<unsigned long long>(m_frames));
+            return false;
+        }
+
+        out.input.keys = m_keys;
+        out.input.mouseX = mouseX;
+        out.input.mouseY = mouseY;
+        out.input.wheelX = wheelX;
+        out.input.wheelY = wheelY;
+        ++m_frames;
+        return true;
+    }
+
+} // namespace KibakoEngine
@@ -0,0 +1,395 @@
+// Statistical CPU sampling for code without profile scopes
+#include "KibakoEngine/Core/SamplingProfiler.h"
+
+#include "KibakoEngine/Core/Debug.h"
+#include "KibakoEngine/Core/Log.h"
+
+#if KBK_ENABLE_SAMPLING_PROFILER
+
+#include "KibakoEngine/Core/MemoryTracker.h"
+#include "KibakoEngine/Core/Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <ucontext.h>
+
+namespace KibakoEngine::SamplingProfiler {
+
+    namespace
+    {
+        constexpr const char* kLogChannel = "Sampler";
+
+        // About half a minute of CPU time at the default rate, ~13 MB
+        constexpr std::uint64_t kMaxSamples = 1u << 15;
+        constexpr std::uint32_t kMaxHz = 10000;
+        // Native frames kept per sample, innermost first
+        constexpr std::uint16_t kMaxFrames = 32;
+        constexpr std::uint32_t kMaxScopes = 32;
+
+        using ScopeId = std::uint32_t;
+
+        struct Sample
+        {
+            std::atomic<bool> ready{ false };
+            std::uint32_t     thread = 0;
+            std::uint16_t     scopeCount = 0;
+            std::uint16_t     frameCount = 0;
+            ScopeId           scopes[kMaxScopes] = {};
+            std::uintptr_t    frames[kMaxFrames] = {};
+        };
+
+        // Registers of the interrupted frame. x86-64 only: elsewhere the frame record
+        // does not sit above a frame's locals, which the scope bound below relies on.
+        struct InterruptedFrame
+        {
+            std::uintptr_t pc = 0;
+            std::uintptr_t sp = 0;
+            std::uintptr_t fp = 0;
+        };
+
+        bool ReadInterruptedFrame(const void* context, InterruptedFrame& out)
+        {
+            const auto* uc = static_cast<const ucontext_t*>(context);
+#if defined(__x86_64__)
+            out.pc = static_cast<std::uintptr_t>(uc->uc_mcontext.gregs[REG_RIP]);
+            out.sp = static_cast<std::uintptr_t>(uc->uc_mcontext.gregs[REG_RSP]);
+            out.fp = static_cast<std::uintptr_t>(uc->uc_mcontext.gregs[REG_RBP]);
+            return true;
+#else
+            KBK_UNUSED(uc);
+            KBK_UNUSED(out);
+            return false;
+#endif
+        }
+
+        // Follows the frame-pointer chain from the interrupted frame, reading only the stack
+        // between the interrupted sp and the innermost open ScopedEvent: that range is live,
+        // so a register that does not hold a frame pointer ends the walk instead of faulting.
+        // The walk stops at the frame that opened the scope, since the scope stack names
+        // everything above it. With no scope open only the interrupted pc is kept.
+        void CollectFrames(Sample& sample, const void* context, std::uintptr_t scopeAddress)
+        {
+            InterruptedFrame frame;
+            if (!context || !ReadInterruptedFrame(context, frame) || frame.pc == 0)
+                return;
+
+            // Only the interrupted frame holds an exact pc
+            sample.frames[sample.frameCount++] = frame.pc;
+
+            std::uintptr_t fp = frame.fp;
+            std::uintptr_t low = frame.sp;
+            while (scopeAddress != 0 && sample.frameCount < kMaxFrames) {
+                if (fp < low || fp + 2 * sizeof(std::uintptr_t) > scopeAddress || (fp % sizeof(std::uintptr_t)) != 0)
+                    break;
+
+                const auto* record = reinterpret_cast<const std::uintptr_t*>(fp);
+                const std::uintptr_t next = record[0];
+                const std::uintptr_t returnAddress = record[1];
+                if (returnAddress == 0)
+                    break;
+
+                // A return address points past its call; step back into it
+                sample.frames[sample.frameCount++] = returnAddress - 1;
+
+                // The caller's frame holds the scope: it opened it
+                if (next <= fp || next > scopeAddress)
+                    break;
+                low = fp + 2 * sizeof(std::uintptr_t);
+                fp = next;
+            }
+        }
+
+        std::unique_ptr<Sample[]> g_buffer;
+        std::atomic<Sample*>       g_samples{ nullptr };
+        std::atomic<std::uint64_t> g_next{ 0 };
+        std::atomic<bool>          g_running{ false };
+        bool                       g_handlerInstalled = false;
+
+        // Runs on whichever thread was burning CPU; only touches preallocated memory and
+        // the interrupted stack, so it is safe whatever the thread was doing
+        void OnProfSignal(int, siginfo_t*, void* context)
+        {
+            if (!g_running.load(std::memory_order_relaxed))
+                return;
+
+            const int savedErrno = errno;
+            const std::uint64_t index = g_next.fetch_add(1, std::memory_order_relaxed);
+            Sample* samples = g_samples.load(std::memory_order_acquire);
+            if (index >= kMaxSamples || !samples) {
+                errno = savedErrno;
+                return;
+            }
+
+            Sample& sample = samples[index];
+            std::uintptr_t scopeAddress = 0;
+#if KBK_ENABLE_PROFILING
+            static_assert(kMaxScopes >= Profiler::Detail::kMaxScopeStack, "Samples must hold every tracked scope");
+            const std::uint32_t depth = Profiler::Detail::t_scopeDepth;
+            std::atomic_signal_fence(std::memory_order_acquire);
+            const std::uint32_t scopeCount = std::min(depth, Profiler::Detail::kMaxScopeStack);
+            for (std::uint32_t i = 0; i < scopeCount; ++i)
+                sample.scopes[i] = Profiler::Detail::t_scopeStack[i];
+            sample.thread = Profiler::Detail::t_threadIndex;
+            sample.scopeCount = static_cast<std::uint16_t>(scopeCount);
+            if (scopeCount > 0)
+                scopeAddress = reinterpret_cast<std::uintptr_t>(Profiler::Detail::t_scopeAddresses[scopeCount - 1]);
+#else
+            sample.thread = 0;
+            sample.scopeCount = 0;
+#endif
+
+            sample.frameCount = 0;
+            CollectFrames(sample, context, scopeAddress);
+
+            sample.ready.store(true, std::memory_order_release);
+            errno = savedErrno;
+        }
+
+        // Folded stacks use ';' between frames and a space before the count
+        std::string Sanitize(std::string name)
+        {
+            std::replace(name.begin(), name.end(), ';', ':');
+            std::replace(name.begin(), name.end(), '\n', ' ');
+            return name.empty() ? std::string("?") : name;
+        }
+
+        std::string FrameName(std::uintptr_t pc)
+        {
+            Dl_info info{};
+            char text[256];
+            if (dladdr(reinterpret_cast<void*>(pc), &info) == 0) {
+                std::snprintf(text, sizeof(text), "0x%llx", static_cast<unsigned long long>(pc));
+                return text;
+            }
+
+            if (info.dli_sname) {
+                int status = 0;
+                char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                std::string name = (status == 0 && demangled) ? demangled : info.dli_sname;
+                std::free(demangled);
+                return Sanitize(std::move(name));
+            }
+
+            const char* module = info.dli_fname ? info.dli_fname : "?";
+            if (const char* slash = std::strrchr(module, '/'))
+                module = slash + 1;
+            const auto base = reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+            std::snprintf(text, sizeof(text), "%s+0x%llx", module, static_cast<unsigned long long>(pc - base));
+            return Sanitize(text);
+        }
+
+        std::string ThreadLabel(std::uint32_t thread)
+        {
+#if KBK_ENABLE_PROFILING
+            return Sanitize(Profiler::Detail::ThreadName(thread));
+#else
+            KBK_UNUSED(thread);
+            return "Process";
+#endif
+        }
+
+        std::string ScopeLabel(ScopeId scope)
+        {
+#if KBK_ENABLE_PROFILING
+            return Sanitize(Profiler::Detail::ScopeName(scope));
+#else
+            KBK_UNUSED(scope);
+            return "?";
+#endif
+        }
+    } // namespace
+
+    bool Start(std::uint32_t hz)
+    {
+        if (hz == 0 || hz > kMaxHz) {
+            KbkError(kLogChannel, "Sampling rate %u Hz is outside 1..%u", hz, kMaxHz);
+            return false;
+        }
+
+        Stop();
+
+        KBK_MEMORY_TAG(Profiler);
+        if (!g_buffer) {
+            g_buffer = std::make_unique<Sample[]>(kMaxSamples);
+        }
+        else {
+            for (std::uint64_t i = 0; i < kMaxSamples; ++i)
+                g_buffer[i].ready.store(false, std::memory_order_relaxed);
+        }
+        g_next.store(0, std::memory_order_relaxed);
+        g_samples.store(g_buffer.get(), std::memory_order_release);
+
+        if (!g_handlerInstalled) {
+            struct sigaction action{};
+            action.sa_sigaction = OnProfSignal;
+            action.sa_flags = SA_SIGINFO | SA_RESTART;
+            sigemptyset(&action.sa_mask);
+            if (sigaction(SIGPROF, &action, nullptr) != 0) {
+                KbkError(kLogChannel, "Failed to install the SIGPROF handler: %s", std::strerror(errno));
+                return false;
+            }
+            g_handlerInstalled = true;
+        }
+
+        g_running.store(true, std::memory_order_release);
+
+        itimerval timer{};
+        timer.it_interval.tv_sec = 0;
+        timer.it_interval.tv_usec = static_cast<suseconds_t>(1000000u / hz);
+        timer.it_value = timer.it_interval;
+        if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+            g_running.store(false, std::memory_order_release);
+            KbkError(kLogChannel, "Failed to arm the profiling timer: %s", std::strerror(errno));
+            return false;
+        }
+
+        KbkLog(kLogChannel, "Sampling every %u us of CPU time", static_cast<unsigned>(timer.it_interval.tv_usec));
+        return true;
+    }
+
+    void Stop()
+    {
+        if (!g_running.load(std::memory_order_acquire))
+            return;
+
+        itimerval timer{};
+        setitimer(ITIMER_PROF, &timer, nullptr);
+
+        // The handler stays installed: a SIGPROF already pending would otherwise
+        // take the default action and terminate the process
+        g_running.store(false, std::memory_order_release);
+    }
+
+    bool IsRunning()
+    {
+        return g_running.load(std::memory_order_acquire);
+    }
+
+    std::uint64_t SampleCount()
+    {
+        return std::min(g_next.load(std::memory_order_relaxed), kMaxSamples);
+    }
+
+    std::uint64_t DroppedSamples()
+    {
+        const std::uint64_t next = g_next.load(std::memory_order_relaxed);
+        return next > kMaxSamples ? next - kMaxSamples : 0;
+    }
+
+    bool WriteFoldedStacks(const char* path)
+    {
+        Stop();
+
+        if (!path || path[0] == '\0')
+            return false;
+
+        KBK_MEMORY_TAG(Profiler);
+
+        std::map<std::string, std::uint64_t> stacks;
+        std::unordered_map<std::uint32_t, std::string> threadLabels;
+        std::unordered_map<ScopeId, std::string> scopeLabels;
+        std::unordered_map<std::uintptr_t, std::string> frameLabels;
+
+        const Sample* samples = g_buffer.get();
+        const std::uint64_t count = SampleCount();
+        std::uint64_t written = 0;
+        std::string stack;
+
+        for (std::uint64_t i = 0; samples && i < count; ++i) {
+            const Sample& sample = samples[i];
+            if (!sample.ready.load(std::memory_order_acquire))
+                continue;
+
+            auto thread = threadLabels.find(sample.thread);
+            if (thread == threadLabels.end())
+                thread = threadLabels.emplace(sample.thread, ThreadLabel(sample.thread)).first;
+            stack = thread->second;
+
+            for (std::uint16_t s = 0; s < sample.scopeCount; ++s) {
+                auto scope = scopeLabels.find(sample.scopes[s]);
+                if (scope == scopeLabels.end())
+                    scope = scopeLabels.emplace(sample.scopes[s], ScopeLabel(sample.scopes[s])).first;
+                stack += ';';
+                stack += scope->second;
+            }
+
+            // Captured innermost first; folded stacks run root to leaf
+            for (int f = sample.frameCount - 1; f >= 0; --f) {
+                auto frame = frameLabels.find(sample.frames[f]);
+                if (frame == frameLabels.end())
+                    frame = frameLabels.emplace(sample.frames[f], FrameName(sample.frames[f])).first;
+                stack += ';';
+                stack += frame->second;
+            }
+
+            ++stacks[stack];
+            ++written;
+        }
+
+        std::FILE* file = std::fopen(path, "wb");
+        if (!file) {
+            KbkError(kLogChannel, "Failed to open %s for writing", path);
+            return false;
+        }
+
+        for (const auto& [folded, hits] : stacks)
+            std::fprintf(file, "%s %llu\n", folded.c_str(), static_cast<unsigned long long>(hits));
+
+        const bool ok = std::ferror(file) == 0;
+        std::fclose(file);
+        if (!ok) {
+            KbkError(kLogChannel, "Failed to write %s", path);
+            return false;
+        }
+
+        KbkLog(kLogChannel, "Wrote %llu samples in %zu stacks to %s (%llu dropped)",
+            static_cast<unsigned long long>(written), stacks.size(), path,
+            static_cast<unsigned long long>(DroppedSamples()));
+        return true;
+    }
+
+} // namespace KibakoEngine::SamplingProfiler
+
+#else
+
+namespace KibakoEngine::SamplingProfiler {
+
+    namespace
+    {
+        constexpr const char* kLogChannel = "Sampler";
+    }
+
+    bool Start(std::uint32_t hz)
+    {
+        KBK_UNUSED(hz);
+        KbkWarn(kLogChannel, "Sampling profiler is only available on Linux");
+        return false;
+    }
+
+    void Stop() {}
+    bool IsRunning() { return false; }
+    std::uint64_t SampleCount() { return 0; }
+    std::uint64_t DroppedSamples() { return 0; }
+
+    bool WriteFoldedStacks(const char* path)
+    {
+        KBK_UNUSED(path);
+        return false;
+    }
+
+} // namespace KibakoEngine::SamplingProfiler
+
+#endif
@@ -23,5 +23,14 @@ namespace KibakoEngine {
         m_total += m_delta;
     }
 
+    void Time::TickFixed(double deltaSeconds)
+    {
+        m_delta = deltaSeconds;
+        m_total += deltaSeconds;
+        // A later Tick() measures from here rather than from before the fixed steps
+        m_prevTicks = SDL_GetPerformanceCounter();
+        m_started = true;
+    }
+
 } // namespace KibakoEngine
 
@@ -2,6 +2,7 @@
 #include "KibakoEngine/Fonts/Font.h"
 
 #include "KibakoEngine/Core/Debug.h"
+#include "KibakoEngine/Core/MemoryTracker.h"
 
 #include <algorithm>
 
@@ -12,7 +13,6 @@ namespace KibakoEngine {
         int height,
         const std::vector<std::uint8_t>& rgbaPixels)
     {
-        KBK_ASSERT(device != nullptr, "FontAtlas::Create requires a valid device");
         KBK_ASSERT(width > 0 && height > 0, "FontAtlas::Create requires positive size");
         KBK_ASSERT(!rgbaPixels.empty(), "FontAtlas::Create requires pixel data");
         KBK_ASSERT(static_cast<size_t>(width * height * 4) == rgbaPixels.size(),
@@ -52,6 +52,7 @@ namespace KibakoEngine {
 
     void Font::AddGlyph(char32_t codepoint, const Glyph& glyph)
     {
+        KBK_MEMORY_TAG(Font);
         m_glyphs[codepoint] = glyph;
     }
 
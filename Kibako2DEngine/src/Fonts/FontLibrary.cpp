@@ -3,6 +3,7 @@
 
 #include "KibakoEngine/Core/Debug.h"
 #include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/MemoryTracker.h"
 #include "KibakoEngine/Core/Profiler.h"
 
 #include <algorithm>
@@ -114,8 +115,8 @@ namespace KibakoEngine {
         int pixelHeight) const
     {
         KBK_PROFILE_SCOPE("FontLoadTTF");
+        KBK_MEMORY_TAG(Font);
 
-        KBK_ASSERT(device != nullptr, "FontLibrary::LoadFontFromFile requires device");
         KBK_ASSERT(pixelHeight > 0, "FontLibrary::LoadFontFromFile requires positive size");
 
         if (!IsValid()) {
@@ -146,7 +147,7 @@ namespace KibakoEngine {
         for (char32_t code = kGlyphStart; code <= kGlyphEnd; ++code) {
             err = FT_Load_Char(face, static_cast<FT_ULong>(code), kLoadFlags);
             if (err != 0) {
-                KbkWarn(kLogChannel, "FT_Load_Char failed for code %u", static_cast<unsigned>(code));
+                KbkWarnLimited(kLogChannel, 8, "FT_Load_Char failed for code %u", static_cast<unsigned>(code));
                 continue;
             }
 
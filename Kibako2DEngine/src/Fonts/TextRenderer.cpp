@@ -2,6 +2,7 @@
 #include "KibakoEngine/Fonts/Font.h"
 
 #include "KibakoEngine/Core/Debug.h"
+#include "KibakoEngine/Core/PerfCounters.h"
 #include "KibakoEngine/Core/Profiler.h"
 #include "KibakoEngine/Renderer/SpriteBatch2D.h"
 
@@ -92,6 +93,7 @@ namespace KibakoEngine {
         const float startX = settings.snapToPixel ? SnapToPixel(position.x) : position.x;
         float penX = startX;
         float penY = settings.snapToPixel ? SnapToPixel(position.y + ascent) : (position.y + ascent);
+        std::uint32_t glyphsDrawn = 0;
 
         for (char ch : text) {
             if (ch == '\n') {
@@ -125,10 +127,13 @@ namespace KibakoEngine {
 
                 const RectF dst = RectF::FromXYWH(gx, gy, gw, gh);
                 batch.Push(atlas, dst, glyph->uv, settings.color, 0.0f, settings.layer);
+                ++glyphsDrawn;
             }
 
             penX += glyph->advance * settings.scale;
         }
+
+        KBK_PERF_COUNT("text.glyphsDrawn", glyphsDrawn);
     }
 
 } // namespace KibakoEngine
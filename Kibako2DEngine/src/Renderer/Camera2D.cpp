@@ -1,6 +1,9 @@
 // Orthographic camera logic
 #include "KibakoEngine/Renderer/Camera2D.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace DirectX;
 
 namespace KibakoEngine {
@@ -36,6 +39,39 @@ namespace KibakoEngine {
         }
     }
 
+    XMFLOAT2 Camera2D::ScreenToWorld(float x, float y) const
+    {
+        // Inverse of the view transform: rotate(-r) then translate(-p)
+        const float vx = x + m_positionX;
+        const float vy = y + m_positionY;
+        const float cs = std::cos(m_rotation);
+        const float sn = std::sin(m_rotation);
+        return { vx * cs - vy * sn, vx * sn + vy * cs };
+    }
+
+    RectF Camera2D::GetViewBounds() const
+    {
+        const XMFLOAT2 corners[4] = {
+            ScreenToWorld(0.0f, 0.0f),
+            ScreenToWorld(m_viewWidth, 0.0f),
+            ScreenToWorld(m_viewWidth, m_viewHeight),
+            ScreenToWorld(0.0f, m_viewHeight),
+        };
+
+        float minX = corners[0].x;
+        float minY = corners[0].y;
+        float maxX = corners[0].x;
+        float maxY = corners[0].y;
+        for (const XMFLOAT2& c : corners) {
+            minX = std::min(minX, c.x);
+            minY = std::min(minY, c.y);
+            maxX = std::max(maxX, c.x);
+            maxY = std::max(maxY, c.y);
+        }
+
+        return RectF::FromXYWH(minX, minY, maxX - minX, maxY - minY);
+    }
+
     void Camera2D::UpdateMatrix()
     {
         if (!m_dirty)
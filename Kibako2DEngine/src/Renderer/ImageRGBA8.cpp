@@ -0,0 +1,118 @@
+// Golden-image helpers
+#include "KibakoEngine/Renderer/ImageRGBA8.h"
+
+#include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/Profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "stb_image.h"
+
+namespace KibakoEngine {
+
+    namespace
+    {
+        constexpr const char* kLogChannel = "Image";
+    }
+
+    namespace ImageIO
+    {
+        ImageDiff Compare(const ImageRGBA8& a, const ImageRGBA8& b, std::uint32_t tolerance)
+        {
+            KBK_PROFILE_SCOPE("ImageCompare");
+
+            ImageDiff diff{};
+            if (a.width != b.width || a.height != b.height || a.pixels.size() != b.pixels.size()) {
+                diff.sizeMismatch = true;
+                return diff;
+            }
+
+            const std::size_t pixelCount = a.pixels.size() / 4u;
+            for (std::size_t i = 0; i < pixelCount; ++i) {
+                const std::uint8_t* pa = a.pixels.data() + i * 4u;
+                const std::uint8_t* pb = b.pixels.data() + i * 4u;
+
+                std::uint32_t pixelDelta = 0;
+                for (int c = 0; c < 4; ++c) {
+                    const auto delta = static_cast<std::uint32_t>(std::abs(int(pa[c]) - int(pb[c])));
+                    pixelDelta = std::max(pixelDelta, delta);
+                }
+
+                diff.maxChannelDelta = std::max(diff.maxChannelDelta, pixelDelta);
+                if (pixelDelta > tolerance)
+                    ++diff.mismatchedPixels;
+            }
+            return diff;
+        }
+
+        bool SaveTGA(const std::string& path, const ImageRGBA8& image)
+        {
+            KBK_PROFILE_SCOPE("ImageSaveTGA");
+
+            if (image.Empty() || image.width > 0xFFFFu || image.height > 0xFFFFu) {
+                KbkError(kLogChannel, "Cannot save %ux%u image as TGA", image.width, image.height);
+                return false;
+            }
+
+            std::FILE* file = std::fopen(path.c_str(), "wb");
+            if (!file) {
+                KbkError(kLogChannel, "Failed to open %s for writing", path.c_str());
+                return false;
+            }
+
+            std::uint8_t header[18] = {};
+            header[2] = 2; // Uncompressed true-color
+            header[12] = static_cast<std::uint8_t>(image.width & 0xFFu);
+            header[13] = static_cast<std::uint8_t>(image.width >> 8);
+            header[14] = static_cast<std::uint8_t>(image.height & 0xFFu);
+            header[15] = static_cast<std::uint8_t>(image.height >> 8);
+            header[16] = 32;
+            header[17] = 0x28; // 8 alpha bits, top-left origin
+
+            // TGA stores BGRA
+            std::vector<std::uint8_t> bgra(image.pixels.size());
+            for (std::size_t i = 0; i < image.pixels.size(); i += 4) {
+                bgra[i + 0] = image.pixels[i + 2];
+                bgra[i + 1] = image.pixels[i + 1];
+                bgra[i + 2] = image.pixels[i + 0];
+                bgra[i + 3] = image.pixels[i + 3];
+            }
+
+            const bool ok = std::fwrite(header, sizeof(header), 1, file) == 1 &&
+                            std::fwrite(bgra.data(), bgra.size(), 1, file) == 1;
+            std::fclose(file);
+
+            if (!ok) {
+                KbkError(kLogChannel, "Failed to write %s", path.c_str());
+                return false;
+            }
+
+            KbkLog(kLogChannel, "Saved %s (%ux%u)", path.c_str(), image.width, image.height);
+            return true;
+        }
+
+        bool Load(const std::string& path, ImageRGBA8& out)
+        {
+            KBK_PROFILE_SCOPE("ImageLoad");
+
+            int width = 0;
+            int height = 0;
+            int comp = 0;
+            stbi_set_flip_vertically_on_load(false);
+            stbi_uc* pixels = stbi_load(path.c_str(), &width, &height, &comp, 4);
+            if (!pixels) {
+                KbkError(kLogChannel, "Failed to load %s", path.c_str());
+                return false;
+            }
+
+            out.Resize(static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height));
+            std::memcpy(out.pixels.data(), pixels, out.pixels.size());
+            stbi_image_free(pixels);
+            return true;
+        }
+    }
+
+} // namespace KibakoEngine
@@ -0,0 +1,54 @@
+// Renderer interface shared logic
+#include "KibakoEngine/Renderer/RenderBackend.h"
+
+#include "KibakoEngine/Core/Debug.h"
+#include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/Profiler.h"
+
+namespace KibakoEngine {
+
+    namespace
+    {
+        constexpr const char* kLogChannel = "Renderer";
+    }
+
+    void RenderBackend::OnResize(std::uint32_t width, std::uint32_t height)
+    {
+        KBK_PROFILE_SCOPE("RendererResize");
+
+        if (!ResizeTargets(width, height))
+            return;
+
+        m_camera.SetViewport(static_cast<float>(width), static_cast<float>(height));
+    }
+
+    bool RenderBackend::CaptureImage(ImageRGBA8& out) const
+    {
+        KBK_UNUSED(out);
+        return false;
+    }
+
+    bool RenderBackend::InitCommon(std::uint32_t width, std::uint32_t height)
+    {
+        m_width = width;
+        m_height = height;
+
+        if (!m_batch.Init(*this)) {
+            KbkError(kLogChannel, "SpriteBatch2D initialization failed");
+            return false;
+        }
+
+        m_camera.SetViewport(static_cast<float>(width), static_cast<float>(height));
+        m_camera.SetPosition(0.0f, 0.0f);
+        m_camera.SetRotation(0.0f);
+        return true;
+    }
+
+    void RenderBackend::ShutdownCommon()
+    {
+        m_batch.Shutdown();
+        m_width = 0;
+        m_height = 0;
+    }
+
+} // namespace KibakoEngine
@@ -0,0 +1,26 @@
+// Recorded frame of render commands
+#include "KibakoEngine/Renderer/RenderCommandList.h"
+
+namespace KibakoEngine {
+
+    void RenderCommandList::Reset()
+    {
+        m_frameIndex = 0;
+        m_sprites.clear();
+    }
+
+    void RenderCommandList::SetViewport(std::uint32_t width, std::uint32_t height)
+    {
+        m_viewportWidth = width;
+        m_viewportHeight = height;
+    }
+
+    void RenderCommandList::SetClearColor(const float clearColor[4])
+    {
+        m_clearColor[0] = clearColor ? clearColor[0] : 0.0f;
+        m_clearColor[1] = clearColor ? clearColor[1] : 0.0f;
+        m_clearColor[2] = clearColor ? clearColor[2] : 0.0f;
+        m_clearColor[3] = clearColor ? clearColor[3] : 1.0f;
+    }
+
+} // namespace KibakoEngine
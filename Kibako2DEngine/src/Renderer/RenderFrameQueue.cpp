@@ -0,0 +1,128 @@
+// Triple-buffered command list hand-off
+#include "KibakoEngine/Renderer/RenderFrameQueue.h"
+
+#include "KibakoEngine/Core/Debug.h"
+#include "KibakoEngine/Core/Profiler.h"
+
+namespace KibakoEngine {
+
+    RenderCommandList* RenderFrameQueue::BeginRecord()
+    {
+        KBK_PROFILE_SCOPE("RenderQueueWaitFree");
+
+        std::unique_lock lock(m_mutex);
+        KBK_ASSERT(m_recording < 0, "RenderFrameQueue::BeginRecord without Submit");
+
+        int slot = -1;
+        m_freeCv.wait(lock, [&]() {
+            if (m_closed)
+                return true;
+            for (std::size_t i = 0; i < kBufferCount; ++i) {
+                if (m_states[i] == SlotState::Free) {
+                    slot = static_cast<int>(i);
+                    return true;
+                }
+            }
+            return false;
+        });
+
+        if (m_closed || slot < 0)
+            return nullptr;
+
+        m_states[static_cast<std::size_t>(slot)] = SlotState::Recording;
+        m_recording = slot;
+
+        RenderCommandList& list = m_lists[static_cast<std::size_t>(slot)];
+        list.Reset();
+        return &list;
+    }
+
+    void RenderFrameQueue::Submit()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            KBK_ASSERT(m_recording >= 0, "RenderFrameQueue::Submit without BeginRecord");
+            if (m_recording < 0)
+                return;
+
+            const auto slot = static_cast<std::size_t>(m_recording);
+            m_states[slot] = SlotState::Ready;
+            m_order[slot] = m_submitted++;
+            m_recording = -1;
+        }
+        m_readyCv.notify_one();
+    }
+
+    const RenderCommandList* RenderFrameQueue::AcquireForRender()
+    {
+        KBK_PROFILE_SCOPE("RenderQueueWaitReady");
+
+        std::unique_lock lock(m_mutex);
+        KBK_ASSERT(m_rendering < 0, "RenderFrameQueue::AcquireForRender without ReleaseRendered");
+
+        // Oldest ready list first so frames reach the screen in order
+        int slot = -1;
+        m_readyCv.wait(lock, [&]() {
+            for (std::size_t i = 0; i < kBufferCount; ++i) {
+                if (m_states[i] != SlotState::Ready)
+                    continue;
+                if (slot < 0 || m_order[i] < m_order[static_cast<std::size_t>(slot)])
+                    slot = static_cast<int>(i);
+            }
+            return slot >= 0 || m_closed;
+        });
+
+        if (slot < 0)
+            return nullptr;
+
+        m_states[static_cast<std::size_t>(slot)] = SlotState::Rendering;
+        m_rendering = slot;
+        return &m_lists[static_cast<std::size_t>(slot)];
+    }
+
+    void RenderFrameQueue::ReleaseRendered()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            KBK_ASSERT(m_rendering >= 0, "RenderFrameQueue::ReleaseRendered without AcquireForRender");
+            if (m_rendering < 0)
+                return;
+
+            m_states[static_cast<std::size_t>(m_rendering)] = SlotState::Free;
+            m_rendering = -1;
+        }
+        m_freeCv.notify_one();
+    }
+
+    void RenderFrameQueue::Close()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_closed = true;
+        }
+        m_freeCv.notify_all();
+        m_readyCv.notify_all();
+    }
+
+    void RenderFrameQueue::Reopen()
+    {
+        std::lock_guard lock(m_mutex);
+        m_states.fill(SlotState::Free);
+        m_recording = -1;
+        m_rendering = -1;
+        m_closed = false;
+    }
+
+    bool RenderFrameQueue::IsClosed() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_closed;
+    }
+
+    std::uint64_t RenderFrameQueue::SubmittedCount() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_submitted;
+    }
+
+} // namespace KibakoEngine
@@ -0,0 +1,67 @@
+// Render thread loop
+#include "KibakoEngine/Renderer/RenderThread.h"
+
+#include "KibakoEngine/Core/Debug.h"
+#include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/Profiler.h"
+
+#include <utility>
+
+namespace KibakoEngine {
+
+    namespace
+    {
+        constexpr const char* kLogChannel = "RenderThread";
+    }
+
+    RenderThread::~RenderThread()
+    {
+        Stop();
+    }
+
+    bool RenderThread::Start(ExecuteFn execute)
+    {
+        if (IsRunning())
+            return true;
+
+        if (!execute) {
+            KbkError(kLogChannel, "RenderThread::Start requires an execute callback");
+            return false;
+        }
+
+        m_execute = std::move(execute);
+        m_framesRendered.store(0, std::memory_order_relaxed);
+        m_queue.Reopen();
+        m_thread = std::thread(&RenderThread::ThreadMain, this);
+
+        KbkLog(kLogChannel, "Render thread started (%zu command buffers)", RenderFrameQueue::kBufferCount);
+        return true;
+    }
+
+    void RenderThread::Stop()
+    {
+        if (!IsRunning())
+            return;
+
+        m_queue.Close();
+        m_thread.join();
+        m_execute = nullptr;
+
+        KbkLog(kLogChannel, "Render thread stopped after %llu frames",
+               static_cast<unsigned long long>(FramesRendered()));
+    }
+
+    void RenderThread::ThreadMain()
+    {
+        Profiler::SetThreadName("Render");
+        while (const RenderCommandList* list = m_queue.AcquireForRender()) {
+            {
+                KBK_PROFILE_SCOPE("RenderThreadFrame");
+                m_execute(*list);
+            }
+            m_queue.ReleaseRendered();
+            m_framesRendered.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+} // namespace KibakoEngine
@@ -1,4 +1,6 @@
 // Direct3D 11 renderer setup
+#if defined(_WIN32)
+
 #ifndef WIN32_LEAN_AND_MEAN
 #    define WIN32_LEAN_AND_MEAN
 #endif
@@ -14,20 +16,27 @@
 #include "KibakoEngine/Core/Profiler.h"
 
 #include <windows.h>
+#include <d3dcompiler.h>
 #include <dxgi.h>
 
+#include <cstring>
 #include <iterator>
+#include <vector>
 
 #ifdef _MSC_VER
 #    pragma comment(lib, "d3d11.lib")
 #    pragma comment(lib, "dxgi.lib")
+#    pragma comment(lib, "d3dcompiler.lib")
 #endif
 
+using namespace DirectX;
+
 namespace KibakoEngine {
 
     namespace
     {
         constexpr const char* kLogChannel = "Renderer";
+        constexpr const char* kBatchLogChannel = "SpriteBatch";
     }
 
     bool RendererD3D11::Init(HWND hwnd, std::uint32_t width, std::uint32_t height)
@@ -45,29 +54,45 @@ namespace KibakoEngine {
             KbkError(kLogChannel, "Failed to create render targets");
             return false;
         }
-        if (!m_batch.Init(m_device.Get(), m_context.Get())) {
-            KbkError(kLogChannel, "SpriteBatch2D initialization failed");
+        if (!CreateSpriteShaders(m_device.Get())) {
+            KbkError(kBatchLogChannel, "Failed to create shaders");
+            return false;
+        }
+        if (!CreateSpriteStates(m_device.Get())) {
+            KbkError(kBatchLogChannel, "Failed to create states");
             return false;
         }
+        if (!EnsureVertexCapacity(256) || !EnsureIndexCapacity(256))
+            return false;
 
-        m_camera.SetPosition(0.0f, 0.0f);
-        m_camera.SetRotation(0.0f);
-        return true;
+        return InitCommon(width, height);
     }
 
     void RendererD3D11::Shutdown()
     {
         KBK_PROFILE_SCOPE("RendererShutdown");
 
-        m_batch.Shutdown();
+        ShutdownCommon();
+
+        m_spriteVB.Reset();
+        m_spriteIB.Reset();
+        m_cbVS.Reset();
+        m_vs.Reset();
+        m_ps.Reset();
+        m_inputLayout.Reset();
+        m_samplerPoint.Reset();
+        m_blendAlpha.Reset();
+        m_depthDisabled.Reset();
+        m_rasterCullNone.Reset();
+        m_spriteVBCapacity = 0;
+        m_spriteIBCapacity = 0;
+
         if (m_context)
             m_context->ClearState();
         m_rtv.Reset();
         m_swapChain.Reset();
         m_context.Reset();
         m_device.Reset();
-        m_width = 0;
-        m_height = 0;
     }
 
     void RendererD3D11::BeginFrame(const float clearColor[4])
@@ -105,18 +130,18 @@ namespace KibakoEngine {
 
         const HRESULT hr = m_swapChain->Present(waitForVSync ? 1 : 0, 0);
         if (FAILED(hr)) {
-            KbkError(kLogChannel, "Swap chain Present failed: 0x%08X", static_cast<unsigned>(hr));
+            KbkErrorLimited(kLogChannel, 1, "Swap chain Present failed: 0x%08X", static_cast<unsigned>(hr));
         }
     }
 
-    void RendererD3D11::OnResize(std::uint32_t width, std::uint32_t height)
+    bool RendererD3D11::ResizeTargets(std::uint32_t width, std::uint32_t height)
     {
-        KBK_PROFILE_SCOPE("RendererResize");
+        KBK_PROFILE_SCOPE("RendererResizeTargets");
 
         if (!m_swapChain || width == 0 || height == 0)
-            return;
+            return false;
         if (width == m_width && height == m_height)
-            return;
+            return false;
 
         m_width = width;
         m_height = height;
@@ -127,15 +152,76 @@ namespace KibakoEngine {
         const HRESULT hr = m_swapChain->ResizeBuffers(0, width, height, DXGI_FORMAT_UNKNOWN, 0);
         if (FAILED(hr)) {
             KbkError(kLogChannel, "ResizeBuffers failed: 0x%08X", static_cast<unsigned>(hr));
-            return;
+            return false;
         }
 
         if (!CreateRenderTargets(width, height)) {
             KbkError(kLogChannel, "Failed to recreate render targets after resize");
+            return false;
+        }
+
+        return true;
+    }
+
+    void RendererD3D11::DrawSprites(const SpriteDrawData& data)
+    {
+        KBK_PROFILE_SCOPE("RendererDrawSprites");
+
+        const size_t spriteCount = data.vertices.size() / 4;
+        if (spriteCount == 0 || data.ranges.empty())
+            return;
+
+        if (!EnsureVertexCapacity(spriteCount) || !EnsureIndexCapacity(spriteCount))
+            return;
+
+        UpdateVSConstants(data.viewProjT);
+
+        D3D11_MAPPED_SUBRESOURCE mapped{};
+        const HRESULT mapResult = m_context->Map(m_spriteVB.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+        if (FAILED(mapResult)) {
+            KbkErrorLimited(kBatchLogChannel, 1, "Vertex buffer map failed: 0x%08X", static_cast<unsigned>(mapResult));
             return;
         }
 
-        m_camera.SetViewport(static_cast<float>(width), static_cast<float>(height));
+        std::memcpy(mapped.pData, data.vertices.data(), data.vertices.size() * sizeof(SpriteVertex));
+        m_context->Unmap(m_spriteVB.Get(), 0);
+
+        const UINT stride = sizeof(SpriteVertex);
+        const UINT offset = 0;
+        ID3D11Buffer* vb = m_spriteVB.Get();
+        ID3D11Buffer* ib = m_spriteIB.Get();
+        m_context->IASetVertexBuffers(0, 1, &vb, &stride, &offset);
+        m_context->IASetIndexBuffer(ib, DXGI_FORMAT_R32_UINT, 0);
+        m_context->IASetInputLayout(m_inputLayout.Get());
+        m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+        ID3D11Buffer* cbs[] = { m_cbVS.Get() };
+        m_context->VSSetConstantBuffers(0, 1, cbs);
+
+        m_context->VSSetShader(m_vs.Get(), nullptr, 0);
+        m_context->PSSetShader(m_ps.Get(), nullptr, 0);
+
+        const float blendFactor[4] = { 0.f, 0.f, 0.f, 0.f };
+        m_context->OMSetBlendState(m_blendAlpha.Get(), blendFactor, 0xFFFFFFFFu);
+        m_context->OMSetDepthStencilState(m_depthDisabled.Get(), 0);
+        m_context->RSSetState(m_rasterCullNone.Get());
+
+        ID3D11SamplerState* sampler = m_samplerPoint.Get();
+        m_context->PSSetSamplers(0, 1, &sampler);
+
+        for (const SpriteDrawRange& range : data.ranges) {
+            ID3D11ShaderResourceView* srv = range.texture ? range.texture->GetSRV() : nullptr;
+            if (!srv)
+                continue;
+
+            m_context->PSSetShaderResources(0, 1, &srv);
+            const UINT startIndex = static_cast<UINT>(range.firstSprite * 6u);
+            const UINT indexCount = static_cast<UINT>(range.spriteCount * 6u);
+            m_context->DrawIndexed(indexCount, startIndex, 0);
+
+            ID3D11ShaderResourceView* nullSrv = nullptr;
+            m_context->PSSetShaderResources(0, 1, &nullSrv);
+        }
     }
 
     bool RendererD3D11::CreateSwapChain(HWND hwnd, std::uint32_t width, std::uint32_t height)
@@ -234,9 +320,256 @@ namespace KibakoEngine {
 
         m_width = width;
         m_height = height;
-        m_camera.SetViewport(static_cast<float>(width), static_cast<float>(height));
         return true;
     }
 
+    bool RendererD3D11::CreateSpriteShaders(ID3D11Device* device)
+    {
+        KBK_PROFILE_SCOPE("CreateBatchShaders");
+
+        static constexpr const char* VS_SOURCE = R"(
+cbuffer CB_VS : register(b0)
+{
+    float4x4 gViewProj;
+};
+
+struct VSInput
+{
+    float3 position : POSITION;
+    float2 texcoord : TEXCOORD0;
+    float4 color    : COLOR0;
+};
+
+struct VSOutput
+{
+    float4 position : SV_Position;
+    float2 texcoord : TEXCOORD0;
+    float4 color    : COLOR0;
+};
+
+VSOutput main(VSInput input)
+{
+    VSOutput output;
+    output.position = mul(float4(input.position, 1.0f), gViewProj);
+    output.texcoord = input.texcoord;
+    output.color = input.color;
+    return output;
+}
+)";
+
+        static constexpr const char* PS_SOURCE = R"(
+Texture2D gTexture : register(t0);
+SamplerState gSampler : register(s0);
+
+float4 main(float4 position : SV_Position, float2 texcoord : TEXCOORD0, float4 color : COLOR0) : SV_Target
+{
+    float4 texColor = gTexture.Sample(gSampler, texcoord);
+    return float4(texColor.rgb * color.rgb, texColor.a * color.a);
+}
+)";
+
+        Microsoft::WRL::ComPtr<ID3DBlob> vsBlob;
+        Microsoft::WRL::ComPtr<ID3DBlob> psBlob;
+        Microsoft::WRL::ComPtr<ID3DBlob> errors;
+
+        HRESULT hr = D3DCompile(VS_SOURCE, std::strlen(VS_SOURCE), nullptr, nullptr, nullptr, "main", "vs_5_0", 0, 0,
+            vsBlob.GetAddressOf(), errors.GetAddressOf());
+        if (FAILED(hr)) {
+            if (errors)
+                KbkError(kBatchLogChannel, "VS compile error: %s", static_cast<const char*>(errors->GetBufferPointer()));
+            return false;
+        }
+        errors.Reset();
+
+        hr = D3DCompile(PS_SOURCE, std::strlen(PS_SOURCE), nullptr, nullptr, nullptr, "main", "ps_5_0", 0, 0,
+            psBlob.GetAddressOf(), errors.GetAddressOf());
+        if (FAILED(hr)) {
+            if (errors)
+                KbkError(kBatchLogChannel, "PS compile error: %s", static_cast<const char*>(errors->GetBufferPointer()));
+            return false;
+        }
+
+        hr = device->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), nullptr, m_vs.GetAddressOf());
+        if (FAILED(hr)) {
+            KbkError(kBatchLogChannel, "CreateVertexShader failed: 0x%08X", static_cast<unsigned>(hr));
+            return false;
+        }
+        hr = device->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(), nullptr, m_ps.GetAddressOf());
+        if (FAILED(hr)) {
+            KbkError(kBatchLogChannel, "CreatePixelShader failed: 0x%08X", static_cast<unsigned>(hr));
+            return false;
+        }
+
+        D3D11_INPUT_ELEMENT_DESC layout[] = {
+            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0,  D3D11_INPUT_PER_VERTEX_DATA, 0 },
+            { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,    0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+            { "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 20, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        };
+        hr = device->CreateInputLayout(layout, static_cast<UINT>(std::size(layout)), vsBlob->GetBufferPointer(),
+            vsBlob->GetBufferSize(), m_inputLayout.GetAddressOf());
+        if (FAILED(hr)) {
+            KbkError(kBatchLogChannel, "CreateInputLayout failed: 0x%08X", static_cast<unsigned>(hr));
+            return false;
+        }
+
+        D3D11_BUFFER_DESC cbd{};
+        cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+        cbd.Usage = D3D11_USAGE_DYNAMIC;
+        cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        cbd.ByteWidth = sizeof(CBVS);
+        hr = device->CreateBuffer(&cbd, nullptr, m_cbVS.GetAddressOf());
+        if (FAILED(hr)) {
+            KbkError(kBatchLogChannel, "CreateBuffer (CBVS) failed: 0x%08X", static_cast<unsigned>(hr));
+            return false;
+        }
+
+        return true;
+    }
+
+    bool RendererD3D11::CreateSpriteStates(ID3D11Device* device)
+    {
+        KBK_PROFILE_SCOPE("CreateBatchStates");
+
+        D3D11_SAMPLER_DESC samp{};
+        samp.AddressU = samp.AddressV = samp.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+        samp.MinLOD = 0;
+        samp.MaxLOD = D3D11_FLOAT32_MAX;
+        samp.MaxAnisotropy = 1;
+        samp.Filter = D3D11_FILTER_MIN_MAG_MIP_POINT;
+        HRESULT hr = device->CreateSamplerState(&samp, m_samplerPoint.GetAddressOf());
+        if (FAILED(hr)) {
+            KbkError(kBatchLogChannel, "CreateSamplerState failed: 0x%08X", static_cast<unsigned>(hr));
+            return false;
+        }
+
+        D3D11_BLEND_DESC blend{};
+        blend.RenderTarget[0].BlendEnable = TRUE;
+        blend.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
+        blend.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
+        blend.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
+        blend.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
+        blend.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_INV_SRC_ALPHA;
+        blend.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
+        blend.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+        hr = device->CreateBlendState(&blend, m_blendAlpha.GetAddressOf());
+        if (FAILED(hr)) {
+            KbkError(kBatchLogChannel, "CreateBlendState failed: 0x%08X", static_cast<unsigned>(hr));
+            return false;
+        }
+
+        D3D11_DEPTH_STENCIL_DESC depth{};
+        depth.DepthEnable = FALSE;
+        depth.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
+        depth.DepthFunc = D3D11_COMPARISON_ALWAYS;
+        hr = device->CreateDepthStencilState(&depth, m_depthDisabled.GetAddressOf());
+        if (FAILED(hr)) {
+            KbkError(kBatchLogChannel, "CreateDepthStencilState failed: 0x%08X", static_cast<unsigned>(hr));
+            return false;
+        }
+
+        D3D11_RASTERIZER_DESC rast{};
+        rast.FillMode = D3D11_FILL_SOLID;
+        rast.CullMode = D3D11_CULL_NONE;
+        rast.DepthClipEnable = TRUE;
+        hr = device->CreateRasterizerState(&rast, m_rasterCullNone.GetAddressOf());
+        if (FAILED(hr)) {
+            KbkError(kBatchLogChannel, "CreateRasterizerState failed: 0x%08X", static_cast<unsigned>(hr));
+            return false;
+        }
+
+        return true;
+    }
+
+    bool RendererD3D11::EnsureVertexCapacity(size_t spriteCount)
+    {
+        KBK_PROFILE_SCOPE("EnsureVertexCapacity");
+
+        if (spriteCount <= m_spriteVBCapacity && m_spriteVB)
+            return true;
+
+        size_t newCapacity = m_spriteVBCapacity == 0 ? 256 : m_spriteVBCapacity;
+        while (newCapacity < spriteCount)
+            newCapacity *= 2;
+
+        D3D11_BUFFER_DESC desc{};
+        desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+        desc.Usage = D3D11_USAGE_DYNAMIC;
+        desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        desc.ByteWidth = static_cast<UINT>(newCapacity * 4 * sizeof(SpriteVertex));
+
+        Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+        const HRESULT hr = m_device->CreateBuffer(&desc, nullptr, buffer.GetAddressOf());
+        if (FAILED(hr)) {
+            KbkError(kBatchLogChannel, "CreateBuffer (VB) failed: 0x%08X", static_cast<unsigned>(hr));
+            return false;
+        }
+
+        m_spriteVB = buffer;
+        m_spriteVBCapacity = newCapacity;
+        return true;
+    }
+
+    bool RendererD3D11::EnsureIndexCapacity(size_t spriteCount)
+    {
+        KBK_PROFILE_SCOPE("EnsureIndexCapacity");
+
+        if (spriteCount <= m_spriteIBCapacity && m_spriteIB)
+            return true;
+
+        size_t newCapacity = m_spriteIBCapacity == 0 ? 256 : m_spriteIBCapacity;
+        while (newCapacity < spriteCount)
+            newCapacity *= 2;
+
+        const size_t indexCount = newCapacity * 6;
+        std::vector<std::uint32_t> indices(indexCount);
+        for (size_t sprite = 0; sprite < newCapacity; ++sprite) {
+            const std::uint32_t base = static_cast<std::uint32_t>(sprite * 4);
+            std::uint32_t* quad = indices.data() + sprite * 6;
+            quad[0] = base;
+            quad[1] = base + 1;
+            quad[2] = base + 2;
+            quad[3] = base;
+            quad[4] = base + 2;
+            quad[5] = base + 3;
+        }
+
+        D3D11_BUFFER_DESC desc{};
+        desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+        desc.Usage = D3D11_USAGE_IMMUTABLE;
+        desc.ByteWidth = static_cast<UINT>(indexCount * sizeof(std::uint32_t));
+
+        D3D11_SUBRESOURCE_DATA data{};
+        data.pSysMem = indices.data();
+
+        Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+        const HRESULT hr = m_device->CreateBuffer(&desc, &data, buffer.GetAddressOf());
+        if (FAILED(hr)) {
+            KbkError(kBatchLogChannel, "CreateBuffer (IB) failed: 0x%08X", static_cast<unsigned>(hr));
+            return false;
+        }
+
+        m_spriteIB = buffer;
+        m_spriteIBCapacity = newCapacity;
+        return true;
+    }
+
+    void RendererD3D11::UpdateVSConstants(const XMFLOAT4X4& viewProjT)
+    {
+        KBK_PROFILE_SCOPE("UpdateVSConstants");
+
+        D3D11_MAPPED_SUBRESOURCE mapped{};
+        const HRESULT hr = m_context->Map(m_cbVS.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+        if (FAILED(hr)) {
+            KbkError(kBatchLogChannel, "Constant buffer map failed: 0x%08X", static_cast<unsigned>(hr));
+            return;
+        }
+
+        auto* cb = static_cast<CBVS*>(mapped.pData);
+        cb->viewProjT = viewProjT;
+        m_context->Unmap(m_cbVS.Get(), 0);
+    }
+
 } // namespace KibakoEngine
 
+#endif // defined(_WIN32)
+
@@ -0,0 +1,97 @@
+// Headless renderer
+#include "KibakoEngine/Renderer/RendererNull.h"
+
+#include "KibakoEngine/Core/Debug.h"
+#include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/MemoryTracker.h"
+#include "KibakoEngine/Core/Profiler.h"
+
+#include <utility>
+
+namespace KibakoEngine {
+
+    namespace
+    {
+        constexpr const char* kLogChannel = "Renderer";
+    }
+
+    bool RendererNull::Init(std::uint32_t width, std::uint32_t height)
+    {
+        KBK_PROFILE_SCOPE("RendererInit");
+
+        if (!InitCommon(width, height))
+            return false;
+
+        m_stats = {};
+        m_initialized = true;
+        KbkLog(kLogChannel, "Headless renderer initialized (%ux%u)", width, height);
+        return true;
+    }
+
+    void RendererNull::Shutdown()
+    {
+        if (!m_initialized)
+            return;
+
+        KBK_PROFILE_SCOPE("RendererShutdown");
+
+        ShutdownCommon();
+        m_currentFrame = {};
+        m_lastFrame = {};
+        m_initialized = false;
+    }
+
+    void RendererNull::BeginFrame(const float clearColor[4])
+    {
+        m_currentFrame.frameIndex = m_stats.frames;
+        for (int i = 0; i < 4; ++i)
+            m_currentFrame.clearColor[i] = clearColor ? clearColor[i] : (i == 3 ? 1.0f : 0.0f);
+        m_currentFrame.vertices.clear();
+        m_currentFrame.draws.clear();
+    }
+
+    void RendererNull::EndFrame(bool waitForVSync)
+    {
+        KBK_MEMORY_TAG(Renderer);
+        KBK_UNUSED(waitForVSync);
+
+        ++m_stats.frames;
+        if (m_captureEnabled)
+            std::swap(m_currentFrame, m_lastFrame);
+    }
+
+    bool RendererNull::ResizeTargets(std::uint32_t width, std::uint32_t height)
+    {
+        if (width == 0 || height == 0)
+            return false;
+        if (width == m_width && height == m_height)
+            return false;
+
+        m_width = width;
+        m_height = height;
+        return true;
+    }
+
+    void RendererNull::DrawSprites(const SpriteDrawData& data)
+    {
+        KBK_PROFILE_SCOPE("RendererDrawSprites");
+        KBK_MEMORY_TAG(Renderer);
+
+        m_stats.sprites += data.vertices.size() / 4;
+        m_stats.drawRanges += data.ranges.size();
+
+        if (!m_captureEnabled)
+            return;
+
+        const auto spriteBase = static_cast<std::uint32_t>(m_currentFrame.vertices.size() / 4);
+        m_currentFrame.vertices.insert(m_currentFrame.vertices.end(), data.vertices.begin(), data.vertices.end());
+        for (const SpriteDrawRange& range : data.ranges) {
+            CapturedSpriteDraw draw{};
+            draw.viewProjT = data.viewProjT;
+            draw.range = range;
+            draw.range.firstSprite += spriteBase;
+            m_currentFrame.draws.push_back(draw);
+        }
+    }
+
+} // namespace KibakoEngine
@@ -0,0 +1,669 @@
+// CPU sprite rasterizer
+#include "KibakoEngine/Renderer/RendererSoftware.h"
+
+#include "KibakoEngine/Core/Debug.h"
+#include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/MemoryTracker.h"
+#include "KibakoEngine/Core/Profiler.h"
+#include "KibakoEngine/Renderer/Texture2D.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#if KBK_SOFTWARE_RASTER_SSE2
+#    include <emmintrin.h>
+#endif
+
+namespace KibakoEngine {
+
+    namespace
+    {
+        constexpr const char* kLogChannel = "Renderer";
+
+        // 24.8 fixed point, like the GPU's subpixel grid
+        constexpr std::int64_t kSubpixelOne = 256;
+        constexpr std::int64_t kSubpixelHalf = kSubpixelOne / 2;
+        // Vertices further than this (in pixels) are clamped so edge math fits in 64 bits
+        constexpr double kGuardBand = 1048576.0;
+
+        constexpr float kInv255 = 1.0f / 255.0f;
+
+        struct ChannelTables
+        {
+            float linear[256];
+            float srgb[256];   // sRGB-encoded byte -> linear, as *_SRGB texture reads
+        };
+
+        const ChannelTables& Tables()
+        {
+            static const ChannelTables tables = [] {
+                ChannelTables t{};
+                for (int i = 0; i < 256; ++i) {
+                    const float c = static_cast<float>(i) * kInv255;
+                    t.linear[i] = c;
+                    t.srgb[i] = c <= 0.04045f
+                        ? c / 12.92f
+                        : static_cast<float>(std::pow((static_cast<double>(c) + 0.055) / 1.055, 2.4));
+                }
+                return t;
+            }();
+            return tables;
+        }
+
+        // d > 0
+        std::int64_t FloorDiv(std::int64_t n, std::int64_t d)
+        {
+            std::int64_t q = n / d;
+            if ((n % d) != 0 && n < 0)
+                --q;
+            return q;
+        }
+
+        std::int64_t CeilDiv(std::int64_t n, std::int64_t d)
+        {
+            return -FloorDiv(-n, d);
+        }
+
+        std::int64_t ToSubpixel(float value)
+        {
+            const double clamped = std::clamp(static_cast<double>(value), -kGuardBand, kGuardBand);
+            return static_cast<std::int64_t>(std::floor(clamped * static_cast<double>(kSubpixelOne) + 0.5));
+        }
+
+        float Saturate(float value)
+        {
+            return std::min(std::max(value, 0.0f), 1.0f);
+        }
+
+        std::uint8_t Quantize(float value)
+        {
+            const int q = static_cast<int>(value * 255.0f + 0.5f);
+            return static_cast<std::uint8_t>(std::min(q, 255));
+        }
+
+        // Point sampling with clamp addressing, matching the D3D11 sampler.
+        // Clamping first makes truncation equal to floor.
+        const std::uint8_t* SampleTexel(const std::uint8_t* texels, std::int32_t width, std::int32_t height, float u, float v)
+        {
+            float fx = u * static_cast<float>(width);
+            float fy = v * static_cast<float>(height);
+            if (!(fx >= 0.0f))
+                fx = 0.0f;
+            if (!(fy >= 0.0f))
+                fy = 0.0f;
+
+            const std::int32_t tx = static_cast<std::int32_t>(std::min(fx, static_cast<float>(width - 1)));
+            const std::int32_t ty = static_cast<std::int32_t>(std::min(fy, static_cast<float>(height - 1)));
+            return texels + (static_cast<std::size_t>(ty) * static_cast<std::size_t>(width) + static_cast<std::size_t>(tx)) * 4u;
+        }
+
+        struct Edge
+        {
+            std::int64_t a = 0;
+            std::int64_t b = 0;
+            std::int64_t c = 0;
+            std::int64_t bias = 0;   // 0 on top-left edges, 1 elsewhere
+        };
+
+        // E(p) = (x1 - x0) * (p.y - y0) - (y1 - y0) * (p.x - x0), positive inside
+        Edge MakeEdge(std::int64_t x0, std::int64_t y0, std::int64_t x1, std::int64_t y1)
+        {
+            const std::int64_t dx = x1 - x0;
+            const std::int64_t dy = y1 - y0;
+
+            Edge edge;
+            edge.a = -dy;
+            edge.b = dx;
+            edge.c = dy * x0 - dx * y0;
+
+            const bool topLeft = (dy == 0 && dx > 0) || dy < 0;
+            edge.bias = topLeft ? 0 : 1;
+            return edge;
+        }
+
+        // Plane through three points, evaluated at pixel centers
+        void MakePlane(const float x[3], const float y[3], const float value[3], float det, float out[3])
+        {
+            const float dx1 = x[1] - x[0];
+            const float dy1 = y[1] - y[0];
+            const float dx2 = x[2] - x[0];
+            const float dy2 = y[2] - y[0];
+            const float dv1 = value[1] - value[0];
+            const float dv2 = value[2] - value[0];
+
+            out[0] = (dv1 * dy2 - dv2 * dy1) / det;
+            out[1] = (dv2 * dx1 - dv1 * dx2) / det;
+            out[2] = value[0] - out[0] * x[0] - out[1] * y[0];
+        }
+    }
+
+    bool RendererSoftware::Init(std::uint32_t width, std::uint32_t height, int workerCount)
+    {
+        KBK_PROFILE_SCOPE("RendererInit");
+        KBK_MEMORY_TAG(Renderer);
+
+        if (m_initialized)
+            return true;
+
+        if (width == 0 || height == 0) {
+            KbkError(kLogChannel, "Software renderer requires a positive size (%ux%u)", width, height);
+            return false;
+        }
+
+        ResizeImage(width, height);
+        if (!InitCommon(width, height))
+            return false;
+
+        if (workerCount < 0) {
+            const unsigned hardwareThreads = std::thread::hardware_concurrency();
+            workerCount = hardwareThreads > 1 ? static_cast<int>(hardwareThreads) - 1 : 0;
+        }
+
+        m_stopWorkers = false;
+        m_jobGeneration = 0;
+        m_workers.reserve(static_cast<std::size_t>(workerCount));
+        for (int i = 0; i < workerCount; ++i)
+            m_workers.emplace_back([this, i]() { WorkerMain(i); });
+
+        m_simdEnabled = KBK_SOFTWARE_RASTER_SSE2 != 0;
+        m_stats = {};
+        m_initialized = true;
+
+        KbkLog(kLogChannel, "Software renderer initialized (%ux%u, %d workers, %s)",
+            width, height, workerCount, m_simdEnabled ? "SSE2" : "scalar");
+        return true;
+    }
+
+    void RendererSoftware::Shutdown()
+    {
+        if (!m_initialized)
+            return;
+
+        KBK_PROFILE_SCOPE("RendererShutdown");
+
+        {
+            std::lock_guard<std::mutex> lock(m_poolMutex);
+            m_stopWorkers = true;
+        }
+        m_poolWake.notify_all();
+        for (std::thread& worker : m_workers)
+            worker.join();
+        m_workers.clear();
+
+        ShutdownCommon();
+
+        m_sprites.clear();
+        m_tileBins.clear();
+        m_tilesX = 0;
+        m_tilesY = 0;
+        m_image = {};
+        m_initialized = false;
+    }
+
+    void RendererSoftware::SetSimdEnabled(bool enabled)
+    {
+        m_simdEnabled = enabled && KBK_SOFTWARE_RASTER_SSE2 != 0;
+    }
+
+    bool RendererSoftware::CaptureImage(ImageRGBA8& out) const
+    {
+        if (m_image.Empty())
+            return false;
+
+        out = m_image;
+        return true;
+    }
+
+    void RendererSoftware::ResizeImage(std::uint32_t width, std::uint32_t height)
+    {
+        m_image.Resize(width, height);
+        m_tilesX = (width + kTileSize - 1) / kTileSize;
+        m_tilesY = (height + kTileSize - 1) / kTileSize;
+        m_tileBins.resize(static_cast<std::size_t>(m_tilesX) * m_tilesY);
+    }
+
+    void RendererSoftware::BeginFrame(const float clearColor[4])
+    {
+        KBK_MEMORY_TAG(Renderer);
+        for (int i = 0; i < 4; ++i) {
+            const float channel = clearColor ? clearColor[i] : (i == 3 ? 1.0f : 0.0f);
+            m_clearBytes[i] = Quantize(Saturate(channel));
+        }
+        m_sprites.clear();
+    }
+
+    void RendererSoftware::EndFrame(bool waitForVSync)
+    {
+        KBK_MEMORY_TAG(Renderer);
+        KBK_UNUSED(waitForVSync);
+        KBK_PROFILE_SCOPE("SoftwareRasterize");
+
+        BinSprites();
+        RasterizeFrame();
+
+        ++m_stats.frames;
+        m_stats.sprites = static_cast<std::uint32_t>(m_sprites.size());
+        m_stats.pixelsShaded = m_pixelsShaded.load(std::memory_order_relaxed);
+        m_stats.tiles = static_cast<std::uint32_t>(std::count_if(
+            m_tileBins.begin(), m_tileBins.end(),
+            [](const std::vector<std::uint32_t>& bin) { return !bin.empty(); }));
+    }
+
+    bool RendererSoftware::ResizeTargets(std::uint32_t width, std::uint32_t height)
+    {
+        if (width == 0 || height == 0)
+            return false;
+        if (width == m_width && height == m_height)
+            return false;
+
+        m_width = width;
+        m_height = height;
+        ResizeImage(width, height);
+        return true;
+    }
+
+    void RendererSoftware::DrawSprites(const SpriteDrawData& data)
+    {
+        KBK_PROFILE_SCOPE("RendererDrawSprites");
+        KBK_MEMORY_TAG(Renderer);
+
+        const float viewWidth = static_cast<float>(m_width);
+        const float viewHeight = static_cast<float>(m_height);
+        const auto& m = data.viewProjT.m;
+
+        for (const SpriteDrawRange& range : data.ranges) {
+            const Texture2D* texture = range.texture;
+            // Device textures keep no CPU copy to sample from
+            if (!texture || texture->Pixels().empty())
+                continue;
+
+            const std::uint32_t end = range.firstSprite + range.spriteCount;
+            for (std::uint32_t index = range.firstSprite; index < end; ++index) {
+                const SpriteVertex* quad = data.vertices.data() + static_cast<std::size_t>(index) * 4u;
+
+                RasterSprite sprite{};
+                bool valid = true;
+                for (int i = 0; i < 4; ++i) {
+                    // Same row-vector transform as the D3D11 vertex shader
+                    const DirectX::XMFLOAT3& p = quad[i].position;
+                    const float clipX = m[0][0] * p.x + m[0][1] * p.y + m[0][2] * p.z + m[0][3];
+                    const float clipY = m[1][0] * p.x + m[1][1] * p.y + m[1][2] * p.z + m[1][3];
+                    const float clipW = m[3][0] * p.x + m[3][1] * p.y + m[3][2] * p.z + m[3][3];
+                    if (std::fabs(clipW) < 1.0e-12f) {
+                        valid = false;
+                        break;
+                    }
+
+                    const float screenX = (clipX / clipW * 0.5f + 0.5f) * viewWidth;
+                    const float screenY = (0.5f - clipY / clipW * 0.5f) * viewHeight;
+                    sprite.x[i] = ToSubpixel(screenX);
+                    sprite.y[i] = ToSubpixel(screenY);
+                }
+                if (!valid)
+                    continue;
+
+                const std::int64_t minSx = std::min({ sprite.x[0], sprite.x[1], sprite.x[2], sprite.x[3] });
+                const std::int64_t maxSx = std::max({ sprite.x[0], sprite.x[1], sprite.x[2], sprite.x[3] });
+                const std::int64_t minSy = std::min({ sprite.y[0], sprite.y[1], sprite.y[2], sprite.y[3] });
+                const std::int64_t maxSy = std::max({ sprite.y[0], sprite.y[1], sprite.y[2], sprite.y[3] });
+
+                // Pixels whose centers fall inside the bounds
+                const std::int64_t minX = std::max<std::int64_t>(CeilDiv(minSx - kSubpixelHalf, kSubpixelOne), 0);
+                const std::int64_t minY = std::max<std::int64_t>(CeilDiv(minSy - kSubpixelHalf, kSubpixelOne), 0);
+                const std::int64_t maxX = std::min<std::int64_t>(FloorDiv(maxSx - kSubpixelHalf, kSubpixelOne), m_width - 1);
+                const std::int64_t maxY = std::min<std::int64_t>(FloorDiv(maxSy - kSubpixelHalf, kSubpixelOne), m_height - 1);
+                if (minX > maxX || minY > maxY)
+                    continue;
+
+                // Sprite quads are parallelograms, so one plane from (0,1,2) maps the whole quad
+                float px[3];
+                float py[3];
+                for (int i = 0; i < 3; ++i) {
+                    px[i] = static_cast<float>(sprite.x[i]) / static_cast<float>(kSubpixelOne);
+                    py[i] = static_cast<float>(sprite.y[i]) / static_cast<float>(kSubpixelOne);
+                }
+                const float det = (px[1] - px[0]) * (py[2] - py[0]) - (px[2] - px[0]) * (py[1] - py[0]);
+                if (det == 0.0f)
+                    continue;
+
+                const float u[3] = { quad[0].uv.x, quad[1].uv.x, quad[2].uv.x };
+                const float v[3] = { quad[0].uv.y, quad[1].uv.y, quad[2].uv.y };
+                MakePlane(px, py, u, det, sprite.uPlane);
+                MakePlane(px, py, v, det, sprite.vPlane);
+
+                sprite.color[0] = quad[0].color.x;
+                sprite.color[1] = quad[0].color.y;
+                sprite.color[2] = quad[0].color.z;
+                sprite.color[3] = quad[0].color.w;
+                sprite.texels = texture->Pixels().data();
+                sprite.texWidth = texture->Width();
+                sprite.texHeight = texture->Height();
+                sprite.srgb = texture->IsSRGB();
+                sprite.minX = static_cast<std::int32_t>(minX);
+                sprite.minY = static_cast<std::int32_t>(minY);
+                sprite.maxX = static_cast<std::int32_t>(maxX);
+                sprite.maxY = static_cast<std::int32_t>(maxY);
+
+                m_sprites.push_back(sprite);
+            }
+        }
+    }
+
+    void RendererSoftware::BinSprites()
+    {
+        KBK_PROFILE_SCOPE("SoftwareBinSprites");
+
+        for (std::vector<std::uint32_t>& bin : m_tileBins)
+            bin.clear();
+
+        for (std::size_t i = 0; i < m_sprites.size(); ++i) {
+            const RasterSprite& sprite = m_sprites[i];
+            const std::uint32_t tx0 = static_cast<std::uint32_t>(sprite.minX) / kTileSize;
+            const std::uint32_t ty0 = static_cast<std::uint32_t>(sprite.minY) / kTileSize;
+            const std::uint32_t tx1 = static_cast<std::uint32_t>(sprite.maxX) / kTileSize;
+            const std::uint32_t ty1 = static_cast<std::uint32_t>(sprite.maxY) / kTileSize;
+
+            for (std::uint32_t ty = ty0; ty <= ty1; ++ty) {
+                for (std::uint32_t tx = tx0; tx <= tx1; ++tx)
+                    m_tileBins[static_cast<std::size_t>(ty) * m_tilesX + tx].push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+    }
+
+    void RendererSoftware::RasterizeFrame()
+    {
+        m_nextTile.store(0, std::memory_order_relaxed);
+        m_pixelsShaded.store(0, std::memory_order_relaxed);
+
+        if (!m_workers.empty()) {
+            {
+                std::lock_guard<std::mutex> lock(m_poolMutex);
+                m_busyWorkers = static_cast<std::uint32_t>(m_workers.size());
+                ++m_jobGeneration;
+            }
+            m_poolWake.notify_all();
+        }
+
+        RunTiles();
+
+        if (!m_workers.empty()) {
+            std::unique_lock<std::mutex> lock(m_poolMutex);
+            m_poolDone.wait(lock, [this]() { return m_busyWorkers == 0; });
+        }
+    }
+
+    void RendererSoftware::WorkerMain(int index)
+    {
+        char threadName[32];
+        std::snprintf(threadName, sizeof(threadName), "Raster %d", index);
+        Profiler::SetThreadName(threadName);
+
+        std::uint64_t seenGeneration = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_poolMutex);
+                m_poolWake.wait(lock, [&]() { return m_stopWorkers || m_jobGeneration != seenGeneration; });
+                if (m_stopWorkers)
+                    return;
+                seenGeneration = m_jobGeneration;
+            }
+
+            RunTiles();
+
+            std::lock_guard<std::mutex> lock(m_poolMutex);
+            if (--m_busyWorkers == 0)
+                m_poolDone.notify_one();
+        }
+    }
+
+    void RendererSoftware::RunTiles()
+    {
+        const std::uint32_t tileCount = m_tilesX * m_tilesY;
+        std::uint64_t pixels = 0;
+        for (;;) {
+            const std::uint32_t tile = m_nextTile.fetch_add(1, std::memory_order_relaxed);
+            if (tile >= tileCount)
+                break;
+            pixels += RasterizeTile(tile);
+        }
+        m_pixelsShaded.fetch_add(pixels, std::memory_order_relaxed);
+    }
+
+    std::uint64_t RendererSoftware::RasterizeTile(std::uint32_t tileIndex)
+    {
+        const std::uint32_t tx = tileIndex % m_tilesX;
+        const std::uint32_t ty = tileIndex / m_tilesX;
+
+        TileRect rect{};
+        rect.x0 = static_cast<std::int32_t>(tx * kTileSize);
+        rect.y0 = static_cast<std::int32_t>(ty * kTileSize);
+        rect.x1 = static_cast<std::int32_t>(std::min((tx + 1) * kTileSize, m_image.width));
+        rect.y1 = static_cast<std::int32_t>(std::min((ty + 1) * kTileSize, m_image.height));
+
+        for (std::int32_t y = rect.y0; y < rect.y1; ++y) {
+            std::uint8_t* row = m_image.pixels.data() +
+                (static_cast<std::size_t>(y) * m_image.width + static_cast<std::size_t>(rect.x0)) * 4u;
+            for (std::int32_t x = rect.x0; x < rect.x1; ++x, row += 4)
+                std::memcpy(row, m_clearBytes, 4);
+        }
+
+        // Both triangles use the D3D11 index order (0,1,2) (0,2,3)
+        std::uint64_t pixels = 0;
+        for (const std::uint32_t spriteIndex : m_tileBins[tileIndex]) {
+            const RasterSprite& sprite = m_sprites[spriteIndex];
+            pixels += RasterizeTriangle(sprite, 0, 1, 2, rect);
+            pixels += RasterizeTriangle(sprite, 0, 2, 3, rect);
+        }
+        return pixels;
+    }
+
+    std::uint64_t RendererSoftware::RasterizeTriangle(const RasterSprite& sprite, int i0, int i1, int i2, const TileRect& rect)
+    {
+        std::int64_t ax = sprite.x[i0];
+        std::int64_t ay = sprite.y[i0];
+        std::int64_t bx = sprite.x[i1];
+        std::int64_t by = sprite.y[i1];
+        std::int64_t cx = sprite.x[i2];
+        std::int64_t cy = sprite.y[i2];
+
+        const std::int64_t area = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+        if (area == 0)
+            return 0;
+        // No culling: flip clockwise triangles so the inside is always positive
+        if (area < 0) {
+            std::swap(bx, cx);
+            std::swap(by, cy);
+        }
+
+        const Edge edges[3] = {
+            MakeEdge(ax, ay, bx, by),
+            MakeEdge(bx, by, cx, cy),
+            MakeEdge(cx, cy, ax, ay),
+        };
+
+        const std::int32_t yBegin = std::max(rect.y0, sprite.minY);
+        const std::int32_t yEnd = std::min(rect.y1 - 1, sprite.maxY);
+        const std::int32_t xBegin = std::max(rect.x0, sprite.minX);
+        const std::int32_t xEnd = std::min(rect.x1 - 1, sprite.maxX);
+
+        std::uint64_t pixels = 0;
+        for (std::int32_t y = yBegin; y <= yEnd; ++y) {
+            const std::int64_t centerY = static_cast<std::int64_t>(y) * kSubpixelOne + kSubpixelHalf;
+
+            // Solve a*x + k >= bias per edge for the covered span of this row
+            std::int64_t lo = xBegin;
+            std::int64_t hi = xEnd;
+            for (const Edge& edge : edges) {
+                const std::int64_t step = edge.a * kSubpixelOne;
+                const std::int64_t k = edge.a * kSubpixelHalf + edge.b * centerY + edge.c;
+                if (step > 0)
+                    lo = std::max(lo, CeilDiv(edge.bias - k, step));
+                else if (step < 0)
+                    hi = std::min(hi, FloorDiv(k - edge.bias, -step));
+                else if (k < edge.bias)
+                    hi = lo - 1;
+            }
+
+            if (lo > hi)
+                continue;
+
+            ShadeSpan(sprite, y, static_cast<std::int32_t>(lo), static_cast<std::int32_t>(hi));
+            pixels += static_cast<std::uint64_t>(hi - lo + 1);
+        }
+        return pixels;
+    }
+
+    void RendererSoftware::ShadeSpan(const RasterSprite& sprite, std::int32_t y, std::int32_t x0, std::int32_t x1)
+    {
+#if KBK_SOFTWARE_RASTER_SSE2
+        if (m_simdEnabled) {
+            ShadeSpanSSE2(sprite, y, x0, x1);
+            return;
+        }
+#endif
+
+        const ChannelTables& tables = Tables();
+        const float* colorTable = sprite.srgb ? tables.srgb : tables.linear;
+
+        const float centerY = static_cast<float>(y) + 0.5f;
+        const float uRow = sprite.uPlane[1] * centerY + sprite.uPlane[2];
+        const float vRow = sprite.vPlane[1] * centerY + sprite.vPlane[2];
+
+        std::uint8_t* dst = m_image.pixels.data() +
+            (static_cast<std::size_t>(y) * m_image.width + static_cast<std::size_t>(x0)) * 4u;
+        for (std::int32_t x = x0; x <= x1; ++x, dst += 4) {
+            const float centerX = static_cast<float>(x) + 0.5f;
+            const std::uint8_t* texel = SampleTexel(sprite.texels, sprite.texWidth, sprite.texHeight,
+                sprite.uPlane[0] * centerX + uRow, sprite.vPlane[0] * centerX + vRow);
+
+            // SRC_ALPHA / INV_SRC_ALPHA for color, ONE / INV_SRC_ALPHA for alpha
+            const float srcA = Saturate(tables.linear[texel[3]] * sprite.color[3]);
+            const float invA = 1.0f - srcA;
+            for (int c = 0; c < 3; ++c) {
+                const float src = Saturate(colorTable[texel[c]] * sprite.color[c]);
+                dst[c] = Quantize(src * srcA + tables.linear[dst[c]] * invA);
+            }
+            dst[3] = Quantize(srcA * 1.0f + tables.linear[dst[3]] * invA);
+        }
+    }
+
+#if KBK_SOFTWARE_RASTER_SSE2
+    namespace
+    {
+        // Four RGBA8 pixels to one register per channel
+        void UnpackChannels(__m128i pixels, __m128i out[4])
+        {
+            const __m128i byteMask = _mm_set1_epi32(0xFF);
+            out[0] = _mm_and_si128(pixels, byteMask);
+            out[1] = _mm_and_si128(_mm_srli_epi32(pixels, 8), byteMask);
+            out[2] = _mm_and_si128(_mm_srli_epi32(pixels, 16), byteMask);
+            out[3] = _mm_srli_epi32(pixels, 24);
+        }
+
+        // Same rounding as Quantize; packus saturates at 255
+        __m128i QuantizeChannels(const __m128 channels[4])
+        {
+            const __m128 scale = _mm_set1_ps(255.0f);
+            const __m128 half = _mm_set1_ps(0.5f);
+            __m128i q[4];
+            for (int c = 0; c < 4; ++c)
+                q[c] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(channels[c], scale), half));
+
+            // R0..R3 G0..G3 B0..B3 A0..A3, then interleaved back to R0 G0 B0 A0 R1 ...
+            const __m128i planar = _mm_packus_epi16(_mm_packs_epi32(q[0], q[1]), _mm_packs_epi32(q[2], q[3]));
+            const __m128i pairs = _mm_unpacklo_epi8(planar, _mm_srli_si128(planar, 8));
+            return _mm_unpacklo_epi8(pairs, _mm_srli_si128(pairs, 8));
+        }
+    } // namespace
+
+    void RendererSoftware::ShadeSpanSSE2(const RasterSprite& sprite, std::int32_t y, std::int32_t x0, std::int32_t x1)
+    {
+        const ChannelTables& tables = Tables();
+
+        const float centerY = static_cast<float>(y) + 0.5f;
+        const float uRow = sprite.uPlane[1] * centerY + sprite.uPlane[2];
+        const float vRow = sprite.vPlane[1] * centerY + sprite.vPlane[2];
+
+        // Four pixels per iteration, one register per channel; same operation order as the scalar path
+        const __m128 uStep = _mm_set1_ps(sprite.uPlane[0]);
+        const __m128 vStep = _mm_set1_ps(sprite.vPlane[0]);
+        const __m128 uBase = _mm_set1_ps(uRow);
+        const __m128 vBase = _mm_set1_ps(vRow);
+        const __m128 texWidth = _mm_set1_ps(static_cast<float>(sprite.texWidth));
+        const __m128 texHeight = _mm_set1_ps(static_cast<float>(sprite.texHeight));
+        const __m128 maxTexX = _mm_set1_ps(static_cast<float>(sprite.texWidth - 1));
+        const __m128 maxTexY = _mm_set1_ps(static_cast<float>(sprite.texHeight - 1));
+        const __m128 color[4] = { _mm_set1_ps(sprite.color[0]), _mm_set1_ps(sprite.color[1]),
+                                  _mm_set1_ps(sprite.color[2]), _mm_set1_ps(sprite.color[3]) };
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 inv255 = _mm_set1_ps(kInv255);
+        const __m128i laneOffsets = _mm_setr_epi32(0, 1, 2, 3);
+
+        std::uint8_t* dst = m_image.pixels.data() +
+            (static_cast<std::size_t>(y) * m_image.width + static_cast<std::size_t>(x0)) * 4u;
+        for (std::int32_t x = x0; x <= x1; x += 4, dst += 16) {
+            // The last group may be partial; its extra lanes sample clamped texels and are not stored
+            const std::size_t bytes = static_cast<std::size_t>(std::min(x1 - x + 1, 4)) * 4u;
+
+            const __m128 centerX = _mm_add_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(x), laneOffsets)), half);
+            const __m128 u = _mm_add_ps(_mm_mul_ps(uStep, centerX), uBase);
+            const __m128 v = _mm_add_ps(_mm_mul_ps(vStep, centerX), vBase);
+
+            // SampleTexel per lane: max with zero first maps NaN to zero
+            alignas(16) std::int32_t tx[4];
+            alignas(16) std::int32_t ty[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(tx),
+                _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(u, texWidth), zero), maxTexX)));
+            _mm_store_si128(reinterpret_cast<__m128i*>(ty),
+                _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(v, texHeight), zero), maxTexY)));
+
+            alignas(16) std::uint32_t fetched[4];
+            for (int lane = 0; lane < 4; ++lane) {
+                const std::size_t index = static_cast<std::size_t>(ty[lane]) * static_cast<std::size_t>(sprite.texWidth)
+                    + static_cast<std::size_t>(tx[lane]);
+                std::memcpy(&fetched[lane], sprite.texels + index * 4u, 4);
+            }
+
+            __m128i texelChannels[4];
+            UnpackChannels(_mm_load_si128(reinterpret_cast<const __m128i*>(fetched)), texelChannels);
+
+            __m128 src[4];
+            for (int c = 0; c < 4; ++c)
+                src[c] = _mm_mul_ps(_mm_cvtepi32_ps(texelChannels[c]), inv255);
+            if (sprite.srgb) {
+                const auto* texels = reinterpret_cast<const std::uint8_t*>(fetched);
+                for (int c = 0; c < 3; ++c) {
+                    src[c] = _mm_setr_ps(tables.srgb[texels[c]], tables.srgb[texels[4 + c]],
+                                         tables.srgb[texels[8 + c]], tables.srgb[texels[12 + c]]);
+                }
+            }
+            for (int c = 0; c < 4; ++c)
+                src[c] = _mm_min_ps(_mm_max_ps(_mm_mul_ps(src[c], color[c]), zero), one);
+
+            alignas(16) std::uint8_t target[16] = {};
+            std::memcpy(target, dst, bytes);
+            __m128i dstChannels[4];
+            UnpackChannels(_mm_load_si128(reinterpret_cast<const __m128i*>(target)), dstChannels);
+
+            // SRC_ALPHA / INV_SRC_ALPHA for color, ONE / INV_SRC_ALPHA for alpha
+            const __m128 srcA = src[3];
+            const __m128 invA = _mm_sub_ps(one, srcA);
+            __m128 out[4];
+            for (int c = 0; c < 4; ++c) {
+                const __m128 dstF = _mm_mul_ps(_mm_cvtepi32_ps(dstChannels[c]), inv255);
+                const __m128 srcFactor = c == 3 ? one : srcA;
+                out[c] = _mm_add_ps(_mm_mul_ps(src[c], srcFactor), _mm_mul_ps(dstF, invA));
+            }
+
+            _mm_store_si128(reinterpret_cast<__m128i*>(target), QuantizeChannels(out));
+            std::memcpy(dst, target, bytes);
+        }
+    }
+#endif
+
+} // namespace KibakoEngine
@@ -0,0 +1,123 @@
+// Per-producer sprite command storage and sorted merge
+#include "KibakoEngine/Renderer/SpriteCommandBuffer.h"
+
+#include "KibakoEngine/Core/Profiler.h"
+#include "KibakoEngine/Renderer/Texture2D.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace KibakoEngine {
+
+    void SpriteCommandBuffer::Clear()
+    {
+        m_commands.clear();
+        m_sorted = true;
+    }
+
+    void SpriteCommandBuffer::Reserve(std::size_t count)
+    {
+        m_commands.reserve(count);
+    }
+
+    void SpriteCommandBuffer::Push(const Texture2D& texture,
+        const RectF& dst,
+        const RectF& src,
+        const Color4& color,
+        float rotation,
+        int layer)
+    {
+        const std::uint64_t key = MakeSpriteSortKey(layer, texture.SortId());
+        if (m_sorted && !m_commands.empty() && key < m_commands.back().sortKey)
+            m_sorted = false;
+
+        m_commands.push_back({ &texture, dst, src, color, rotation, layer, key });
+    }
+
+    void SpriteCommandBuffer::Sort()
+    {
+        if (m_sorted)
+            return;
+
+        SpriteCommandMerge::SortByKey(m_commands);
+        m_sorted = true;
+    }
+
+    namespace SpriteCommandMerge
+    {
+        void SortByKey(std::vector<SpriteCommand>& commands)
+        {
+            KBK_PROFILE_SCOPE("SpriteSortByKey");
+
+            const auto byKey = [](const SpriteCommand& a, const SpriteCommand& b) {
+                return a.sortKey < b.sortKey;
+            };
+            if (!std::is_sorted(commands.begin(), commands.end(), byKey))
+                std::stable_sort(commands.begin(), commands.end(), byKey);
+        }
+
+        void MergeSorted(const std::vector<const std::vector<SpriteCommand>*>& runs,
+                         std::vector<SpriteCommand>& out)
+        {
+            KBK_PROFILE_SCOPE("SpriteMergeSorted");
+
+            out.clear();
+
+            std::size_t total = 0;
+            for (const auto* run : runs)
+                total += run ? run->size() : 0;
+            out.reserve(total);
+
+            // Heap of (key, run) heads; the run index breaks ties so output is deterministic
+            struct Head
+            {
+                std::uint64_t key;
+                std::size_t   run;
+                std::size_t   pos;
+            };
+            const auto later = [](const Head& a, const Head& b) {
+                if (a.key != b.key)
+                    return a.key > b.key;
+                return a.run > b.run;
+            };
+
+            std::vector<Head> heap;
+            heap.reserve(runs.size());
+            for (std::size_t i = 0; i < runs.size(); ++i) {
+                if (runs[i] && !runs[i]->empty())
+                    heap.push_back({ (*runs[i])[0].sortKey, i, 0 });
+            }
+            std::make_heap(heap.begin(), heap.end(), later);
+
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                Head& head = heap.back();
+                const std::vector<SpriteCommand>& run = *runs[head.run];
+
+                // Copy the whole stretch that still sorts before the next run's head
+                const std::uint64_t limitKey = heap.size() > 1 ? heap.front().key : UINT64_MAX;
+                const std::size_t limitRun = heap.size() > 1 ? heap.front().run : runs.size();
+                std::size_t end = head.pos;
+                while (end < run.size()) {
+                    const std::uint64_t key = run[end].sortKey;
+                    if (key > limitKey || (key == limitKey && head.run > limitRun))
+                        break;
+                    ++end;
+                }
+                out.insert(out.end(), run.begin() + static_cast<std::ptrdiff_t>(head.pos),
+                           run.begin() + static_cast<std::ptrdiff_t>(end));
+
+                if (end < run.size()) {
+                    head.pos = end;
+                    head.key = run[end].sortKey;
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+                else {
+                    heap.pop_back();
+                }
+            }
+        }
+    }
+
+} // namespace KibakoEngine
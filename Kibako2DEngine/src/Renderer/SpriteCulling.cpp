@@ -0,0 +1,392 @@
+// Sprite view culling
+#include "KibakoEngine/Renderer/SpriteCulling.h"
+
+#include "KibakoEngine/Core/Debug.h"
+#include "KibakoEngine/Core/Profiler.h"
+#include "KibakoEngine/Renderer/Camera2D.h"
+
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX;
+
+namespace KibakoEngine {
+
+    namespace
+    {
+        constexpr int kMaxGridCellsPerAxis = 1024;
+
+        // View constants splatted across the 4 SIMD lanes
+        struct CullLanes
+        {
+            XMVECTOR centerX;
+            XMVECTOR centerY;
+            XMVECTOR boundsHalfW;
+            XMVECTOR boundsHalfH;
+            XMVECTOR axisX;
+            XMVECTOR axisY;
+            XMVECTOR negAxisY;
+            XMVECTOR absAxisX;
+            XMVECTOR absAxisY;
+            XMVECTOR halfWidth;
+            XMVECTOR halfHeight;
+        };
+
+        CullLanes MakeLanes(const CullView2D& view)
+        {
+            CullLanes lanes{};
+            lanes.centerX = XMVectorReplicate(view.centerX);
+            lanes.centerY = XMVectorReplicate(view.centerY);
+            lanes.boundsHalfW = XMVectorReplicate(view.boundsHalfW);
+            lanes.boundsHalfH = XMVectorReplicate(view.boundsHalfH);
+            lanes.axisX = XMVectorReplicate(view.axisX);
+            lanes.axisY = XMVectorReplicate(view.axisY);
+            lanes.negAxisY = XMVectorReplicate(-view.axisY);
+            lanes.absAxisX = XMVectorReplicate(std::fabs(view.axisX));
+            lanes.absAxisY = XMVectorReplicate(std::fabs(view.axisY));
+            lanes.halfWidth = XMVectorReplicate(view.halfWidth);
+            lanes.halfHeight = XMVectorReplicate(view.halfHeight);
+            return lanes;
+        }
+
+        // Separating axis test of 4 sprite AABBs against the oriented view:
+        // world X/Y axes first, then the two camera axes
+        XMVECTOR TestLanes(const CullLanes& lanes, FXMVECTOR cx, FXMVECTOR cy, FXMVECTOR hw, GXMVECTOR hh)
+        {
+            const XMVECTOR dx = XMVectorSubtract(cx, lanes.centerX);
+            const XMVECTOR dy = XMVectorSubtract(cy, lanes.centerY);
+
+            XMVECTOR inside = XMVectorLessOrEqual(XMVectorAbs(dx), XMVectorAdd(hw, lanes.boundsHalfW));
+            inside = XMVectorAndInt(inside, XMVectorLessOrEqual(XMVectorAbs(dy), XMVectorAdd(hh, lanes.boundsHalfH)));
+
+            const XMVECTOR du = XMVectorMultiplyAdd(dx, lanes.axisX, XMVectorMultiply(dy, lanes.axisY));
+            const XMVECTOR ru = XMVectorMultiplyAdd(hw, lanes.absAxisX, XMVectorMultiplyAdd(hh, lanes.absAxisY, lanes.halfWidth));
+            inside = XMVectorAndInt(inside, XMVectorLessOrEqual(XMVectorAbs(du), ru));
+
+            const XMVECTOR dv = XMVectorMultiplyAdd(dx, lanes.negAxisY, XMVectorMultiply(dy, lanes.axisX));
+            const XMVECTOR rv = XMVectorMultiplyAdd(hw, lanes.absAxisY, XMVectorMultiplyAdd(hh, lanes.absAxisX, lanes.halfHeight));
+            inside = XMVectorAndInt(inside, XMVectorLessOrEqual(XMVectorAbs(dv), rv));
+
+            return inside;
+        }
+
+        XMVECTOR LoadLanes(const float* values)
+        {
+            return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(values));
+        }
+
+        void AppendMask(FXMVECTOR inside, std::uint32_t base, std::vector<std::uint32_t>& out)
+        {
+            if (XMVector4EqualInt(inside, XMVectorFalseInt()))
+                return;
+
+            std::uint32_t mask[4];
+            XMStoreInt4(mask, inside);
+            for (std::uint32_t lane = 0; lane < 4; ++lane) {
+                if (mask[lane] != 0u)
+                    out.push_back(base + lane);
+            }
+        }
+    } // namespace
+
+    CullView2D CullView2D::FromCamera(const Camera2D& camera, float margin)
+    {
+        const XMFLOAT2 size = camera.GetViewportSize();
+        const XMFLOAT2 center = camera.ScreenToWorld(size.x * 0.5f, size.y * 0.5f);
+        const float rotation = camera.GetRotation();
+
+        CullView2D view{};
+        view.centerX = center.x;
+        view.centerY = center.y;
+        view.axisX = std::cos(rotation);
+        view.axisY = std::sin(rotation);
+        view.halfWidth = size.x * 0.5f + margin;
+        view.halfHeight = size.y * 0.5f + margin;
+
+        const float absX = std::fabs(view.axisX);
+        const float absY = std::fabs(view.axisY);
+        view.boundsHalfW = view.halfWidth * absX + view.halfHeight * absY;
+        view.boundsHalfH = view.halfWidth * absY + view.halfHeight * absX;
+        return view;
+    }
+
+    CullView2D CullView2D::FromRect(const RectF& rect)
+    {
+        CullView2D view{};
+        view.halfWidth = rect.w * 0.5f;
+        view.halfHeight = rect.h * 0.5f;
+        view.centerX = rect.x + view.halfWidth;
+        view.centerY = rect.y + view.halfHeight;
+        view.boundsHalfW = view.halfWidth;
+        view.boundsHalfH = view.halfHeight;
+        return view;
+    }
+
+    RectF CullView2D::Bounds() const
+    {
+        return RectF::FromXYWH(centerX - boundsHalfW, centerY - boundsHalfH, boundsHalfW * 2.0f, boundsHalfH * 2.0f);
+    }
+
+    void SpriteBounds2D::Clear()
+    {
+        m_centerX.clear();
+        m_centerY.clear();
+        m_halfW.clear();
+        m_halfH.clear();
+        m_count = 0;
+    }
+
+    void SpriteBounds2D::Reserve(std::size_t count)
+    {
+        m_centerX.reserve(count);
+        m_centerY.reserve(count);
+        m_halfW.reserve(count);
+        m_halfH.reserve(count);
+    }
+
+    std::uint32_t SpriteBounds2D::Add(const RectF& dst, float rotation)
+    {
+        const float hw = dst.w * 0.5f;
+        const float hh = dst.h * 0.5f;
+        const float cx = dst.x + hw;
+        const float cy = dst.y + hh;
+
+        if (std::fabs(rotation) <= 0.0001f)
+            return Add(cx, cy, std::fabs(hw), std::fabs(hh));
+
+        const float cs = std::fabs(std::cos(rotation));
+        const float sn = std::fabs(std::sin(rotation));
+        const float ahw = std::fabs(hw);
+        const float ahh = std::fabs(hh);
+        return Add(cx, cy, ahw * cs + ahh * sn, ahw * sn + ahh * cs);
+    }
+
+    std::uint32_t SpriteBounds2D::Add(float centerX, float centerY, float halfW, float halfH)
+    {
+        m_centerX.push_back(centerX);
+        m_centerY.push_back(centerY);
+        m_halfW.push_back(halfW);
+        m_halfH.push_back(halfH);
+        return static_cast<std::uint32_t>(m_count++);
+    }
+
+    namespace SpriteCulling
+    {
+        bool IsVisible(const CullView2D& view, float centerX, float centerY, float halfW, float halfH)
+        {
+            const float dx = centerX - view.centerX;
+            const float dy = centerY - view.centerY;
+            if (std::fabs(dx) > halfW + view.boundsHalfW || std::fabs(dy) > halfH + view.boundsHalfH)
+                return false;
+
+            const float absX = std::fabs(view.axisX);
+            const float absY = std::fabs(view.axisY);
+
+            const float du = dx * view.axisX + dy * view.axisY;
+            if (std::fabs(du) > halfW * absX + (halfH * absY + view.halfWidth))
+                return false;
+
+            const float dv = dy * view.axisX - dx * view.axisY;
+            return std::fabs(dv) <= halfW * absY + (halfH * absX + view.halfHeight);
+        }
+
+        std::size_t CullVisible(const CullView2D& view,
+                                const SpriteBounds2D& bounds,
+                                std::vector<std::uint32_t>& outVisible)
+        {
+            KBK_PROFILE_SCOPE("CullSprites");
+
+            const std::size_t before = outVisible.size();
+            const std::size_t count = bounds.Size();
+            const std::size_t simdCount = count & ~static_cast<std::size_t>(3);
+
+            const float* cx = bounds.CenterX();
+            const float* cy = bounds.CenterY();
+            const float* hw = bounds.HalfW();
+            const float* hh = bounds.HalfH();
+
+            const CullLanes lanes = MakeLanes(view);
+
+            for (std::size_t i = 0; i < simdCount; i += 4) {
+                const XMVECTOR inside = TestLanes(lanes,
+                    LoadLanes(cx + i),
+                    LoadLanes(cy + i),
+                    LoadLanes(hw + i),
+                    LoadLanes(hh + i));
+                AppendMask(inside, static_cast<std::uint32_t>(i), outVisible);
+            }
+
+            for (std::size_t i = simdCount; i < count; ++i) {
+                if (IsVisible(view, cx[i], cy[i], hw[i], hh[i]))
+                    outVisible.push_back(static_cast<std::uint32_t>(i));
+            }
+
+            return outVisible.size() - before;
+        }
+    } // namespace SpriteCulling
+
+    void SpriteCullGrid2D::Clear()
+    {
+        m_cellStart.clear();
+        m_items.clear();
+        m_candidates.clear();
+        m_cellsX = 0;
+        m_cellsY = 0;
+        m_maxHalfW = 0.0f;
+        m_maxHalfH = 0.0f;
+    }
+
+    int SpriteCullGrid2D::CellX(float x) const
+    {
+        const int cell = static_cast<int>(std::floor((x - m_originX) * m_invCellSize));
+        return std::clamp(cell, 0, m_cellsX - 1);
+    }
+
+    int SpriteCullGrid2D::CellY(float y) const
+    {
+        const int cell = static_cast<int>(std::floor((y - m_originY) * m_invCellSize));
+        return std::clamp(cell, 0, m_cellsY - 1);
+    }
+
+    void SpriteCullGrid2D::Build(const SpriteBounds2D& bounds, float cellSize)
+    {
+        KBK_PROFILE_SCOPE("CullGridBuild");
+
+        Clear();
+
+        const std::size_t count = bounds.Size();
+        if (count == 0)
+            return;
+
+        KBK_ASSERT(cellSize > 0.0f, "SpriteCullGrid2D::Build requires a positive cell size");
+        if (cellSize <= 0.0f)
+            cellSize = 1.0f;
+
+        const float* cx = bounds.CenterX();
+        const float* cy = bounds.CenterY();
+        const float* hw = bounds.HalfW();
+        const float* hh = bounds.HalfH();
+
+        float minX = cx[0];
+        float minY = cy[0];
+        float maxX = cx[0];
+        float maxY = cy[0];
+        for (std::size_t i = 0; i < count; ++i) {
+            minX = std::min(minX, cx[i]);
+            minY = std::min(minY, cy[i]);
+            maxX = std::max(maxX, cx[i]);
+            maxY = std::max(maxY, cy[i]);
+            m_maxHalfW = std::max(m_maxHalfW, hw[i]);
+            m_maxHalfH = std::max(m_maxHalfH, hh[i]);
+        }
+
+        // Keep the cell count bounded for very sparse worlds
+        const float extent = std::max(maxX - minX, maxY - minY);
+        cellSize = std::max(cellSize, extent / static_cast<float>(kMaxGridCellsPerAxis));
+
+        m_originX = minX;
+        m_originY = minY;
+        m_invCellSize = 1.0f / cellSize;
+        m_cellsX = std::min(kMaxGridCellsPerAxis, static_cast<int>((maxX - minX) * m_invCellSize) + 1);
+        m_cellsY = std::min(kMaxGridCellsPerAxis, static_cast<int>((maxY - minY) * m_invCellSize) + 1);
+
+        const std::size_t cellCount = static_cast<std::size_t>(m_cellsX) * static_cast<std::size_t>(m_cellsY);
+        m_cellStart.assign(cellCount + 1, 0u);
+
+        // Counting sort of sprite indices by cell keeps each cell in ascending order
+        std::vector<std::uint32_t> cellOf(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t cell = static_cast<std::size_t>(CellY(cy[i])) * static_cast<std::size_t>(m_cellsX) +
+                static_cast<std::size_t>(CellX(cx[i]));
+            cellOf[i] = static_cast<std::uint32_t>(cell);
+            ++m_cellStart[cell + 1];
+        }
+
+        for (std::size_t cell = 0; cell < cellCount; ++cell)
+            m_cellStart[cell + 1] += m_cellStart[cell];
+
+        m_items.resize(count);
+        std::vector<std::uint32_t> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+        for (std::size_t i = 0; i < count; ++i)
+            m_items[cursor[cellOf[i]]++] = static_cast<std::uint32_t>(i);
+    }
+
+    std::size_t SpriteCullGrid2D::Query(const CullView2D& view,
+                                        const SpriteBounds2D& bounds,
+                                        std::vector<std::uint32_t>& outVisible) const
+    {
+        KBK_PROFILE_SCOPE("CullGridQuery");
+
+        const std::size_t before = outVisible.size();
+        if (m_cellStart.empty())
+            return 0;
+
+        // Items are binned by center, so widen the query by the largest extent
+        const float reachX = view.boundsHalfW + m_maxHalfW;
+        const float reachY = view.boundsHalfH + m_maxHalfH;
+        const float queryMinX = view.centerX - reachX;
+        const float queryMaxX = view.centerX + reachX;
+        const float queryMinY = view.centerY - reachY;
+        const float queryMaxY = view.centerY + reachY;
+
+        const float gridMaxX = m_originX + static_cast<float>(m_cellsX) / m_invCellSize;
+        const float gridMaxY = m_originY + static_cast<float>(m_cellsY) / m_invCellSize;
+        if (queryMaxX < m_originX || queryMaxY < m_originY || queryMinX > gridMaxX || queryMinY > gridMaxY)
+            return 0;
+
+        const int x0 = CellX(queryMinX);
+        const int x1 = CellX(queryMaxX);
+        const int y0 = CellY(queryMinY);
+        const int y1 = CellY(queryMaxY);
+
+        m_candidates.clear();
+        for (int y = y0; y <= y1; ++y) {
+            const std::size_t row = static_cast<std::size_t>(y) * static_cast<std::size_t>(m_cellsX);
+            const std::uint32_t first = m_cellStart[row + static_cast<std::size_t>(x0)];
+            const std::uint32_t last = m_cellStart[row + static_cast<std::size_t>(x1) + 1];
+            m_candidates.insert(m_candidates.end(), m_items.begin() + first, m_items.begin() + last);
+        }
+
+        // Preserve submission order for the sprite batch
+        std::sort(m_candidates.begin(), m_candidates.end());
+
+        const float* cx = bounds.CenterX();
+        const float* cy = bounds.CenterY();
+        const float* hw = bounds.HalfW();
+        const float* hh = bounds.HalfH();
+
+        const CullLanes lanes = MakeLanes(view);
+        const std::size_t count = m_candidates.size();
+        const std::size_t simdCount = count & ~static_cast<std::size_t>(3);
+
+        for (std::size_t i = 0; i < simdCount; i += 4) {
+            const std::uint32_t* idx = m_candidates.data() + i;
+            const XMVECTOR inside = TestLanes(lanes,
+                XMVectorSet(cx[idx[0]], cx[idx[1]], cx[idx[2]], cx[idx[3]]),
+                XMVectorSet(cy[idx[0]], cy[idx[1]], cy[idx[2]], cy[idx[3]]),
+                XMVectorSet(hw[idx[0]], hw[idx[1]], hw[idx[2]], hw[idx[3]]),
+                XMVectorSet(hh[idx[0]], hh[idx[1]], hh[idx[2]], hh[idx[3]]));
+
+            if (XMVector4EqualInt(inside, XMVectorFalseInt()))
+                continue;
+
+            std::uint32_t mask[4];
+            XMStoreInt4(mask, inside);
+            for (std::size_t lane = 0; lane < 4; ++lane) {
+                if (mask[lane] != 0u)
+                    outVisible.push_back(idx[lane]);
+            }
+        }
+
+        for (std::size_t i = simdCount; i < count; ++i) {
+            const std::uint32_t index = m_candidates[i];
+            if (SpriteCulling::IsVisible(view, cx[index], cy[index], hw[index], hh[index]))
+                outVisible.push_back(index);
+        }
+
+        return outVisible.size() - before;
+    }
+
+} // namespace KibakoEngine
@@ -1,11 +1,20 @@
-// Direct3D 11 texture loading
+// Texture loading (Direct3D 11 or CPU-only)
 #include "KibakoEngine/Renderer/Texture2D.h"
 
 #include "KibakoEngine/Core/Debug.h"
 #include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/MemoryTracker.h"
 #include "KibakoEngine/Core/Profiler.h"
 
+#if defined(_WIN32)
+#    include <d3d11.h>
+#endif
+
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <cstring>
+#include <utility>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -15,65 +24,128 @@ namespace KibakoEngine {
     namespace
     {
         constexpr const char* kLogChannel = "Texture";
+
+        std::uint32_t NextSortId()
+        {
+            static std::atomic<std::uint32_t> s_nextId{ 1 };
+            return s_nextId.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
-    void Texture2D::Reset()
+    Texture2D::~Texture2D()
     {
-        m_srv.Reset();
-        m_texture.Reset();
-        m_width = 0;
-        m_height = 0;
+        Reset();
     }
 
-    bool Texture2D::CreateSolidColor(ID3D11Device* device,
-        std::uint8_t r,
-        std::uint8_t g,
-        std::uint8_t b,
-        std::uint8_t a)
+    Texture2D::Texture2D(Texture2D&& other) noexcept
     {
-        KBK_PROFILE_SCOPE("TextureCreateSolidColor");
+        *this = std::move(other);
+    }
+
+    Texture2D& Texture2D::operator=(Texture2D&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
 
-        KBK_ASSERT(device != nullptr, "Texture2D::CreateSolidColor requires a valid device");
         Reset();
+        m_texture = std::exchange(other.m_texture, nullptr);
+        m_srv = std::exchange(other.m_srv, nullptr);
+        m_pixels = std::move(other.m_pixels);
+        m_sortId = std::exchange(other.m_sortId, 0u);
+        m_width = std::exchange(other.m_width, 0);
+        m_height = std::exchange(other.m_height, 0);
+        m_srgb = std::exchange(other.m_srgb, false);
+        return *this;
+    }
+
+    void Texture2D::Reset()
+    {
+#if defined(_WIN32)
+        if (m_srv)
+            m_srv->Release();
+        if (m_texture)
+            m_texture->Release();
+#endif
+        m_srv = nullptr;
+        m_texture = nullptr;
+        m_pixels.clear();
+        m_pixels.shrink_to_fit();
+        m_sortId = 0;
+        m_width = 0;
+        m_height = 0;
+        m_srgb = false;
+    }
 
-        const std::uint32_t color = (static_cast<std::uint32_t>(a) << 24u) |
-            (static_cast<std::uint32_t>(b) << 16u) |
-            (static_cast<std::uint32_t>(g) << 8u) |
-            static_cast<std::uint32_t>(r);
+    bool Texture2D::Upload(ID3D11Device* device, int width, int height, const std::uint8_t* pixels, bool srgb)
+    {
+        KBK_MEMORY_TAG(Texture);
+        if (!device) {
+            const size_t byteCount = static_cast<size_t>(width) * static_cast<size_t>(height) * 4u;
+            m_pixels.resize(byteCount);
+            std::memcpy(m_pixels.data(), pixels, byteCount);
+
+            m_sortId = NextSortId();
+            m_width = width;
+            m_height = height;
+            m_srgb = srgb;
+            return true;
+        }
 
+#if defined(_WIN32)
         D3D11_TEXTURE2D_DESC desc{};
-        desc.Width = 1;
-        desc.Height = 1;
+        desc.Width = static_cast<UINT>(width);
+        desc.Height = static_cast<UINT>(height);
         desc.MipLevels = 1;
         desc.ArraySize = 1;
-        desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        desc.Format = srgb ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
         desc.SampleDesc.Count = 1;
         desc.Usage = D3D11_USAGE_IMMUTABLE;
         desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
 
         D3D11_SUBRESOURCE_DATA data{};
-        data.pSysMem = &color;
-        data.SysMemPitch = sizeof(color);
+        data.pSysMem = pixels;
+        data.SysMemPitch = static_cast<UINT>(width * 4);
 
-        Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
-        HRESULT hr = device->CreateTexture2D(&desc, &data, texture.GetAddressOf());
+        ID3D11Texture2D* texture = nullptr;
+        HRESULT hr = device->CreateTexture2D(&desc, &data, &texture);
         if (FAILED(hr)) {
-            KbkError(kLogChannel, "CreateTexture2D (solid) failed: 0x%08X", static_cast<unsigned>(hr));
+            KbkError(kLogChannel, "CreateTexture2D failed: 0x%08X", static_cast<unsigned>(hr));
             return false;
         }
 
-        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
-        hr = device->CreateShaderResourceView(texture.Get(), nullptr, srv.GetAddressOf());
+        ID3D11ShaderResourceView* srv = nullptr;
+        hr = device->CreateShaderResourceView(texture, nullptr, &srv);
         if (FAILED(hr)) {
-            KbkError(kLogChannel, "CreateShaderResourceView (solid) failed: 0x%08X", static_cast<unsigned>(hr));
+            KbkError(kLogChannel, "CreateShaderResourceView failed: 0x%08X", static_cast<unsigned>(hr));
+            texture->Release();
             return false;
         }
 
         m_texture = texture;
         m_srv = srv;
-        m_width = 1;
-        m_height = 1;
+        m_sortId = NextSortId();
+        m_width = width;
+        m_height = height;
+        m_srgb = srgb;
         return true;
+#else
+        KbkError(kLogChannel, "Direct3D 11 textures are not available on this platform");
+        return false;
+#endif
+    }
+
+    bool Texture2D::CreateSolidColor(ID3D11Device* device,
+        std::uint8_t r,
+        std::uint8_t g,
+        std::uint8_t b,
+        std::uint8_t a)
+    {
+        KBK_PROFILE_SCOPE("TextureCreateSolidColor");
+
+        Reset();
+
+        const std::uint8_t color[4] = { r, g, b, a };
+        return Upload(device, 1, 1, color, false);
     }
 
     bool Texture2D::CreateFromRGBA8(ID3D11Device* device,
@@ -83,53 +155,25 @@ namespace KibakoEngine {
     {
         KBK_PROFILE_SCOPE("TextureCreateFromMemory");
 
-        KBK_ASSERT(device != nullptr, "Texture2D::CreateFromRGBA8 requires a valid device");
         KBK_ASSERT(pixels != nullptr, "Texture2D::CreateFromRGBA8 requires pixel data");
+        KBK_ASSERT(width > 0 && height > 0, "Texture2D::CreateFromRGBA8 requires positive size");
 
         Reset();
 
-        D3D11_TEXTURE2D_DESC desc{};
-        desc.Width = static_cast<UINT>(width);
-        desc.Height = static_cast<UINT>(height);
-        desc.MipLevels = 1;
-        desc.ArraySize = 1;
-        desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-        desc.SampleDesc.Count = 1;
-        desc.Usage = D3D11_USAGE_IMMUTABLE;
-        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-
-        D3D11_SUBRESOURCE_DATA data{};
-        data.pSysMem = pixels;
-        data.SysMemPitch = static_cast<UINT>(width * 4);
-
-        Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
-        HRESULT hr = device->CreateTexture2D(&desc, &data, texture.GetAddressOf());
-        if (FAILED(hr)) {
-            KbkError(kLogChannel, "CreateTexture2D (memory) failed: 0x%08X", static_cast<unsigned>(hr));
-            return false;
-        }
-
-        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
-        hr = device->CreateShaderResourceView(texture.Get(), nullptr, srv.GetAddressOf());
-        if (FAILED(hr)) {
-            KbkError(kLogChannel, "CreateShaderResourceView (memory) failed: 0x%08X", static_cast<unsigned>(hr));
+        if (!pixels || width <= 0 || height <= 0)
             return false;
-        }
 
-        m_texture = texture;
-        m_srv = srv;
-        m_width = width;
-        m_height = height;
-        return true;
+        return Upload(device, width, height, pixels, false);
     }
 
     bool Texture2D::LoadFromFile(ID3D11Device* device, const std::string& path, bool srgb)
     {
         KBK_PROFILE_SCOPE("TextureLoad");
+        KBK_MEMORY_TAG(Texture);
 
-        KBK_ASSERT(device != nullptr, "Texture2D::LoadFromFile requires a valid device");
         Reset();
 
+        const auto start = std::chrono::steady_clock::now();
         stbi_set_flip_vertically_on_load(false);
         int width = 0;
         int height = 0;
@@ -140,44 +184,15 @@ namespace KibakoEngine {
             return false;
         }
 
-        const DXGI_FORMAT format = srgb ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
-
-        D3D11_TEXTURE2D_DESC desc{};
-        desc.Width = static_cast<UINT>(width);
-        desc.Height = static_cast<UINT>(height);
-        desc.MipLevels = 1;
-        desc.ArraySize = 1;
-        desc.Format = format;
-        desc.SampleDesc.Count = 1;
-        desc.Usage = D3D11_USAGE_IMMUTABLE;
-        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-
-        D3D11_SUBRESOURCE_DATA data{};
-        data.pSysMem = pixels;
-        data.SysMemPitch = static_cast<UINT>(width * 4);
-
-        Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
-        HRESULT hr = device->CreateTexture2D(&desc, &data, texture.GetAddressOf());
+        const bool uploaded = Upload(device, width, height, pixels, srgb);
         stbi_image_free(pixels);
-        if (FAILED(hr)) {
-            KbkError(kLogChannel, "CreateTexture2D failed: 0x%08X", static_cast<unsigned>(hr));
-            return false;
-        }
-
-        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
-        hr = device->CreateShaderResourceView(texture.Get(), nullptr, srv.GetAddressOf());
-        if (FAILED(hr)) {
-            KbkError(kLogChannel, "CreateShaderResourceView failed: 0x%08X", static_cast<unsigned>(hr));
+        if (!uploaded)
             return false;
-        }
 
-        m_texture = texture;
-        m_srv = srv;
-        m_width = width;
-        m_height = height;
-        KbkLog(kLogChannel, "Loaded %s (%dx%d)", path.c_str(), m_width, m_height);
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        KbkLogFields(kLogChannel, "Texture loaded", { "texture", path }, { "width", m_width }, { "height", m_height },
+            { "cpu_only", device == nullptr }, { "duration_ms", elapsed.count() });
         return true;
     }
 
 } // namespace KibakoEngine
-
@@ -3,6 +3,7 @@
 
 #include "KibakoEngine/Core/Debug.h"
 #include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/MemoryTracker.h"
 
 namespace KibakoEngine {
 
@@ -13,7 +14,7 @@ namespace KibakoEngine {
 
     void AssetManager::Init(ID3D11Device* device)
     {
-        KBK_ASSERT(device != nullptr, "AssetManager::Init called with null device");
+        // A null device (headless) loads CPU-only textures
         m_device = device;
 
         if (!m_fontLibrary.IsValid() && !m_fontLibrary.Init()) {
@@ -39,13 +40,7 @@ namespace KibakoEngine {
         const std::string& path,
         bool sRGB)
     {
-        if (!m_device) {
-            KbkError(kLogChannel,
-                "Cannot load texture '%s' (id='%s'): device is null",
-                path.c_str(), id.c_str());
-            return nullptr;
-        }
-
+        KBK_MEMORY_TAG(Assets);
         auto it = m_textures.find(id);
         if (it != m_textures.end()) {
             KbkTrace(kLogChannel,
@@ -76,13 +71,7 @@ namespace KibakoEngine {
         const std::string& path,
         int pixelHeight)
     {
-        if (!m_device) {
-            KbkError(kLogChannel,
-                "Cannot load font '%s' (id='%s'): device is null",
-                path.c_str(), id.c_str());
-            return nullptr;
-        }
-
+        KBK_MEMORY_TAG(Assets);
         if (!m_fontLibrary.IsValid()) {
             KbkError(kLogChannel,
                 "Cannot load font '%s' (id='%s'): font library unavailable",
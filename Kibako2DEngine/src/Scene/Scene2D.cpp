@@ -1,8 +1,13 @@
 // 2D scene storage and rendering
 #include "KibakoEngine/Scene/Scene2D.h"
 
+#include "KibakoEngine/Core/BinaryLog.h"
 #include "KibakoEngine/Core/Debug.h"
 #include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/MemoryTracker.h"
+#include "KibakoEngine/Core/PerfCounters.h"
+#include "KibakoEngine/Core/Profiler.h"
+#include "KibakoEngine/Renderer/Camera2D.h"
 #include "KibakoEngine/Renderer/SpriteBatch2D.h"
 
 #include <algorithm>
@@ -20,15 +25,59 @@ namespace KibakoEngine {
                 return entity.id == id;
             });
         }
+
+        // World-space destination rect; false when the entity draws nothing
+        bool ComputeSpriteRect(const Entity2D& entity, RectF& dst)
+        {
+            if (!entity.active)
+                return false;
+
+            const Texture2D* texture = entity.sprite.texture;
+            if (!texture || !texture->IsValid())
+                return false;
+
+            const RectF& local = entity.sprite.dst;
+            const Transform2D& transform = entity.transform;
+
+            // Scale sprite size
+            const float scaledWidth = local.w * transform.scale.x;
+            const float scaledHeight = local.h * transform.scale.y;
+
+            // Apply local offsets
+            const float offsetX = local.x * transform.scale.x;
+            const float offsetY = local.y * transform.scale.y;
+
+            const float worldCenterX = transform.position.x + offsetX;
+            const float worldCenterY = transform.position.y + offsetY;
+
+            dst.w = scaledWidth;
+            dst.h = scaledHeight;
+            dst.x = worldCenterX - (scaledWidth * 0.5f);
+            dst.y = worldCenterY - (scaledHeight * 0.5f);
+            return true;
+        }
+
+        void PushEntity(SpriteBatch2D& batch, const Entity2D& entity, const RectF& dst)
+        {
+            batch.Push(
+                *entity.sprite.texture,
+                dst,
+                entity.sprite.src,
+                entity.sprite.color,
+                entity.transform.rotation,
+                entity.sprite.layer);
+        }
     }
 
     Entity2D& Scene2D::CreateEntity()
     {
+        KBK_MEMORY_TAG(Scene);
         Entity2D& entity = m_entities.emplace_back();
         entity.id = m_nextID++;
         entity.active = true;
 
-        KbkTrace(kLogChannel, "Created Entity2D id=%u", entity.id);
+        // Per entity, so deferred: raw ids into the binary log when one is open
+        KbkTraceDeferred(kLogChannel, "Created Entity2D id=%u", entity.id);
 
         return entity;
     }
@@ -40,7 +89,7 @@ namespace KibakoEngine {
             return;
 
         it->active = false;
-        KbkTrace(kLogChannel, "Destroyed Entity2D id=%u (marked inactive)", id);
+        KbkTraceDeferred(kLogChannel, "Destroyed Entity2D id=%u (marked inactive)", id);
     }
 
     void Scene2D::Clear()
@@ -64,48 +113,65 @@ namespace KibakoEngine {
 
     void Scene2D::Update(float dt)
     {
+        KBK_MEMORY_TAG(Scene);
         KBK_UNUSED(dt);
         // Gameplay runs elsewhere
     }
 
     void Scene2D::Render(SpriteBatch2D& batch) const
     {
-        for (const auto& entity : m_entities) {
-            if (!entity.active)
-                continue;
+        KBK_PROFILE_SCOPE("SceneRender");
+        KBK_MEMORY_TAG(Scene);
 
-            const Texture2D* texture = entity.sprite.texture;
-            if (!texture || !texture->IsValid())
+        std::uint32_t visible = 0;
+        for (const auto& entity : m_entities) {
+            RectF dst{};
+            if (!ComputeSpriteRect(entity, dst))
                 continue;
 
-            const RectF& local = entity.sprite.dst;
-            const Transform2D& transform = entity.transform;
+            PushEntity(batch, entity, dst);
+            ++visible;
+        }
 
-            // Scale sprite size
-            const float scaledWidth = local.w * transform.scale.x;
-            const float scaledHeight = local.h * transform.scale.y;
+        m_renderStats = { visible, 0 };
+        KBK_PERF_COUNT("scene.spritesVisible", visible);
+    }
 
-            // Apply local offsets
-            const float offsetX = local.x * transform.scale.x;
-            const float offsetY = local.y * transform.scale.y;
+    void Scene2D::Render(SpriteBatch2D& batch, const Camera2D& camera) const
+    {
+        KBK_PROFILE_SCOPE("SceneRenderCulled");
+        KBK_MEMORY_TAG(Scene);
 
-            const float worldCenterX = transform.position.x + offsetX;
-            const float worldCenterY = transform.position.y + offsetY;
+        m_cullBounds.Clear();
+        m_cullEntities.clear();
+        m_visible.clear();
+        m_cullBounds.Reserve(m_entities.size());
+        m_cullEntities.reserve(m_entities.size());
 
+        for (std::size_t i = 0; i < m_entities.size(); ++i) {
             RectF dst{};
-            dst.w = scaledWidth;
-            dst.h = scaledHeight;
-            dst.x = worldCenterX - (scaledWidth * 0.5f);
-            dst.y = worldCenterY - (scaledHeight * 0.5f);
+            if (!ComputeSpriteRect(m_entities[i], dst))
+                continue;
 
-            batch.Push(
-                *texture,
-                dst,
-                entity.sprite.src,
-                entity.sprite.color,
-                transform.rotation,
-                entity.sprite.layer);
+            m_cullBounds.Add(dst, m_entities[i].transform.rotation);
+            m_cullEntities.push_back(static_cast<std::uint32_t>(i));
+        }
+
+        const CullView2D view = CullView2D::FromCamera(camera);
+        SpriteCulling::CullVisible(view, m_cullBounds, m_visible);
+
+        for (const std::uint32_t slot : m_visible) {
+            const Entity2D& entity = m_entities[m_cullEntities[slot]];
+            RectF dst{};
+            ComputeSpriteRect(entity, dst);
+            PushEntity(batch, entity, dst);
         }
+
+        const auto candidates = static_cast<std::uint32_t>(m_cullEntities.size());
+        const auto visible = static_cast<std::uint32_t>(m_visible.size());
+        m_renderStats = { visible, candidates - visible };
+        KBK_PERF_COUNT("scene.spritesVisible", visible);
+        KBK_PERF_COUNT("scene.spritesCulled", candidates - visible);
     }
 
 } // namespace KibakoEngine
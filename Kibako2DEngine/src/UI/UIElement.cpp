@@ -1,6 +1,8 @@
 // UI containers and screen management
 #include "KibakoEngine/UI/UIElement.h"
 
+#include "KibakoEngine/Core/MemoryTracker.h"
+#include "KibakoEngine/Core/PerfCounters.h"
 #include "KibakoEngine/Renderer/SpriteBatch2D.h"
 
 namespace
@@ -74,6 +76,7 @@ namespace KibakoEngine {
         m_cachedWorldRect = RectF::FromXYWH(pos.x, pos.y, m_size.x, m_size.y);
         m_cachedScreenSize = ctx.screenSize;
         m_layoutDirty = false;
+        KBK_PERF_COUNT("ui.layoutPasses", 1);
     }
 
     const DirectX::XMFLOAT2& UIElement::WorldPosition(const UIContext& ctx) const
@@ -114,6 +117,7 @@ namespace KibakoEngine {
 
     void UIElement::AddChild(std::unique_ptr<UIElement> child)
     {
+        KBK_MEMORY_TAG(UI);
         if (!child)
             return;
 
@@ -148,12 +152,14 @@ namespace KibakoEngine {
 
     void UISystem::PushScreen(std::unique_ptr<UIScreen> screen)
     {
+        KBK_MEMORY_TAG(UI);
         if (screen)
             m_screens.push_back(std::move(screen));
     }
 
     UIScreen& UISystem::CreateScreen(const std::string& name)
     {
+        KBK_MEMORY_TAG(UI);
         auto screen = std::make_unique<UIScreen>(name);
         UIScreen& ref = *screen;
         m_screens.push_back(std::move(screen));
@@ -173,6 +179,7 @@ namespace KibakoEngine {
 
     void UISystem::Update(float dt)
     {
+        KBK_MEMORY_TAG(UI);
         m_lastDeltaTime = dt;
 
         const UIContext ctx{ m_screenSize, m_input, dt };
@@ -182,6 +189,7 @@ namespace KibakoEngine {
 
     void UISystem::Render(SpriteBatch2D& batch) const
     {
+        KBK_MEMORY_TAG(UI);
         const UIContext ctx{ m_screenSize, m_input, m_lastDeltaTime };
         for (const auto& screen : m_screens)
             screen->OnRender(batch, ctx, m_style);
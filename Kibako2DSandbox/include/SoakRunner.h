@@ -0,0 +1,24 @@
+// Headless soak runs: scripted scenarios checked against time and memory budgets
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct SoakOptions
+{
+    std::vector<std::string> scenarios;        // Empty runs every scenario
+    std::uint64_t            frames = 1800;    // Measured frames per scenario
+    std::uint64_t            warmupFrames = 120; // Run first and left out of the statistics
+    double                   fixedStep = 1.0 / 60.0;
+    double                   budgetScale = 1.0; // Multiplies every time budget, for slower machines
+    std::string              reportPath;       // One JSON line per scenario
+};
+
+// "all" or a comma separated list of scenario names
+bool ParseSoakScenarios(const std::string& list, std::vector<std::string>& out);
+
+// Each scenario boots its own headless application with a fixed time step.
+// Returns the process exit code: 0 when every budget holds, 1 when one is
+// exceeded, 2 when a scenario could not run.
+int RunSoak(const SoakOptions& options);
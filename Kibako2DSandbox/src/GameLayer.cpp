@@ -5,6 +5,7 @@
 #include "KibakoEngine/Core/Debug.h"
 #include "KibakoEngine/Core/DebugUI.h"
 #include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/MemoryTracker.h"
 #include "KibakoEngine/Core/Profiler.h"
 #include "KibakoEngine/Renderer/DebugDraw2D.h"
 
@@ -16,7 +17,7 @@
 #include <cmath>
 #include <cstdio>
 
-#if KBK_DEBUG_BUILD
+#if KBK_ENABLE_DEBUG_UI
 #    include "imgui.h"
 #endif
 
@@ -55,7 +56,7 @@ namespace
         return DirectX::XMFLOAT2{ v.x * scale, v.y * scale };
     }
 
-#if KBK_DEBUG_BUILD
+#if KBK_ENABLE_DEBUG_UI
     // Basic ImGui scene inspector
     void SceneInspectorPanel(void* userData)
     {
@@ -210,7 +211,7 @@ void GameLayer::OnAttach()
     m_lastUiHeight = screenH;
     BuildUI();
 
-#if KBK_DEBUG_BUILD
+#if KBK_ENABLE_DEBUG_UI
     DebugUI::SetSceneInspector(&m_scene, &SceneInspectorPanel);
 #endif
 }
@@ -249,7 +250,7 @@ void GameLayer::OnDetach()
     m_menuScreen = nullptr;
     m_menuBackdrop = nullptr;
 
-#if KBK_DEBUG_BUILD
+#if KBK_ENABLE_DEBUG_UI
     DebugUI::SetSceneInspector(nullptr, nullptr);
 #endif
 }
@@ -286,7 +287,7 @@ void GameLayer::OnRender(SpriteBatch2D& batch)
     if (!m_starTexture || !m_starTexture->IsValid())
         return;
 
-    m_scene.Render(batch);
+    m_scene.Render(batch, m_app.Renderer().Camera());
 
     if (m_showCollisionDebug)
         RenderCollisionDebug(batch);
@@ -317,6 +318,7 @@ void GameLayer::UpdateScene(float dt)
 
         hit = Intersects(*left->collision.circle, left->transform,
             *right->collision.circle, right->transform);
+        CountPairsTested(1);
     }
 
     // Collision feedback
@@ -338,6 +340,7 @@ void GameLayer::UpdateScene(float dt)
 
 void GameLayer::BuildUI()
 {
+    KBK_MEMORY_TAG(UI);
     m_titleLabel = nullptr;
     m_timeLabel = nullptr;
     m_stateLabel = nullptr;
@@ -473,6 +476,7 @@ void GameLayer::BuildUI()
 
 void GameLayer::UpdateUI(float dt)
 {
+    KBK_MEMORY_TAG(UI);
     (void)dt;
 
     // Resize-aware
@@ -0,0 +1,652 @@
+// Headless soak scenarios and their budgets
+#include "SoakRunner.h"
+
+#include "KibakoEngine/Core/Application.h"
+#include "KibakoEngine/Core/FrameStats.h"
+#include "KibakoEngine/Core/Layer.h"
+#include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/MemoryTracker.h"
+#include "KibakoEngine/Core/Profiler.h"
+#include "KibakoEngine/Scene/Scene2D.h"
+#include "KibakoEngine/UI/UIControls.h"
+#include "KibakoEngine/UI/UIElement.h"
+
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    include <windows.h>
+#    include <psapi.h>
+#else
+#    include <unistd.h>
+#endif
+
+using namespace KibakoEngine;
+
+namespace
+{
+    constexpr const char*   kLogChannel = "Soak";
+    constexpr int           kWidth = 960;
+    constexpr int           kHeight = 540;
+    constexpr std::uint32_t kSeed = 1337;
+    constexpr double        kMiB = 1024.0 * 1024.0;
+
+    constexpr std::size_t kSpriteCount = 100000;
+    constexpr float       kSpriteSize = 8.0f;
+    constexpr int         kUIPanelCount = 24;
+    constexpr int         kFontPixelHeight = 32;
+
+    // 0 leaves a limit unchecked. Times are p95 over the measured frames unless named max;
+    // memory growth runs from the end of warmup to the last frame.
+    struct SoakBudget
+    {
+        double updateP95Ms = 0.0;
+        double renderP95Ms = 0.0;
+        double frameP95Ms = 0.0;
+        double frameMaxMs = 0.0;
+        double peakResidentMiB = 0.0;
+        double residentGrowthMiB = 0.0;
+        double trackedGrowthMiB = 0.0;   // Debug builds, where MemoryTracker is on
+    };
+
+    struct SoakMemory
+    {
+        std::int64_t baselineResident = 0;
+        std::int64_t finalResident = 0;
+        std::int64_t peakResident = 0;
+        std::int64_t baselineTracked = 0;
+        std::int64_t finalTracked = 0;
+    };
+
+    // Whole process, so texture pixels and third-party allocations count too
+    std::int64_t ResidentBytes()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return 0;
+        return static_cast<std::int64_t>(counters.WorkingSetSize);
+#else
+        std::FILE* file = std::fopen("/proc/self/statm", "r");
+        if (!file)
+            return 0;
+        long long totalPages = 0;
+        long long residentPages = 0;
+        const int fields = std::fscanf(file, "%lld %lld", &totalPages, &residentPages);
+        std::fclose(file);
+        if (fields != 2)
+            return 0;
+        return static_cast<std::int64_t>(residentPages) * static_cast<std::int64_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    std::int64_t TrackedBytes()
+    {
+        std::int64_t total = 0;
+        if (MemoryTracker::IsEnabled()) {
+            for (std::size_t i = 0; i < kMemoryTagCount; ++i)
+                total += MemoryTracker::Stats(static_cast<MemoryTag>(i)).liveBytes;
+        }
+        return total;
+    }
+
+    class SoakLayer : public Layer
+    {
+    public:
+        SoakLayer(std::string name, Application& app)
+            : Layer(std::move(name))
+            , m_app(app)
+        {
+        }
+
+        [[nodiscard]] bool Failed() const { return m_failed; }
+
+    protected:
+        // Stops the run; the scenario reports as not run rather than over budget
+        void Fail(const std::string& reason)
+        {
+            KbkError(kLogChannel, "%s: %s", Name().c_str(), reason.c_str());
+            m_failed = true;
+            m_app.RequestQuit();
+        }
+
+        Application& m_app;
+
+    private:
+        bool m_failed = false;
+    };
+
+    // 100k textured sprites bouncing around the screen, all drawn every frame
+    class SpriteSoak final : public SoakLayer
+    {
+    public:
+        explicit SpriteSoak(Application& app)
+            : SoakLayer("Soak.Sprites", app)
+        {
+        }
+
+        void OnAttach() override
+        {
+            Texture2D* texture = m_app.Assets().LoadTexture("soak.star", "assets/star.png", true);
+            if (!texture || !texture->IsValid()) {
+                Fail("failed to load assets/star.png");
+                return;
+            }
+
+            // Entity creation traces every id; 100k of them would measure the log
+            const LogLevel previousLevel = GetLogChannelLevel("Scene2D");
+            SetLogChannelLevel("Scene2D", LogLevel::Warning);
+
+            std::mt19937 rng(kSeed);
+            std::uniform_real_distribution<float> x(0.0f, static_cast<float>(kWidth));
+            std::uniform_real_distribution<float> y(0.0f, static_cast<float>(kHeight));
+            std::uniform_real_distribution<float> speed(-120.0f, 120.0f);
+            std::uniform_int_distribution<int> layer(0, 7);
+
+            m_velocities.reserve(kSpriteCount);
+            for (std::size_t i = 0; i < kSpriteCount; ++i) {
+                Entity2D& entity = m_scene.CreateEntity();
+                entity.transform.position = { x(rng), y(rng) };
+                entity.sprite.texture = texture;
+                entity.sprite.dst = RectF::FromXYWH(0.0f, 0.0f, kSpriteSize, kSpriteSize);
+                entity.sprite.layer = layer(rng);
+                m_velocities.push_back({ speed(rng), speed(rng) });
+            }
+
+            SetLogChannelLevel("Scene2D", previousLevel);
+        }
+
+        void OnDetach() override
+        {
+            m_scene.Clear();
+            m_velocities.clear();
+        }
+
+        void OnUpdate(float dt) override
+        {
+            KBK_PROFILE_SCOPE("SoakSprites");
+
+            std::vector<Entity2D>& entities = m_scene.Entities();
+            const std::size_t count = std::min(entities.size(), m_velocities.size());
+            for (std::size_t i = 0; i < count; ++i) {
+                DirectX::XMFLOAT2& position = entities[i].transform.position;
+                DirectX::XMFLOAT2& velocity = m_velocities[i];
+                position.x += velocity.x * dt;
+                position.y += velocity.y * dt;
+                if (position.x < 0.0f || position.x > static_cast<float>(kWidth))
+                    velocity.x = -velocity.x;
+                if (position.y < 0.0f || position.y > static_cast<float>(kHeight))
+                    velocity.y = -velocity.y;
+            }
+            m_scene.Update(dt);
+        }
+
+        void OnRender(SpriteBatch2D& batch) override
+        {
+            m_scene.Render(batch);
+        }
+
+    private:
+        Scene2D                        m_scene;
+        std::vector<DirectX::XMFLOAT2> m_velocities;
+    };
+
+    // Tears down and rebuilds a HUD and a menu every frame, as screen changes do
+    class UIChurnSoak final : public SoakLayer
+    {
+    public:
+        explicit UIChurnSoak(Application& app)
+            : SoakLayer("Soak.UI", app)
+        {
+        }
+
+        void OnAttach() override
+        {
+            m_font = m_app.Assets().LoadFontTTF("soak.font", "assets/fonts/dogica.ttf", kFontPixelHeight);
+            if (!m_font) {
+                Fail("failed to load assets/fonts/dogica.ttf");
+                return;
+            }
+
+            m_ui.SetInput(&m_app.InputSys());
+            m_ui.SetScreenSize(static_cast<float>(m_app.Width()), static_cast<float>(m_app.Height()));
+            m_ui.Style().font = m_font;
+        }
+
+        void OnDetach() override
+        {
+            m_ui.Clear();
+            m_font = nullptr;
+        }
+
+        void OnUpdate(float dt) override
+        {
+            KBK_PROFILE_SCOPE("SoakUI");
+
+            if (!m_font)
+                return;
+
+            m_ui.Clear();
+            BuildScreens();
+            m_ui.Update(dt);
+            ++m_generation;
+        }
+
+        void OnRender(SpriteBatch2D& batch) override
+        {
+            m_ui.Render(batch);
+        }
+
+    private:
+        void BuildScreens()
+        {
+            const UIStyle& style = m_ui.Style();
+
+            UIScreen& hud = m_ui.CreateScreen("Soak.HUD");
+            UIStack& lines = hud.Root().EmplaceChild<UIStack>("Soak.HUD.Lines");
+            lines.SetPosition({ 16.0f, 16.0f });
+            lines.SetSpacing(4.0f);
+            for (int i = 0; i < kUIPanelCount; ++i) {
+                UILabel& label = lines.EmplaceChild<UILabel>("Soak.HUD.Line");
+                style.ApplyBody(label);
+                label.SetText("LINE " + std::to_string(i) + "  FRAME " + std::to_string(m_generation));
+            }
+
+            UIScreen& menu = m_ui.CreateScreen("Soak.Menu");
+            for (int i = 0; i < kUIPanelCount; ++i) {
+                UIPanel& panel = menu.Root().EmplaceChild<UIPanel>("Soak.Menu.Panel");
+                panel.SetPosition({ 40.0f * static_cast<float>(i % 6), 90.0f * static_cast<float>(i / 6) });
+                panel.SetSize({ 160.0f, 80.0f });
+                panel.SetColor(style.panelColor);
+
+                UIButton& button = panel.EmplaceChild<UIButton>("Soak.Menu.Button");
+                style.ApplyButton(button);
+                button.SetAnchor(UIAnchor::Center);
+                button.SetText("BUTTON " + std::to_string(i));
+            }
+        }
+
+        UISystem      m_ui;
+        const Font*   m_font = nullptr;
+        std::uint64_t m_generation = 0;
+    };
+
+    // Drops the asset cache and loads every texture and font under assets/ each frame
+    class AssetSoak final : public SoakLayer
+    {
+    public:
+        explicit AssetSoak(Application& app)
+            : SoakLayer("Soak.Assets", app)
+        {
+        }
+
+        void OnAttach() override
+        {
+            std::error_code error;
+            for (std::filesystem::recursive_directory_iterator it("assets", error), end; !error && it != end; it.increment(error)) {
+                if (!it->is_regular_file(error))
+                    continue;
+                std::string extension = it->path().extension().string();
+                std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) {
+                    return static_cast<char>(std::tolower(c));
+                });
+                if (extension == ".png" || extension == ".jpg" || extension == ".tga" || extension == ".bmp")
+                    m_textures.push_back(it->path().generic_string());
+                else if (extension == ".ttf")
+                    m_fonts.push_back(it->path().generic_string());
+            }
+
+            if (m_textures.empty() && m_fonts.empty()) {
+                Fail("no textures or fonts found under assets/");
+                return;
+            }
+
+            // Every load logs a line; thousands of them would bury the results
+            for (std::size_t i = 0; i < std::size(kQuietChannels); ++i) {
+                m_previousLevels[i] = GetLogChannelLevel(kQuietChannels[i]);
+                SetLogChannelLevel(kQuietChannels[i], LogLevel::Warning);
+            }
+            m_quieted = true;
+        }
+
+        void OnDetach() override
+        {
+            m_app.Assets().Clear();
+            if (m_quieted) {
+                for (std::size_t i = 0; i < std::size(kQuietChannels); ++i)
+                    SetLogChannelLevel(kQuietChannels[i], m_previousLevels[i]);
+                m_quieted = false;
+            }
+        }
+
+        void OnUpdate(float dt) override
+        {
+            KBK_UNUSED(dt);
+            KBK_PROFILE_SCOPE("SoakAssets");
+
+            if (Failed())
+                return;
+
+            AssetManager& assets = m_app.Assets();
+            assets.Clear();
+            for (const std::string& path : m_textures) {
+                if (!assets.LoadTexture(path, path, true)) {
+                    Fail("failed to load " + path);
+                    return;
+                }
+            }
+            for (const std::string& path : m_fonts) {
+                if (!assets.LoadFontTTF(path, path, kFontPixelHeight)) {
+                    Fail("failed to load " + path);
+                    return;
+                }
+            }
+        }
+
+    private:
+        static constexpr const char* kQuietChannels[] = { "Assets", "Texture", "Font" };
+
+        std::vector<std::string> m_textures;
+        std::vector<std::string> m_fonts;
+        LogLevel                 m_previousLevels[std::size(kQuietChannels)] = {};
+        bool                     m_quieted = false;
+    };
+
+    // Pushed after the scenario: samples memory once its update has run
+    class SoakMonitor final : public Layer
+    {
+    public:
+        SoakMonitor(Application& app, std::uint64_t warmupFrames)
+            : Layer("Soak.Monitor")
+            , m_app(app)
+            , m_warmupFrames(warmupFrames)
+        {
+        }
+
+        void OnAttach() override
+        {
+            if (m_warmupFrames == 0)
+                TakeBaseline();
+        }
+
+        void OnUpdate(float dt) override
+        {
+            KBK_UNUSED(dt);
+
+            const std::uint64_t frame = m_app.FrameCount();
+            if (frame == m_warmupFrames)
+                TakeBaseline();
+            if (frame < m_warmupFrames)
+                return;
+
+            m_memory.finalResident = ResidentBytes();
+            m_memory.finalTracked = TrackedBytes();
+            m_memory.peakResident = std::max(m_memory.peakResident, m_memory.finalResident);
+        }
+
+        [[nodiscard]] const SoakMemory& Memory() const { return m_memory; }
+
+    private:
+        void TakeBaseline()
+        {
+            m_memory.baselineResident = m_memory.finalResident = m_memory.peakResident = ResidentBytes();
+            m_memory.baselineTracked = m_memory.finalTracked = TrackedBytes();
+        }
+
+        Application&  m_app;
+        std::uint64_t m_warmupFrames;
+        SoakMemory    m_memory;
+    };
+
+    struct SoakScenario
+    {
+        const char* name;
+        const char* description;
+        std::unique_ptr<SoakLayer> (*create)(Application& app);
+        SoakBudget  budget;
+    };
+
+    template <typename T>
+    std::unique_ptr<SoakLayer> Create(Application& app)
+    {
+        return std::make_unique<T>(app);
+    }
+
+    // Release builds on a desktop CPU pass with headroom; --soak-budget-scale loosens
+    // the times for slower machines and debug builds
+    const SoakScenario kScenarios[] = {
+        { "sprites", "100k moving sprites", &Create<SpriteSoak>,
+          { 4.0, 40.0, 50.0, 120.0, 768.0, 8.0, 4.0 } },
+        { "ui", "HUD and menu rebuilt every frame", &Create<UIChurnSoak>,
+          { 4.0, 4.0, 10.0, 50.0, 256.0, 4.0, 1.0 } },
+        { "assets", "every asset reloaded every frame", &Create<AssetSoak>,
+          { 50.0, 1.0, 60.0, 200.0, 512.0, 16.0, 1.0 } },
+    };
+
+    const SoakScenario* FindScenario(const std::string& name)
+    {
+        for (const SoakScenario& scenario : kScenarios) {
+            if (name == scenario.name)
+                return &scenario;
+        }
+        return nullptr;
+    }
+
+    struct SoakResult
+    {
+        FrameStatsSummary        stats;
+        SoakMemory               memory;
+        std::vector<std::string> violations;
+    };
+
+    double ToMiB(std::int64_t bytes)
+    {
+        return static_cast<double>(bytes) / kMiB;
+    }
+
+    void CheckLimit(SoakResult& result, const char* what, double value, double limit, const char* unit)
+    {
+        if (limit <= 0.0 || value <= limit)
+            return;
+        char text[128];
+        std::snprintf(text, sizeof(text), "%s %.2f %s over the %.2f %s budget", what, value, unit, limit, unit);
+        result.violations.emplace_back(text);
+    }
+
+    void CheckBudget(const SoakBudget& budget, double timeScale, SoakResult& result)
+    {
+        const FrameStatsSummary& stats = result.stats;
+        const SoakMemory& memory = result.memory;
+        CheckLimit(result, "update p95", stats.phases[static_cast<std::size_t>(FramePhase::Update)].p95Ms, budget.updateP95Ms * timeScale, "ms");
+        CheckLimit(result, "render p95", stats.phases[static_cast<std::size_t>(FramePhase::Render)].p95Ms, budget.renderP95Ms * timeScale, "ms");
+        CheckLimit(result, "frame p95", stats.frame.p95Ms, budget.frameP95Ms * timeScale, "ms");
+        CheckLimit(result, "frame max", stats.frame.maxMs, budget.frameMaxMs * timeScale, "ms");
+        CheckLimit(result, "peak resident", ToMiB(memory.peakResident), budget.peakResidentMiB, "MiB");
+        CheckLimit(result, "resident growth", ToMiB(memory.finalResident - memory.baselineResident), budget.residentGrowthMiB, "MiB");
+        if (MemoryTracker::IsEnabled())
+            CheckLimit(result, "tracked heap growth", ToMiB(memory.finalTracked - memory.baselineTracked), budget.trackedGrowthMiB, "MiB");
+    }
+
+    bool RunScenario(const SoakScenario& scenario, const SoakOptions& options, SoakResult& result)
+    {
+        Application app;
+        if (!app.InitHeadless(kWidth, kHeight, HeadlessBackend::Null)) {
+            KbkError(kLogChannel, "%s: failed to initialize the application", scenario.name);
+            return false;
+        }
+
+        const std::uint64_t totalFrames = options.warmupFrames + options.frames;
+        app.SetFixedTimeStep(options.fixedStep);
+        app.SetFrameLimit(totalFrames);
+        // The frame limit closes the final frame, so the last `frames` samples are the measured ones
+        app.FrameStatsSys().SetWindowSize(static_cast<std::size_t>(options.frames));
+        // Only frames over the budget are worth a hitch warning
+        if (scenario.budget.frameMaxMs > 0.0)
+            app.FrameStatsSys().SetHitchThresholdMs(scenario.budget.frameMaxMs * options.budgetScale);
+
+        std::unique_ptr<SoakLayer> layer = scenario.create(app);
+        SoakMonitor monitor(app, options.warmupFrames);
+        app.PushLayer(layer.get());
+        app.PushLayer(&monitor);
+
+        const float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        if (!layer->Failed())
+            app.Run(clearColor, false);
+
+        const bool completed = !layer->Failed() && app.FrameCount() == totalFrames;
+        if (!layer->Failed() && !completed)
+            KbkError(kLogChannel, "%s: stopped after %llu of %llu frames", scenario.name,
+                static_cast<unsigned long long>(app.FrameCount()), static_cast<unsigned long long>(totalFrames));
+
+        result.stats = app.FrameStatsSys().Summary();
+        result.memory = monitor.Memory();
+        app.Shutdown();
+        return completed;
+    }
+
+    void WriteReport(std::FILE* file, const SoakScenario& scenario, const SoakResult& result, bool ran)
+    {
+        if (!file)
+            return;
+
+        const FrameStatsSummary& stats = result.stats;
+        const SoakMemory& memory = result.memory;
+        std::fprintf(file,
+            "{\"scenario\":\"%s\",\"ran\":%s,\"passed\":%s,\"frames\":%u,"
+            "\"frame_p95_ms\":%.3f,\"frame_max_ms\":%.3f,\"update_p95_ms\":%.3f,\"render_p95_ms\":%.3f,"
+            "\"peak_resident_mib\":%.2f,\"resident_growth_mib\":%.2f,\"tracked_growth_mib\":%.2f,\"violations\":%zu}\n",
+            scenario.name,
+            ran ? "true" : "false",
+            ran && result.violations.empty() ? "true" : "false",
+            stats.frames,
+            stats.frame.p95Ms,
+            stats.frame.maxMs,
+            stats.phases[static_cast<std::size_t>(FramePhase::Update)].p95Ms,
+            stats.phases[static_cast<std::size_t>(FramePhase::Render)].p95Ms,
+            ToMiB(memory.peakResident),
+            ToMiB(memory.finalResident - memory.baselineResident),
+            ToMiB(memory.finalTracked - memory.baselineTracked),
+            result.violations.size());
+        std::fflush(file);
+    }
+
+} // namespace
+
+bool ParseSoakScenarios(const std::string& list, std::vector<std::string>& out)
+{
+    out.clear();
+    if (list == "all")
+        return true;
+
+    std::size_t start = 0;
+    while (start <= list.size()) {
+        const std::size_t comma = std::min(list.find(',', start), list.size());
+        const std::string name = list.substr(start, comma - start);
+        if (!FindScenario(name)) {
+            KbkError(kLogChannel, "Unknown soak scenario '%s' (sprites, ui, assets or all)", name.c_str());
+            return false;
+        }
+        out.push_back(name);
+        start = comma + 1;
+    }
+    return true;
+}
+
+int RunSoak(const SoakOptions& options)
+{
+    std::vector<const SoakScenario*> selected;
+    if (options.scenarios.empty()) {
+        for (const SoakScenario& scenario : kScenarios)
+            selected.push_back(&scenario);
+    }
+    else {
+        for (const std::string& name : options.scenarios) {
+            const SoakScenario* scenario = FindScenario(name);
+            if (!scenario) {
+                KbkError(kLogChannel, "Unknown soak scenario '%s'", name.c_str());
+                return 2;
+            }
+            selected.push_back(scenario);
+        }
+    }
+
+    if (options.frames == 0 || options.fixedStep <= 0.0) {
+        KbkError(kLogChannel, "Soak runs need at least one frame and a positive time step");
+        return 2;
+    }
+
+    // Nobody is at the debugger overnight; an error still ends the scenario it happens in
+    const LogConfig previousConfig = GetLogConfig();
+    LogConfig soakConfig = previousConfig;
+    soakConfig.breakIntoDebugger = false;
+    soakConfig.haltRenderingOnBreak = true;
+    SetLogConfig(soakConfig);
+
+    std::FILE* report = nullptr;
+    if (!options.reportPath.empty()) {
+        report = std::fopen(options.reportPath.c_str(), "w");
+        if (!report)
+            KbkWarn(kLogChannel, "Cannot write the soak report to %s", options.reportPath.c_str());
+    }
+
+    int exitCode = 0;
+    for (const SoakScenario* scenario : selected) {
+        KbkLogFmt(kLogChannel, "{}: {}, {} frames after {} warmup, dt {:.4f} s",
+            scenario->name, scenario->description, options.frames, options.warmupFrames, options.fixedStep);
+
+        // Left over from the previous scenario's report
+        static_cast<void>(ConsumeBreakpointRequest());
+
+        SoakResult result;
+        const bool ran = RunScenario(*scenario, options, result);
+        if (!ran) {
+            exitCode = 2;
+            WriteReport(report, *scenario, result, false);
+            continue;
+        }
+
+        CheckBudget(scenario->budget, options.budgetScale, result);
+        WriteReport(report, *scenario, result, true);
+
+        const FrameStatsSummary& stats = result.stats;
+        KbkLogFmt(kLogChannel, "{}: frame p95 {:.2f} ms, max {:.2f} ms, update p95 {:.2f} ms, render p95 {:.2f} ms, peak {:.1f} MiB, growth {:.2f} MiB",
+            scenario->name,
+            stats.frame.p95Ms,
+            stats.frame.maxMs,
+            stats.phases[static_cast<std::size_t>(FramePhase::Update)].p95Ms,
+            stats.phases[static_cast<std::size_t>(FramePhase::Render)].p95Ms,
+            ToMiB(result.memory.peakResident),
+            ToMiB(result.memory.finalResident - result.memory.baselineResident));
+
+        if (result.violations.empty()) {
+            KbkLogFmt(kLogChannel, "{}: PASS", scenario->name);
+            continue;
+        }
+
+        for (const std::string& violation : result.violations)
+            KbkErrorFmt(kLogChannel, "{}: {}", scenario->name, violation);
+        KbkErrorFmt(kLogChannel, "{}: FAIL ({} budget violations)", scenario->name, result.violations.size());
+        exitCode = std::max(exitCode, 1);
+    }
+
+    if (report)
+        std::fclose(report);
+    static_cast<void>(ConsumeBreakpointRequest());
+    SetLogConfig(previousConfig);
+    return exitCode;
+}
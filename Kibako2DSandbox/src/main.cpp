@@ -12,26 +12,216 @@
 #endif
 
 #include "KibakoEngine/Core/Application.h"
+#include "KibakoEngine/Core/BinaryLog.h"
+#include "KibakoEngine/Core/CrashLog.h"
 #include "KibakoEngine/Core/Log.h"
+#include "KibakoEngine/Core/LogFileSink.h"
+#include "KibakoEngine/Core/PerfCounters.h"
+#include "KibakoEngine/Renderer/ImageRGBA8.h"
 #include "GameLayer.h"
+#include "SoakRunner.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
 
 using namespace KibakoEngine;
 
-int main()
+namespace
+{
+    // Frames rendered by --headless before exiting
+    constexpr std::uint64_t kHeadlessFrames = 600;
+
+    // "--log-level warn" sets the default, "--log-level Scene2D=trace" one channel
+    bool ApplyLogLevel(const std::string& spec)
+    {
+        const std::size_t separator = spec.find('=');
+        const std::string levelText = separator == std::string::npos ? spec : spec.substr(separator + 1);
+
+        LogLevel level = LogLevel::Trace;
+        if (!ParseLogLevel(levelText.c_str(), level)) {
+            KbkWarn("Sandbox", "Unknown log level '%s'", levelText.c_str());
+            return false;
+        }
+
+        if (separator == std::string::npos) {
+            LogConfig config = GetLogConfig();
+            config.minimumLevel = level;
+            SetLogConfig(config);
+        }
+        else {
+            SetLogChannelLevel(spec.substr(0, separator).c_str(), level);
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
 {
+    bool headless = false;
+    bool software = false;
+    bool threadedRender = false;
+    std::string screenshotPath;
+    std::string frameStatsPath;
+    std::string countersPath;
+    std::string recordPath;
+    std::string replayPath;
+    bool recordSprites = false;
+    double fixedStep = 0.0;
+    bool asyncLog = false;
+    std::string binaryLogPath;
+    std::string logDirectory;
+    std::string jsonLogDirectory;
+    std::string crashLogPath;
+    bool soak = false;
+    SoakOptions soakOptions;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0)
+            headless = true;
+        else if (std::strcmp(argv[i], "--software") == 0)
+            headless = software = true;
+        else if (std::strcmp(argv[i], "--screenshot") == 0 && i + 1 < argc)
+            screenshotPath = argv[++i];
+        else if (std::strcmp(argv[i], "--threaded-render") == 0)
+            threadedRender = true;
+        else if (std::strcmp(argv[i], "--frame-stats") == 0 && i + 1 < argc)
+            frameStatsPath = argv[++i];
+        else if (std::strcmp(argv[i], "--counters") == 0 && i + 1 < argc)
+            countersPath = argv[++i];
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+            recordPath = argv[++i];
+        else if (std::strcmp(argv[i], "--record-sprites") == 0)
+            recordSprites = true;
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+            replayPath = argv[++i];
+        else if (std::strcmp(argv[i], "--fixed-step") == 0 && i + 1 < argc)
+            fixedStep = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--async-log") == 0)
+            asyncLog = true;
+        else if (std::strcmp(argv[i], "--log-level") == 0 && i + 1 < argc)
+            ApplyLogLevel(argv[++i]);
+        else if (std::strcmp(argv[i], "--log-dir") == 0 && i + 1 < argc)
+            logDirectory = argv[++i];
+        else if (std::strcmp(argv[i], "--json-log-dir") == 0 && i + 1 < argc)
+            jsonLogDirectory = argv[++i];
+        else if (std::strcmp(argv[i], "--crash-log") == 0 && i + 1 < argc)
+            crashLogPath = argv[++i];
+        else if (std::strcmp(argv[i], "--soak") == 0 && i + 1 < argc) {
+            soak = true;
+            if (!ParseSoakScenarios(argv[++i], soakOptions.scenarios))
+                return 2;
+        }
+        else if (std::strcmp(argv[i], "--soak-frames") == 0 && i + 1 < argc)
+            soakOptions.frames = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--soak-warmup") == 0 && i + 1 < argc)
+            soakOptions.warmupFrames = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--soak-budget-scale") == 0 && i + 1 < argc)
+            soakOptions.budgetScale = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--soak-report") == 0 && i + 1 < argc)
+            soakOptions.reportPath = argv[++i];
+        else if (std::strcmp(argv[i], "--binary-log") == 0 && i + 1 < argc)
+            binaryLogPath = argv[++i];
+        else if (std::strcmp(argv[i], "--decode-log") == 0 && i + 2 < argc) {
+            const char* binaryPath = argv[++i];
+            const char* textPath = argv[++i];
+            return BinaryLog::Decode(binaryPath, textPath) ? 0 : 1;
+        }
+    }
+
+    // Outlives the application, so shutdown messages still reach the file
+    RotatingFileSink logFile;
+    if (!logDirectory.empty()) {
+        LogFileConfig fileConfig;
+        fileConfig.directory = logDirectory;
+        if (logFile.Open(fileConfig))
+            AddLogSink(&logFile);
+    }
+
+    // JSON is rendered on the async writer thread, off the frame
+    RotatingFileSink jsonLogFile;
+    if (!jsonLogDirectory.empty()) {
+        LogFileConfig jsonConfig;
+        jsonConfig.directory = jsonLogDirectory;
+        jsonConfig.format = LogFileFormat::JsonLines;
+        if (jsonLogFile.Open(jsonConfig))
+            AddLogSink(&jsonLogFile);
+        asyncLog = true;
+    }
+
+    // Trace messages stay in memory until a crash or breakpoint writes them out
+    if (!crashLogPath.empty()) {
+        CrashLogConfig crashConfig;
+        crashConfig.path = crashLogPath;
+        CrashLog::Enable(crashConfig);
+    }
+
+    if (asyncLog)
+        StartAsyncLogging();
+    if (!binaryLogPath.empty())
+        BinaryLog::Open(binaryLogPath.c_str());
+
+    // Scenarios boot their own headless applications and decide the exit code
+    if (soak) {
+        if (fixedStep > 0.0)
+            soakOptions.fixedStep = fixedStep;
+        const int soakResult = RunSoak(soakOptions);
+        BinaryLog::Close();
+        StopAsyncLogging();
+        return soakResult;
+    }
+
+    // The null backend keeps no pixels, so headless screenshots rasterize in software
+    if (headless && !software && !screenshotPath.empty()) {
+        KbkLog("Sandbox", "--screenshot renders headless frames with the software backend");
+        software = true;
+    }
+
     Application app;
-    if (!app.Init(960, 540, "KibakoEngine Sandbox")) {
+    const bool initialized = headless
+        ? app.InitHeadless(960, 540, software ? HeadlessBackend::Software : HeadlessBackend::Null)
+        : app.Init(960, 540, "KibakoEngine Sandbox");
+    if (!initialized) {
         KbkError("Sandbox", "Failed to initialize Application");
         return 1;
     }
 
+    app.SetThreadedRendering(threadedRender);
+
+    // A replay ends by itself; otherwise headless runs stop after a fixed frame count
+    if (headless && replayPath.empty()) {
+        app.SetFrameLimit(kHeadlessFrames);
+        app.FrameStatsSys().SetWindowSize(kHeadlessFrames);
+    }
+
+    if (!recordPath.empty())
+        app.StartRecording(recordPath, recordSprites);
+    if (!replayPath.empty() && !app.StartReplay(replayPath, fixedStep)) {
+        app.Shutdown();
+        return 1;
+    }
+
+    if (!countersPath.empty())
+        PerfCounters::OpenJsonLines(countersPath);
+
     GameLayer gameLayer(app);
     app.PushLayer(&gameLayer);
 
     const float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
     app.Run(clearColor, true);
 
+    // Last frame, for golden-image comparisons
+    if (!screenshotPath.empty()) {
+        ImageRGBA8 image;
+        if (!app.Renderer().CaptureImage(image) || !ImageIO::SaveTGA(screenshotPath, image))
+            KbkWarn("Sandbox", "No frame captured for %s", screenshotPath.c_str());
+    }
+
+    if (!frameStatsPath.empty())
+        app.FrameStatsSys().ExportCSV(frameStatsPath);
+
     app.Shutdown();
+    BinaryLog::Close();
+    StopAsyncLogging();
     return 0;
 }
 